@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : CompressBench.cpp
+  * @author         : xy
+  * @brief          : 压缩收益评估
+  * @attention      : 压缩在带宽 B 下值得开启的条件：
+  *                   raw/B > compressed/B + raw/压缩速度 + raw/解压速度
+  *                   即 B < (raw - compressed) / (raw/压缩速度 + raw/解压速度)，输出该临界带宽
+  * @date           : 2025/3/29
+  ******************************************************************************
+  */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include "utils/Compress.h"
+
+static std::string repetitiveData(size_t size) {
+	// 模拟重复度较高的 protobuf 列表：字段名与取值反复出现
+	std::mt19937 gen(1);
+	std::string data;
+	while (data.size() < size) {
+		data += "\x0a\x10user_name_" + std::to_string(gen() % 100) + "\x12\x08password\x18" + std::to_string(gen() % 10);
+	}
+	data.resize(size);
+	return data;
+}
+
+static std::string randomData(size_t size) {
+	std::mt19937 gen(2);
+	std::string data(size, '\0');
+	for (auto &c : data) {
+		c = static_cast<char>(gen());
+	}
+	return data;
+}
+
+template<typename F>
+static double measureSeconds(size_t bytes, F &&f) {
+	// 至少处理 256MB，减少计时误差
+	size_t rounds = std::max<size_t>(1, (256 << 20) / std::max<size_t>(bytes, 1));
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < rounds; i++) {
+		f();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / rounds;
+}
+
+static void bench(const char *name, const std::string &input) {
+	std::string compressed, output;
+	auto compress_s = measureSeconds(input.size(), [&] { Compress::compress(COMPRESS_LZ4, input, compressed); });
+	auto decompress_s = measureSeconds(input.size(), [&] { Compress::decompress(COMPRESS_LZ4, compressed, output); });
+	if (output != input) {
+		printf("%s: round trip mismatch\n", name);
+		return;
+	}
+
+	double mb = static_cast<double>(input.size()) / (1 << 20);
+	double saved = static_cast<double>(input.size()) - static_cast<double>(compressed.size());
+	// 节省的字节数 / 额外的 CPU 时间，单位 MB/s；低于该带宽时压缩更快
+	double break_even = saved > 0 ? saved / (1 << 20) / (compress_s + decompress_s) : 0;
+	printf("%-10s %9zu %9zu %7.3f %10.1f %10.1f %12.1f\n", name, input.size(), compressed.size(),
+		   static_cast<double>(compressed.size()) / input.size(), mb / compress_s, mb / decompress_s, break_even);
+}
+
+int main() {
+	printf("%-10s %9s %9s %7s %10s %10s %12s\n", "data", "raw", "lz4", "ratio", "comp MB/s", "decomp MB/s",
+		   "break-even MB/s");
+	for (size_t size : {1024, 4096, 16384, 65536, 262144, 1048576}) {
+		bench("repeat", repetitiveData(size));
+	}
+	for (size_t size : {4096, 262144}) {
+		bench("random", randomData(size));
+	}
+	printf("\n链路带宽低于 break-even 时开启压缩可以缩短传输时间\n");
+	return 0;
+}
@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file           : Crc32cBench.cpp
+  * @author         : xy
+  * @brief          : CRC32C 吞吐与帧校验的单次开销
+  * @attention      : None
+  * @date           : 2025/3/30
+  ******************************************************************************
+  */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include "utils/Crc32c.h"
+#include "utils/HvProtocol.h"
+
+static volatile uint32_t sink;
+
+template<typename F>
+static double measureNs(size_t bytes, F &&f) {
+	// 至少处理 512MB，减少计时误差
+	size_t rounds = std::max<size_t>(1000, (512 << 20) / std::max<size_t>(bytes, 1));
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < rounds; i++) {
+		f();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / rounds;
+}
+
+int main() {
+	std::mt19937 gen(3);
+	std::string data(1 << 20, '\0');
+	for (auto &c : data) {
+		c = static_cast<char>(gen());
+	}
+
+	printf("hardware crc32c: %s\n\n", Crc32c::hardwareAvailable() ? "yes" : "no");
+	printf("%9s %12s %12s %14s %14s\n", "size", "hw GB/s", "table GB/s", "frame ns", "frame+crc ns");
+	for (size_t size : {64, 512, 4096, 65536, 1048576}) {
+		auto hw_ns = measureNs(size, [&] { sink = Crc32c::value(data.data(), size); });
+		auto table_ns = measureNs(size, [&] { sink = Crc32c::extendPortable(0, data.data(), size); });
+
+		// 完整的封包 + 拆包，对比有无校验
+		auto body = data.substr(0, size);
+		FrameHead head, parsed;
+		std::string out;
+		auto frame_ns = measureNs(size, [&] {
+		  auto frame = HvProtocol::packFrame(head, body);
+		  sink = HvProtocol::unpackFrame(frame.data(), frame.size(), parsed, out);
+		});
+		FrameHead crc_head;
+		crc_head.flags = FRAME_FLAG_CRC32C;
+		auto crc_frame_ns = measureNs(size, [&] {
+		  auto frame = HvProtocol::packFrame(crc_head, body);
+		  sink = HvProtocol::unpackFrame(frame.data(), frame.size(), parsed, out);
+		});
+
+		printf("%9zu %12.2f %12.2f %14.1f %14.1f\n", size, size / hw_ns, size / table_ns, frame_ns, crc_frame_ns);
+	}
+	return 0;
+}
@@ -0,0 +1,216 @@
+/**
+  ******************************************************************************
+  * @file           : UringBench.cpp
+  * @author         : xy
+  * @brief          : io_uring 引擎与 epoll 逐事件读写（libhv 的处理方式）的吞吐与每请求系统调用数对比
+  * @attention      : 服务端均为单线程回显；客户端每个连接保持一个在途请求，连接数越多，
+  *                   一次 io_uring_enter 能合并的收发越多；单核环境下客户端与服务端共享 CPU，只看相对值
+  * @date           : 2025/4/2
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unordered_map>
+#include <unistd.h>
+#include <vector>
+#include "rpc/UringServer.h"
+
+constexpr size_t kBodySize = 56;    // 加上 8 字节帧头共 64 字节
+constexpr auto kDuration = std::chrono::seconds(1);
+
+static std::string makeFrame() {
+	std::string frame(8 + kBodySize, 'x');
+	uint32_t length = htonl(kBodySize);
+	memcpy(&frame[0], &length, sizeof(length));
+	return frame;
+}
+
+static int listenOn(int &port) {
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+	listen(fd, 1024);
+	socklen_t len = sizeof(addr);
+	getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len);
+	port = ntohs(addr.sin_port);
+	return fd;
+}
+
+/**
+ * @brief epoll 基线：每个可读事件 read 一次、write 一次
+ */
+class EpollEchoServer {
+ public:
+  explicit EpollEchoServer(int listen_fd) : listen_fd(listen_fd) {
+	  thread = std::thread([this]() { Loop(); });
+  }
+  ~EpollEchoServer() {
+	  stopping = true;
+	  thread.join();
+	  close(listen_fd);
+  }
+  uint64_t Syscalls() const { return syscalls.load(); }
+  uint64_t Requests() const { return requests.load(); }
+ private:
+  void Loop() {
+	  int epfd = epoll_create1(0);
+	  struct epoll_event ev = {EPOLLIN, {.fd = listen_fd}};
+	  epoll_ctl(epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+	  std::unordered_map<int, std::string> inputs;
+	  std::vector<epoll_event> events(256);
+	  std::vector<char> buf(64 * 1024);
+	  while (!stopping) {
+		  int n = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 10);
+		  syscalls++;
+		  for (int i = 0; i < n; i++) {
+			  int fd = events[i].data.fd;
+			  if (fd == listen_fd) {
+				  int conn = accept(listen_fd, nullptr, nullptr);
+				  int one = 1;
+				  setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+				  struct epoll_event conn_ev = {EPOLLIN, {.fd = conn}};
+				  epoll_ctl(epfd, EPOLL_CTL_ADD, conn, &conn_ev);
+				  syscalls += 3;
+				  continue;
+			  }
+			  auto size = read(fd, buf.data(), buf.size());
+			  syscalls++;
+			  if (size <= 0) {
+				  epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+				  close(fd);
+				  inputs.erase(fd);
+				  syscalls += 2;
+				  continue;
+			  }
+			  auto &input = inputs[fd];
+			  input.append(buf.data(), size);
+			  size_t offset = 0;
+			  std::string output;
+			  while (input.size() - offset >= 8) {
+				  uint32_t length;
+				  memcpy(&length, input.data() + offset, sizeof(length));
+				  auto total = 8 + ntohl(length);
+				  if (input.size() - offset < total) {
+					  break;
+				  }
+				  output.append(input, offset, total);
+				  offset += total;
+				  requests++;
+			  }
+			  input.erase(0, offset);
+			  if (!output.empty()) {
+				  auto ret = write(fd, output.data(), output.size());
+				  (void) ret;
+				  syscalls++;
+			  }
+		  }
+	  }
+	  for (auto &item : inputs) {
+		  close(item.first);
+	  }
+	  close(epfd);
+  }
+
+  int listen_fd;
+  std::thread thread;
+  std::atomic<bool> stopping = false;
+  std::atomic<uint64_t> syscalls = 0;
+  std::atomic<uint64_t> requests = 0;
+};
+
+/**
+ * @brief 每个连接保持一个在途请求，运行 kDuration 后返回完成的请求数
+ */
+static uint64_t runClients(int port, int conn_num) {
+	std::string frame = makeFrame();
+	int epfd = epoll_create1(0);
+	std::vector<int> fds;
+	std::unordered_map<int, size_t> received;
+	for (int i = 0; i < conn_num; i++) {
+		int fd = socket(AF_INET, SOCK_STREAM, 0);
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(static_cast<uint16_t>(port));
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+		int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		struct epoll_event ev = {EPOLLIN, {.fd = fd}};
+		epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+		fds.push_back(fd);
+		received[fd] = 0;
+		auto ret = write(fd, frame.data(), frame.size());
+		(void) ret;
+	}
+
+	uint64_t done = 0;
+	std::vector<epoll_event> events(256);
+	std::vector<char> buf(64 * 1024);
+	auto deadline = std::chrono::steady_clock::now() + kDuration;
+	while (std::chrono::steady_clock::now() < deadline) {
+		int n = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 10);
+		for (int i = 0; i < n; i++) {
+			int fd = events[i].data.fd;
+			auto size = read(fd, buf.data(), buf.size());
+			if (size <= 0) {
+				continue;
+			}
+			auto &bytes = received[fd];
+			bytes += size;
+			while (bytes >= frame.size()) {
+				bytes -= frame.size();
+				done++;
+				auto ret = write(fd, frame.data(), frame.size());
+				(void) ret;
+			}
+		}
+	}
+	for (int fd : fds) {
+		close(fd);
+	}
+	close(epfd);
+	return done;
+}
+
+int main() {
+	printf("%-8s %-10s %12s %16s\n", "conns", "engine", "qps", "syscalls/req");
+	for (int conn_num : {1, 16, 64, 256}) {
+		{
+			int port;
+			int listen_fd = listenOn(port);
+			EpollEchoServer server(listen_fd);
+			auto done = runClients(port, conn_num);
+			printf("%-8d %-10s %12.0f %16.2f\n", conn_num, "epoll", done / 1.0,
+				   static_cast<double>(server.Syscalls()) / std::max<uint64_t>(server.Requests(), 1));
+		}
+		{
+			UringServer server;
+			auto echo = [](const RpcSessionPtr &session, const char *data, size_t size) {
+				session->Write(std::string(data, size));
+			};
+			if (!server.Start("127.0.0.1", 0, 1, echo)) {
+				printf("io_uring not available\n");
+				return 1;
+			}
+			auto done = runClients(server.Port(), conn_num);
+			auto stats = server.Stats();
+			printf("%-8d %-10s %12.0f %16.2f\n", conn_num, "io_uring", done / 1.0,
+				   static_cast<double>(stats.enter_calls + stats.other_syscalls) / std::max<uint64_t>(stats.requests, 1));
+		}
+	}
+	return 0;
+}
@@ -1,11 +1,11 @@
 #include <string>
-#include "user.pb.h"
+#include "user.tinyrpc.h"
 #include "utils/Log.h"
 #include "rpc/RpcProvider.h"
 
 // 服务端，提供服务，将远程调用服务注册，给客户端发现调用
 
-class UserService : public test::UserServiceRpc {
+class UserService : public test::UserServiceRpcHandler {
  public:
 
   // 本地服务，在没有考虑分布式之前，单体架构下的本地服务调用
@@ -16,7 +16,7 @@ class UserService : public test::UserServiceRpc {
   }
 
   // Rpc 服务，但还需要注册
-  void Login(::google::protobuf::RpcController *controller,
+  void Login(RpcController *controller,
 			 const ::test::LoginRequest *request,
 			 ::test::LoginResponse *response,
 			 ::google::protobuf::Closure *done) override {
@@ -36,6 +36,17 @@ class UserService : public test::UserServiceRpc {
 	  }
 	  done->Run();
   }
+
+  // 只读方法，proto 中标记了 (tinyrpc.coalesce)：同一时刻查询同一用户的请求只执行一次
+  void GetProfile(RpcController *controller,
+				  const ::test::ProfileRequest *request,
+				  ::test::ProfileResponse *response,
+				  ::google::protobuf::Closure *done) override {
+	  response->mutable_result()->set_errcode(0);
+	  response->set_name(request->name());
+	  response->set_signature("hello from " + request->name());
+	  done->Run();
+  }
 };
 
 int main() {
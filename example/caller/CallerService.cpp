@@ -1,14 +1,18 @@
 #include <string>
 #include <thread>
 #include <iostream>
-#include "user.pb.h"
+#include "user.tinyrpc.h"
 #include "rpc/RpcController.h"
 #include "rpc/RpcChannel.h"
+#include "rpc/Endpoint.h"
 
 int main() {
 
+	// 启动时预先连接服务的全部节点，首次调用不再等待连接建立
+	EndpointManager::getInstance()->Prewarm("UserServiceRpc");
+
 	auto channel = new RpcChannel();
-	test::UserServiceRpc_Stub rpc_stub(channel);
+	test::UserServiceRpcClient rpc_stub(channel);
 
 	test::LoginRequest login_request;
 	login_request.set_name("xy");
@@ -19,11 +23,11 @@ int main() {
 	std::cout << "rpc login request" << std::endl;
 
 	RpcController rpc_controller;
-	rpc_stub.Login(&rpc_controller, &login_request, &login_response, nullptr);
+	auto ok = rpc_stub.Login(login_request, &login_response, &rpc_controller);
 
 	std::cout << "rpc login response" << std::endl;
 
-	if (!rpc_controller.Failed()) {
+	if (ok) {
 		if (!login_response.success()) {
 			std::cout << "rpc login failed" << std::endl;
 			std::cout << "errcode = " << login_response.result().errcode() << std::endl;
@@ -36,5 +40,7 @@ int main() {
 		std::cout << rpc_controller.ErrorText() << std::endl;
 	}
 
+	std::cout << EndpointManager::getInstance()->Dump();
+
 	return 0;
 }
\ No newline at end of file
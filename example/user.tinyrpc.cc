@@ -0,0 +1,91 @@
+// Generated by protoc-gen-tinyrpc. DO NOT EDIT!
+// source: user.proto
+
+#include <google/protobuf/descriptor.h>
+#include "user.tinyrpc.h"
+
+namespace test {
+
+namespace {
+
+const ::google::protobuf::ServiceDescriptor *UserServiceRpcDescriptor() {
+  static const auto *descriptor =
+      ::google::protobuf::DescriptorPool::generated_pool()->FindServiceByName("test.UserServiceRpc");
+  return descriptor;
+}
+
+void InvokeUserServiceRpcLogin(::RpcSkeleton *service, ::RpcController *controller,
+    const ::google::protobuf::Message *request, ::google::protobuf::Message *response,
+    ::google::protobuf::Closure *done) {
+  static_cast<UserServiceRpcHandler *>(service)->Login(controller,
+      static_cast<const ::test::LoginRequest *>(request), static_cast<::test::LoginResponse *>(response), done);
+}
+
+void InvokeUserServiceRpcGetProfile(::RpcSkeleton *service, ::RpcController *controller,
+    const ::google::protobuf::Message *request, ::google::protobuf::Message *response,
+    ::google::protobuf::Closure *done) {
+  static_cast<UserServiceRpcHandler *>(service)->GetProfile(controller,
+      static_cast<const ::test::ProfileRequest *>(request), static_cast<::test::ProfileResponse *>(response), done);
+}
+
+constexpr ::RpcMethodEntry kUserServiceRpcMethods[] = {
+  {"Login",
+   []() -> ::google::protobuf::Message * { return new ::test::LoginRequest(); },
+   []() -> ::google::protobuf::Message * { return new ::test::LoginResponse(); },
+   &InvokeUserServiceRpcLogin},
+  {"GetProfile",
+   []() -> ::google::protobuf::Message * { return new ::test::ProfileRequest(); },
+   []() -> ::google::protobuf::Message * { return new ::test::ProfileResponse(); },
+   &InvokeUserServiceRpcGetProfile},
+};
+constexpr ::RpcServiceTable kUserServiceRpcTable = {"test.UserServiceRpc", kUserServiceRpcMethods, 2};
+
+}  // namespace
+
+bool UserServiceRpcClient::Login(const ::test::LoginRequest &request, ::test::LoginResponse *response,
+    ::RpcController *controller) {
+  ::RpcController local;
+  if (controller == nullptr) {
+    controller = &local;
+  }
+  channel->CallMethod(UserServiceRpcDescriptor()->method(0), controller, &request, response, nullptr);
+  return !controller->Failed();
+}
+
+void UserServiceRpcClient::Login(::google::protobuf::RpcController *controller, const ::test::LoginRequest *request,
+    ::test::LoginResponse *response, ::google::protobuf::Closure *done) {
+  channel->CallMethod(UserServiceRpcDescriptor()->method(0), controller, request, response, done);
+}
+
+void UserServiceRpcHandler::Login(::RpcController *controller, const ::test::LoginRequest *,
+    ::test::LoginResponse *, ::google::protobuf::Closure *done) {
+  controller->SetFailed("Method Login() not implemented.");
+  done->Run();
+}
+
+bool UserServiceRpcClient::GetProfile(const ::test::ProfileRequest &request, ::test::ProfileResponse *response,
+    ::RpcController *controller) {
+  ::RpcController local;
+  if (controller == nullptr) {
+    controller = &local;
+  }
+  channel->CallMethod(UserServiceRpcDescriptor()->method(1), controller, &request, response, nullptr);
+  return !controller->Failed();
+}
+
+void UserServiceRpcClient::GetProfile(::google::protobuf::RpcController *controller, const ::test::ProfileRequest *request,
+    ::test::ProfileResponse *response, ::google::protobuf::Closure *done) {
+  channel->CallMethod(UserServiceRpcDescriptor()->method(1), controller, request, response, done);
+}
+
+void UserServiceRpcHandler::GetProfile(::RpcController *controller, const ::test::ProfileRequest *,
+    ::test::ProfileResponse *, ::google::protobuf::Closure *done) {
+  controller->SetFailed("Method GetProfile() not implemented.");
+  done->Run();
+}
+
+const ::RpcServiceTable &UserServiceRpcHandler::DispatchTable() const {
+  return kUserServiceRpcTable;
+}
+
+}  // namespace test
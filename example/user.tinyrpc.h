@@ -0,0 +1,68 @@
+// Generated by protoc-gen-tinyrpc. DO NOT EDIT!
+// source: user.proto
+
+#ifndef TINYRPC_GENERATED_USER_TINYRPC_H_
+#define TINYRPC_GENERATED_USER_TINYRPC_H_
+
+#include <google/protobuf/service.h>
+#include "user.pb.h"
+#include "rpc/RpcController.h"
+#include "rpc/RpcSkeleton.h"
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+#include "rpc/RpcCoroutine.h"
+#endif
+
+namespace test {
+
+// 客户端：同步、回调与协程三种调用方式
+class UserServiceRpcClient {
+ public:
+  explicit UserServiceRpcClient(::google::protobuf::RpcChannel *channel) : channel(channel) {}
+
+  // 同步调用，失败时返回 false，controller 非空时写入错误信息；
+  // 不能在客户端 IO 线程（异步调用的 done 中）调用，否则直接失败
+  bool Login(const ::test::LoginRequest &request, ::test::LoginResponse *response,
+      ::RpcController *controller = nullptr);
+  // 异步调用，完成后在客户端 IO 线程中执行 done
+  void Login(::google::protobuf::RpcController *controller, const ::test::LoginRequest *request,
+      ::test::LoginResponse *response, ::google::protobuf::Closure *done);
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+  // 协程调用：auto result = co_await client.CoLogin(request); request 须存活到调用结束
+  CallAwaiter<UserServiceRpcClient, ::test::LoginRequest, ::test::LoginResponse> CoLogin(
+      const ::test::LoginRequest &request, int timeout_ms = 0) {
+    return {*this, &UserServiceRpcClient::Login, request, timeout_ms};
+  }
+#endif
+
+  // 同步调用，失败时返回 false，controller 非空时写入错误信息；
+  // 不能在客户端 IO 线程（异步调用的 done 中）调用，否则直接失败
+  bool GetProfile(const ::test::ProfileRequest &request, ::test::ProfileResponse *response,
+      ::RpcController *controller = nullptr);
+  // 异步调用，完成后在客户端 IO 线程中执行 done
+  void GetProfile(::google::protobuf::RpcController *controller, const ::test::ProfileRequest *request,
+      ::test::ProfileResponse *response, ::google::protobuf::Closure *done);
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+  // 协程调用：auto result = co_await client.CoGetProfile(request); request 须存活到调用结束
+  CallAwaiter<UserServiceRpcClient, ::test::ProfileRequest, ::test::ProfileResponse> CoGetProfile(
+      const ::test::ProfileRequest &request, int timeout_ms = 0) {
+    return {*this, &UserServiceRpcClient::GetProfile, request, timeout_ms};
+  }
+#endif
+
+ private:
+  ::google::protobuf::RpcChannel *channel;
+};
+
+// 服务端骨架：重写各方法后以 RpcProvider::NotifyService 注册，未重写的方法返回错误
+class UserServiceRpcHandler : public ::RpcSkeleton {
+ public:
+  virtual void Login(::RpcController *controller, const ::test::LoginRequest *request,
+      ::test::LoginResponse *response, ::google::protobuf::Closure *done);
+  virtual void GetProfile(::RpcController *controller, const ::test::ProfileRequest *request,
+      ::test::ProfileResponse *response, ::google::protobuf::Closure *done);
+  const ::RpcServiceTable &DispatchTable() const override;
+};
+
+}  // namespace test
+
+#endif  // TINYRPC_GENERATED_USER_TINYRPC_H_
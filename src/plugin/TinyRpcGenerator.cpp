@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file           : TinyRpcGenerator.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/7
+  ******************************************************************************
+  */
+
+#include <cctype>
+#include <map>
+#include <memory>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/io/printer.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+#include "TinyRpcGenerator.h"
+
+using google::protobuf::Descriptor;
+using google::protobuf::FileDescriptor;
+using google::protobuf::MethodDescriptor;
+using google::protobuf::ServiceDescriptor;
+using google::protobuf::io::Printer;
+using Vars = std::map<std::string, std::string>;
+
+namespace {
+
+std::string stripProto(const std::string &filename) {
+	for (const char *suffix : {".protodevel", ".proto"}) {
+		std::string ext(suffix);
+		if (filename.size() > ext.size() && filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0) {
+			return filename.substr(0, filename.size() - ext.size());
+		}
+	}
+	return filename;
+}
+
+std::string replaceAll(std::string text, const std::string &from, const std::string &to) {
+	for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+		text.replace(pos, from.size(), to);
+	}
+	return text;
+}
+
+// "a.b" -> "::a::b"
+std::string namespaceOf(const std::string &package) {
+	return package.empty() ? "" : "::" + replaceAll(package, ".", "::");
+}
+
+// 与 protoc 的 C++ 命名一致：嵌套消息 Outer.Inner 为 Outer_Inner
+std::string className(const Descriptor *message) {
+	const auto &package = message->file()->package();
+	std::string name = message->full_name();
+	if (!package.empty()) {
+		name = name.substr(package.size() + 1);
+	}
+	return namespaceOf(package) + "::" + replaceAll(name, ".", "_");
+}
+
+std::string headerGuard(const std::string &filename) {
+	std::string guard = "TINYRPC_GENERATED_";
+	for (char c : filename) {
+		guard += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(c)) : '_';
+	}
+	return guard + "_";
+}
+
+Vars methodVars(const MethodDescriptor *method) {
+	return {
+		{"service", method->service()->name()},
+		{"method", method->name()},
+		{"index", std::to_string(method->index())},
+		{"request", className(method->input_type())},
+		{"response", className(method->output_type())},
+	};
+}
+
+void openNamespace(Printer &printer, const std::string &package) {
+	if (package.empty()) {
+		return;
+	}
+	printer.Print("namespace $ns$ {\n\n", "ns", replaceAll(package, ".", "::"));
+}
+
+void closeNamespace(Printer &printer, const std::string &package) {
+	if (package.empty()) {
+		return;
+	}
+	printer.Print("}  // namespace $ns$\n", "ns", replaceAll(package, ".", "::"));
+}
+
+void generateHeader(const FileDescriptor *file, Printer &printer) {
+	auto base = stripProto(file->name());
+	printer.Print("// Generated by protoc-gen-tinyrpc. DO NOT EDIT!\n"
+				  "// source: $source$\n\n"
+				  "#ifndef $guard$\n"
+				  "#define $guard$\n\n"
+				  "#include <google/protobuf/service.h>\n"
+				  "#include \"$base$.pb.h\"\n"
+				  "#include \"rpc/RpcController.h\"\n"
+				  "#include \"rpc/RpcSkeleton.h\"\n"
+				  "#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)\n"
+				  "#include \"rpc/RpcCoroutine.h\"\n"
+				  "#endif\n\n",
+				  "source", file->name(), "guard", headerGuard(base + ".tinyrpc.h"), "base", base);
+	openNamespace(printer, file->package());
+
+	for (int i = 0; i < file->service_count(); i++) {
+		auto service = file->service(i);
+		printer.Print("// 客户端：同步、回调与协程三种调用方式\n"
+					  "class $service$Client {\n"
+					  " public:\n"
+					  "  explicit $service$Client(::google::protobuf::RpcChannel *channel) : channel(channel) {}\n",
+					  "service", service->name());
+		for (int j = 0; j < service->method_count(); j++) {
+			auto vars = methodVars(service->method(j));
+			printer.Print(vars,
+						  "\n"
+						  "  // 同步调用，失败时返回 false，controller 非空时写入错误信息；\n"
+						  "  // 不能在客户端 IO 线程（异步调用的 done 中）调用，否则直接失败\n"
+						  "  bool $method$(const $request$ &request, $response$ *response,\n"
+						  "      ::RpcController *controller = nullptr);\n"
+						  "  // 异步调用，完成后在客户端 IO 线程中执行 done\n"
+						  "  void $method$(::google::protobuf::RpcController *controller, const $request$ *request,\n"
+						  "      $response$ *response, ::google::protobuf::Closure *done);\n"
+						  "#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)\n"
+						  "  // 协程调用：auto result = co_await client.Co$method$(request); request 须存活到调用结束\n"
+						  "  CallAwaiter<$service$Client, $request$, $response$> Co$method$(\n"
+						  "      const $request$ &request, int timeout_ms = 0) {\n"
+						  "    return {*this, &$service$Client::$method$, request, timeout_ms};\n"
+						  "  }\n"
+						  "#endif\n");
+		}
+		printer.Print("\n"
+					  " private:\n"
+					  "  ::google::protobuf::RpcChannel *channel;\n"
+					  "};\n\n");
+
+		printer.Print("// 服务端骨架：重写各方法后以 RpcProvider::NotifyService 注册，未重写的方法返回错误\n"
+					  "class $service$Handler : public ::RpcSkeleton {\n"
+					  " public:\n",
+					  "service", service->name());
+		for (int j = 0; j < service->method_count(); j++) {
+			printer.Print(methodVars(service->method(j)),
+						  "  virtual void $method$(::RpcController *controller, const $request$ *request,\n"
+						  "      $response$ *response, ::google::protobuf::Closure *done);\n");
+		}
+		printer.Print("  const ::RpcServiceTable &DispatchTable() const override;\n"
+					  "};\n\n");
+	}
+
+	closeNamespace(printer, file->package());
+	printer.Print("\n#endif  // $guard$\n", "guard", headerGuard(base + ".tinyrpc.h"));
+}
+
+void generateSource(const FileDescriptor *file, Printer &printer) {
+	auto base = stripProto(file->name());
+	printer.Print("// Generated by protoc-gen-tinyrpc. DO NOT EDIT!\n"
+				  "// source: $source$\n\n"
+				  "#include <google/protobuf/descriptor.h>\n"
+				  "#include \"$base$.tinyrpc.h\"\n\n",
+				  "source", file->name(), "base", base);
+	openNamespace(printer, file->package());
+
+	// 分发表与描述信息放在匿名命名空间中，分发表为编译期常量
+	printer.Print("namespace {\n\n");
+	for (int i = 0; i < file->service_count(); i++) {
+		auto service = file->service(i);
+		Vars vars{{"service", service->name()}, {"full_name", service->full_name()},
+				  {"count", std::to_string(service->method_count())}};
+		printer.Print(vars,
+					  "const ::google::protobuf::ServiceDescriptor *$service$Descriptor() {\n"
+					  "  static const auto *descriptor =\n"
+					  "      ::google::protobuf::DescriptorPool::generated_pool()->FindServiceByName(\"$full_name$\");\n"
+					  "  return descriptor;\n"
+					  "}\n\n");
+		for (int j = 0; j < service->method_count(); j++) {
+			printer.Print(methodVars(service->method(j)),
+						  "void Invoke$service$$method$(::RpcSkeleton *service, ::RpcController *controller,\n"
+						  "    const ::google::protobuf::Message *request, ::google::protobuf::Message *response,\n"
+						  "    ::google::protobuf::Closure *done) {\n"
+						  "  static_cast<$service$Handler *>(service)->$method$(controller,\n"
+						  "      static_cast<const $request$ *>(request), static_cast<$response$ *>(response), done);\n"
+						  "}\n\n");
+		}
+		if (service->method_count() == 0) {
+			printer.Print(vars, "constexpr ::RpcServiceTable k$service$Table = {\"$full_name$\", nullptr, 0};\n\n");
+			continue;
+		}
+		printer.Print(vars, "constexpr ::RpcMethodEntry k$service$Methods[] = {\n");
+		for (int j = 0; j < service->method_count(); j++) {
+			printer.Print(methodVars(service->method(j)),
+						  "  {\"$method$\",\n"
+						  "   []() -> ::google::protobuf::Message * { return new $request$(); },\n"
+						  "   []() -> ::google::protobuf::Message * { return new $response$(); },\n"
+						  "   &Invoke$service$$method$},\n");
+		}
+		printer.Print(vars,
+					  "};\n"
+					  "constexpr ::RpcServiceTable k$service$Table = {\"$full_name$\", k$service$Methods, $count$};\n\n");
+	}
+	printer.Print("}  // namespace\n\n");
+
+	for (int i = 0; i < file->service_count(); i++) {
+		auto service = file->service(i);
+		for (int j = 0; j < service->method_count(); j++) {
+			printer.Print(methodVars(service->method(j)),
+						  "bool $service$Client::$method$(const $request$ &request, $response$ *response,\n"
+						  "    ::RpcController *controller) {\n"
+						  "  ::RpcController local;\n"
+						  "  if (controller == nullptr) {\n"
+						  "    controller = &local;\n"
+						  "  }\n"
+						  "  channel->CallMethod($service$Descriptor()->method($index$), controller, &request, response, nullptr);\n"
+						  "  return !controller->Failed();\n"
+						  "}\n\n"
+						  "void $service$Client::$method$(::google::protobuf::RpcController *controller, const $request$ *request,\n"
+						  "    $response$ *response, ::google::protobuf::Closure *done) {\n"
+						  "  channel->CallMethod($service$Descriptor()->method($index$), controller, request, response, done);\n"
+						  "}\n\n"
+						  "void $service$Handler::$method$(::RpcController *controller, const $request$ *,\n"
+						  "    $response$ *, ::google::protobuf::Closure *done) {\n"
+						  "  controller->SetFailed(\"Method $method$() not implemented.\");\n"
+						  "  done->Run();\n"
+						  "}\n\n");
+		}
+		printer.Print("const ::RpcServiceTable &$service$Handler::DispatchTable() const {\n"
+					  "  return k$service$Table;\n"
+					  "}\n\n",
+					  "service", service->name());
+	}
+
+	closeNamespace(printer, file->package());
+}
+
+}  // namespace
+
+bool TinyRpcGenerator::Generate(const FileDescriptor *file, const std::string &,
+								google::protobuf::compiler::GeneratorContext *context, std::string *error) const {
+	if (file->service_count() == 0) {
+		return true;
+	}
+	// 流式方法由 RpcProvider::NotifyStream 注册在普通方法上，不使用 proto 的 stream 关键字
+	for (int i = 0; i < file->service_count(); i++) {
+		auto service = file->service(i);
+		for (int j = 0; j < service->method_count(); j++) {
+			auto method = service->method(j);
+			if (method->client_streaming() || method->server_streaming()) {
+				*error = method->full_name() + ": stream methods are not supported, register them with NotifyStream";
+				return false;
+			}
+		}
+	}
+
+	auto base = stripProto(file->name());
+	{
+		std::unique_ptr<google::protobuf::io::ZeroCopyOutputStream> output(context->Open(base + ".tinyrpc.h"));
+		Printer printer(output.get(), '$');
+		generateHeader(file, printer);
+	}
+	{
+		std::unique_ptr<google::protobuf::io::ZeroCopyOutputStream> output(context->Open(base + ".tinyrpc.cc"));
+		Printer printer(output.get(), '$');
+		generateSource(file, printer);
+	}
+	return true;
+}
@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file           : TinyRpcGenerator.h
+  * @author         : xy
+  * @brief          : protoc 插件，为 .proto 中的服务生成类型化的客户端与服务端骨架
+  * @attention      : 输出 <name>.tinyrpc.h / <name>.tinyrpc.cc，与 protoc 生成的 <name>.pb.h 放在一起；
+  *                   客户端 <服务名>Client 提供同步、回调与协程（C++20）三种调用，
+  *                   服务端 <服务名>Handler 继承 RpcSkeleton，编译期构建分发表，注册时使用 RpcProvider::NotifyService；
+  *                   不依赖 cc_generic_services
+  * @date           : 2025/4/7
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_PLUGIN_TINYRPCGENERATOR_H_
+#define TINYRPC_SRC_PLUGIN_TINYRPCGENERATOR_H_
+
+#include <string>
+#include <google/protobuf/compiler/code_generator.h>
+
+class TinyRpcGenerator : public google::protobuf::compiler::CodeGenerator {
+ public:
+  bool Generate(const google::protobuf::FileDescriptor *file, const std::string &parameter,
+				google::protobuf::compiler::GeneratorContext *context, std::string *error) const override;
+};
+
+#endif //TINYRPC_SRC_PLUGIN_TINYRPCGENERATOR_H_
@@ -0,0 +1,17 @@
+/**
+  ******************************************************************************
+  * @file           : main.cpp
+  * @author         : xy
+  * @brief          : protoc-gen-tinyrpc 入口
+  * @attention      : protoc --plugin=protoc-gen-tinyrpc=bin/protoc-gen-tinyrpc --cpp_out=. --tinyrpc_out=. user.proto
+  * @date           : 2025/4/7
+  ******************************************************************************
+  */
+
+#include <google/protobuf/compiler/plugin.h>
+#include "TinyRpcGenerator.h"
+
+int main(int argc, char *argv[]) {
+	TinyRpcGenerator generator;
+	return google::protobuf::compiler::PluginMain(argc, argv, &generator);
+}
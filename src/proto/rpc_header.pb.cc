@@ -25,7 +25,12 @@ PROTOBUF_CONSTEXPR RpcHeader::RpcHeader(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.service_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.method_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.call_id_)*/uint64_t{0u}
+  , /*decltype(_impl_.trace_id_)*/uint64_t{0u}
   , /*decltype(_impl_.args_len_)*/0u
+  , /*decltype(_impl_.trace_flags_)*/0u
+  , /*decltype(_impl_.span_id_)*/uint64_t{0u}
+  , /*decltype(_impl_.attachment_size_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct RpcHeaderDefaultTypeInternal {
   PROTOBUF_CONSTEXPR RpcHeaderDefaultTypeInternal()
@@ -36,8 +41,24 @@ struct RpcHeaderDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RpcHeaderDefaultTypeInternal _RpcHeader_default_instance_;
+PROTOBUF_CONSTEXPR RpcResponseHeader::RpcResponseHeader(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.error_text_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.call_id_)*/uint64_t{0u}
+  , /*decltype(_impl_.error_code_)*/0
+  , /*decltype(_impl_.attachment_size_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct RpcResponseHeaderDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RpcResponseHeaderDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RpcResponseHeaderDefaultTypeInternal() {}
+  union {
+    RpcResponseHeader _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RpcResponseHeaderDefaultTypeInternal _RpcResponseHeader_default_instance_;
 }  // namespace tinyrpc
-static ::_pb::Metadata file_level_metadata_rpc_5fheader_2eproto[1];
+static ::_pb::Metadata file_level_metadata_rpc_5fheader_2eproto[2];
 static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_rpc_5fheader_2eproto = nullptr;
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_rpc_5fheader_2eproto = nullptr;
 
@@ -51,25 +72,47 @@ const uint32_t TableStruct_rpc_5fheader_2eproto::offsets[] PROTOBUF_SECTION_VARI
   PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.service_name_),
   PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.method_name_),
   PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.args_len_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.call_id_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.trace_id_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.span_id_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.trace_flags_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcHeader, _impl_.attachment_size_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcResponseHeader, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcResponseHeader, _impl_.call_id_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcResponseHeader, _impl_.error_code_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcResponseHeader, _impl_.error_text_),
+  PROTOBUF_FIELD_OFFSET(::tinyrpc::RpcResponseHeader, _impl_.attachment_size_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::tinyrpc::RpcHeader)},
+  { 14, -1, -1, sizeof(::tinyrpc::RpcResponseHeader)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
   &::tinyrpc::_RpcHeader_default_instance_._instance,
+  &::tinyrpc::_RpcResponseHeader_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_rpc_5fheader_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\020rpc_header.proto\022\007tinyrpc\"H\n\tRpcHeader"
-  "\022\024\n\014service_name\030\001 \001(\t\022\023\n\013method_name\030\002 "
-  "\001(\t\022\020\n\010args_len\030\003 \001(\rb\006proto3"
+  "\n\020rpc_header.proto\022\007tinyrpc\"\252\001\n\tRpcHeade"
+  "r\022\024\n\014service_name\030\001 \001(\t\022\023\n\013method_name\030\002"
+  " \001(\t\022\020\n\010args_len\030\003 \001(\r\022\017\n\007call_id\030\004 \001(\004\022"
+  "\020\n\010trace_id\030\005 \001(\006\022\017\n\007span_id\030\006 \001(\006\022\023\n\013tr"
+  "ace_flags\030\007 \001(\r\022\027\n\017attachment_size\030\010 \001(\r"
+  "\"e\n\021RpcResponseHeader\022\017\n\007call_id\030\001 \001(\004\022\022"
+  "\n\nerror_code\030\002 \001(\005\022\022\n\nerror_text\030\003 \001(\t\022\027"
+  "\n\017attachment_size\030\004 \001(\rb\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_rpc_5fheader_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_rpc_5fheader_2eproto = {
-    false, false, 109, descriptor_table_protodef_rpc_5fheader_2eproto,
+    false, false, 311, descriptor_table_protodef_rpc_5fheader_2eproto,
     "rpc_header.proto",
-    &descriptor_table_rpc_5fheader_2eproto_once, nullptr, 0, 1,
+    &descriptor_table_rpc_5fheader_2eproto_once, nullptr, 0, 2,
     schemas, file_default_instances, TableStruct_rpc_5fheader_2eproto::offsets,
     file_level_metadata_rpc_5fheader_2eproto, file_level_enum_descriptors_rpc_5fheader_2eproto,
     file_level_service_descriptors_rpc_5fheader_2eproto,
@@ -100,7 +143,12 @@ RpcHeader::RpcHeader(const RpcHeader& from)
   new (&_impl_) Impl_{
       decltype(_impl_.service_name_){}
     , decltype(_impl_.method_name_){}
+    , decltype(_impl_.call_id_){}
+    , decltype(_impl_.trace_id_){}
     , decltype(_impl_.args_len_){}
+    , decltype(_impl_.trace_flags_){}
+    , decltype(_impl_.span_id_){}
+    , decltype(_impl_.attachment_size_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -120,7 +168,9 @@ RpcHeader::RpcHeader(const RpcHeader& from)
     _this->_impl_.method_name_.Set(from._internal_method_name(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.args_len_ = from._impl_.args_len_;
+  ::memcpy(&_impl_.call_id_, &from._impl_.call_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.attachment_size_) -
+    reinterpret_cast<char*>(&_impl_.call_id_)) + sizeof(_impl_.attachment_size_));
   // @@protoc_insertion_point(copy_constructor:tinyrpc.RpcHeader)
 }
 
@@ -131,7 +181,12 @@ inline void RpcHeader::SharedCtor(
   new (&_impl_) Impl_{
       decltype(_impl_.service_name_){}
     , decltype(_impl_.method_name_){}
+    , decltype(_impl_.call_id_){uint64_t{0u}}
+    , decltype(_impl_.trace_id_){uint64_t{0u}}
     , decltype(_impl_.args_len_){0u}
+    , decltype(_impl_.trace_flags_){0u}
+    , decltype(_impl_.span_id_){uint64_t{0u}}
+    , decltype(_impl_.attachment_size_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.service_name_.InitDefault();
@@ -171,7 +226,9 @@ void RpcHeader::Clear() {
 
   _impl_.service_name_.ClearToEmpty();
   _impl_.method_name_.ClearToEmpty();
-  _impl_.args_len_ = 0u;
+  ::memset(&_impl_.call_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.attachment_size_) -
+      reinterpret_cast<char*>(&_impl_.call_id_)) + sizeof(_impl_.attachment_size_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -209,6 +266,46 @@ const char* RpcHeader::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx
         } else
           goto handle_unusual;
         continue;
+      // uint64 call_id = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.call_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed64 trace_id = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _impl_.trace_id_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // fixed64 span_id = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _impl_.span_id_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<uint64_t>(ptr);
+          ptr += sizeof(uint64_t);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 trace_flags = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.trace_flags_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 attachment_size = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.attachment_size_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -264,6 +361,36 @@ uint8_t* RpcHeader::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_args_len(), target);
   }
 
+  // uint64 call_id = 4;
+  if (this->_internal_call_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_call_id(), target);
+  }
+
+  // fixed64 trace_id = 5;
+  if (this->_internal_trace_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(5, this->_internal_trace_id(), target);
+  }
+
+  // fixed64 span_id = 6;
+  if (this->_internal_span_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFixed64ToArray(6, this->_internal_span_id(), target);
+  }
+
+  // uint32 trace_flags = 7;
+  if (this->_internal_trace_flags() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(7, this->_internal_trace_flags(), target);
+  }
+
+  // uint32 attachment_size = 8;
+  if (this->_internal_attachment_size() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(8, this->_internal_attachment_size(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -294,11 +421,36 @@ size_t RpcHeader::ByteSizeLong() const {
         this->_internal_method_name());
   }
 
+  // uint64 call_id = 4;
+  if (this->_internal_call_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_call_id());
+  }
+
+  // fixed64 trace_id = 5;
+  if (this->_internal_trace_id() != 0) {
+    total_size += 1 + 8;
+  }
+
   // uint32 args_len = 3;
   if (this->_internal_args_len() != 0) {
     total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_args_len());
   }
 
+  // uint32 trace_flags = 7;
+  if (this->_internal_trace_flags() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_trace_flags());
+  }
+
+  // fixed64 span_id = 6;
+  if (this->_internal_span_id() != 0) {
+    total_size += 1 + 8;
+  }
+
+  // uint32 attachment_size = 8;
+  if (this->_internal_attachment_size() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_attachment_size());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -323,9 +475,24 @@ void RpcHeader::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROT
   if (!from._internal_method_name().empty()) {
     _this->_internal_set_method_name(from._internal_method_name());
   }
+  if (from._internal_call_id() != 0) {
+    _this->_internal_set_call_id(from._internal_call_id());
+  }
+  if (from._internal_trace_id() != 0) {
+    _this->_internal_set_trace_id(from._internal_trace_id());
+  }
   if (from._internal_args_len() != 0) {
     _this->_internal_set_args_len(from._internal_args_len());
   }
+  if (from._internal_trace_flags() != 0) {
+    _this->_internal_set_trace_flags(from._internal_trace_flags());
+  }
+  if (from._internal_span_id() != 0) {
+    _this->_internal_set_span_id(from._internal_span_id());
+  }
+  if (from._internal_attachment_size() != 0) {
+    _this->_internal_set_attachment_size(from._internal_attachment_size());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -353,7 +520,12 @@ void RpcHeader::InternalSwap(RpcHeader* other) {
       &_impl_.method_name_, lhs_arena,
       &other->_impl_.method_name_, rhs_arena
   );
-  swap(_impl_.args_len_, other->_impl_.args_len_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(RpcHeader, _impl_.attachment_size_)
+      + sizeof(RpcHeader::_impl_.attachment_size_)
+      - PROTOBUF_FIELD_OFFSET(RpcHeader, _impl_.call_id_)>(
+          reinterpret_cast<char*>(&_impl_.call_id_),
+          reinterpret_cast<char*>(&other->_impl_.call_id_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata RpcHeader::GetMetadata() const {
@@ -362,6 +534,293 @@ void RpcHeader::InternalSwap(RpcHeader* other) {
       file_level_metadata_rpc_5fheader_2eproto[0]);
 }
 
+// ===================================================================
+
+class RpcResponseHeader::_Internal {
+ public:
+};
+
+RpcResponseHeader::RpcResponseHeader(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:tinyrpc.RpcResponseHeader)
+}
+RpcResponseHeader::RpcResponseHeader(const RpcResponseHeader& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  RpcResponseHeader* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.error_text_){}
+    , decltype(_impl_.call_id_){}
+    , decltype(_impl_.error_code_){}
+    , decltype(_impl_.attachment_size_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.error_text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_error_text().empty()) {
+    _this->_impl_.error_text_.Set(from._internal_error_text(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.call_id_, &from._impl_.call_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.attachment_size_) -
+    reinterpret_cast<char*>(&_impl_.call_id_)) + sizeof(_impl_.attachment_size_));
+  // @@protoc_insertion_point(copy_constructor:tinyrpc.RpcResponseHeader)
+}
+
+inline void RpcResponseHeader::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.error_text_){}
+    , decltype(_impl_.call_id_){uint64_t{0u}}
+    , decltype(_impl_.error_code_){0}
+    , decltype(_impl_.attachment_size_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.error_text_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+RpcResponseHeader::~RpcResponseHeader() {
+  // @@protoc_insertion_point(destructor:tinyrpc.RpcResponseHeader)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void RpcResponseHeader::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.error_text_.Destroy();
+}
+
+void RpcResponseHeader::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void RpcResponseHeader::Clear() {
+// @@protoc_insertion_point(message_clear_start:tinyrpc.RpcResponseHeader)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.error_text_.ClearToEmpty();
+  ::memset(&_impl_.call_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.attachment_size_) -
+      reinterpret_cast<char*>(&_impl_.call_id_)) + sizeof(_impl_.attachment_size_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* RpcResponseHeader::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // uint64 call_id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.call_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 error_code = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.error_code_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string error_text = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          auto str = _internal_mutable_error_text();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "tinyrpc.RpcResponseHeader.error_text"));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 attachment_size = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.attachment_size_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* RpcResponseHeader::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:tinyrpc.RpcResponseHeader)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // uint64 call_id = 1;
+  if (this->_internal_call_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_call_id(), target);
+  }
+
+  // int32 error_code = 2;
+  if (this->_internal_error_code() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(2, this->_internal_error_code(), target);
+  }
+
+  // string error_text = 3;
+  if (!this->_internal_error_text().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_error_text().data(), static_cast<int>(this->_internal_error_text().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "tinyrpc.RpcResponseHeader.error_text");
+    target = stream->WriteStringMaybeAliased(
+        3, this->_internal_error_text(), target);
+  }
+
+  // uint32 attachment_size = 4;
+  if (this->_internal_attachment_size() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_attachment_size(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:tinyrpc.RpcResponseHeader)
+  return target;
+}
+
+size_t RpcResponseHeader::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:tinyrpc.RpcResponseHeader)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string error_text = 3;
+  if (!this->_internal_error_text().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_error_text());
+  }
+
+  // uint64 call_id = 1;
+  if (this->_internal_call_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_call_id());
+  }
+
+  // int32 error_code = 2;
+  if (this->_internal_error_code() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_error_code());
+  }
+
+  // uint32 attachment_size = 4;
+  if (this->_internal_attachment_size() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_attachment_size());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData RpcResponseHeader::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    RpcResponseHeader::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*RpcResponseHeader::GetClassData() const { return &_class_data_; }
+
+
+void RpcResponseHeader::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<RpcResponseHeader*>(&to_msg);
+  auto& from = static_cast<const RpcResponseHeader&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:tinyrpc.RpcResponseHeader)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_error_text().empty()) {
+    _this->_internal_set_error_text(from._internal_error_text());
+  }
+  if (from._internal_call_id() != 0) {
+    _this->_internal_set_call_id(from._internal_call_id());
+  }
+  if (from._internal_error_code() != 0) {
+    _this->_internal_set_error_code(from._internal_error_code());
+  }
+  if (from._internal_attachment_size() != 0) {
+    _this->_internal_set_attachment_size(from._internal_attachment_size());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void RpcResponseHeader::CopyFrom(const RpcResponseHeader& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:tinyrpc.RpcResponseHeader)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RpcResponseHeader::IsInitialized() const {
+  return true;
+}
+
+void RpcResponseHeader::InternalSwap(RpcResponseHeader* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.error_text_, lhs_arena,
+      &other->_impl_.error_text_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(RpcResponseHeader, _impl_.attachment_size_)
+      + sizeof(RpcResponseHeader::_impl_.attachment_size_)
+      - PROTOBUF_FIELD_OFFSET(RpcResponseHeader, _impl_.call_id_)>(
+          reinterpret_cast<char*>(&_impl_.call_id_),
+          reinterpret_cast<char*>(&other->_impl_.call_id_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RpcResponseHeader::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_rpc_5fheader_2eproto_getter, &descriptor_table_rpc_5fheader_2eproto_once,
+      file_level_metadata_rpc_5fheader_2eproto[1]);
+}
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace tinyrpc
 PROTOBUF_NAMESPACE_OPEN
@@ -369,6 +828,10 @@ template<> PROTOBUF_NOINLINE ::tinyrpc::RpcHeader*
 Arena::CreateMaybeMessage< ::tinyrpc::RpcHeader >(Arena* arena) {
   return Arena::CreateMessageInternal< ::tinyrpc::RpcHeader >(arena);
 }
+template<> PROTOBUF_NOINLINE ::tinyrpc::RpcResponseHeader*
+Arena::CreateMaybeMessage< ::tinyrpc::RpcResponseHeader >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::tinyrpc::RpcResponseHeader >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
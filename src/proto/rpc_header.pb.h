@@ -13,7 +13,7 @@
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3021011 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -48,9 +48,13 @@ namespace tinyrpc {
 class RpcHeader;
 struct RpcHeaderDefaultTypeInternal;
 extern RpcHeaderDefaultTypeInternal _RpcHeader_default_instance_;
+class RpcResponseHeader;
+struct RpcResponseHeaderDefaultTypeInternal;
+extern RpcResponseHeaderDefaultTypeInternal _RpcResponseHeader_default_instance_;
 }  // namespace tinyrpc
 PROTOBUF_NAMESPACE_OPEN
 template<> ::tinyrpc::RpcHeader* Arena::CreateMaybeMessage<::tinyrpc::RpcHeader>(Arena*);
+template<> ::tinyrpc::RpcResponseHeader* Arena::CreateMaybeMessage<::tinyrpc::RpcResponseHeader>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace tinyrpc {
 
@@ -179,7 +183,12 @@ class RpcHeader final :
   enum : int {
     kServiceNameFieldNumber = 1,
     kMethodNameFieldNumber = 2,
+    kCallIdFieldNumber = 4,
+    kTraceIdFieldNumber = 5,
     kArgsLenFieldNumber = 3,
+    kTraceFlagsFieldNumber = 7,
+    kSpanIdFieldNumber = 6,
+    kAttachmentSizeFieldNumber = 8,
   };
   // string service_name = 1;
   void clear_service_name();
@@ -209,6 +218,24 @@ class RpcHeader final :
   std::string* _internal_mutable_method_name();
   public:
 
+  // uint64 call_id = 4;
+  void clear_call_id();
+  uint64_t call_id() const;
+  void set_call_id(uint64_t value);
+  private:
+  uint64_t _internal_call_id() const;
+  void _internal_set_call_id(uint64_t value);
+  public:
+
+  // fixed64 trace_id = 5;
+  void clear_trace_id();
+  uint64_t trace_id() const;
+  void set_trace_id(uint64_t value);
+  private:
+  uint64_t _internal_trace_id() const;
+  void _internal_set_trace_id(uint64_t value);
+  public:
+
   // uint32 args_len = 3;
   void clear_args_len();
   uint32_t args_len() const;
@@ -218,6 +245,33 @@ class RpcHeader final :
   void _internal_set_args_len(uint32_t value);
   public:
 
+  // uint32 trace_flags = 7;
+  void clear_trace_flags();
+  uint32_t trace_flags() const;
+  void set_trace_flags(uint32_t value);
+  private:
+  uint32_t _internal_trace_flags() const;
+  void _internal_set_trace_flags(uint32_t value);
+  public:
+
+  // fixed64 span_id = 6;
+  void clear_span_id();
+  uint64_t span_id() const;
+  void set_span_id(uint64_t value);
+  private:
+  uint64_t _internal_span_id() const;
+  void _internal_set_span_id(uint64_t value);
+  public:
+
+  // uint32 attachment_size = 8;
+  void clear_attachment_size();
+  uint32_t attachment_size() const;
+  void set_attachment_size(uint32_t value);
+  private:
+  uint32_t _internal_attachment_size() const;
+  void _internal_set_attachment_size(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:tinyrpc.RpcHeader)
  private:
   class _Internal;
@@ -228,7 +282,198 @@ class RpcHeader final :
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr service_name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr method_name_;
+    uint64_t call_id_;
+    uint64_t trace_id_;
     uint32_t args_len_;
+    uint32_t trace_flags_;
+    uint64_t span_id_;
+    uint32_t attachment_size_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_rpc_5fheader_2eproto;
+};
+// -------------------------------------------------------------------
+
+class RpcResponseHeader final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:tinyrpc.RpcResponseHeader) */ {
+ public:
+  inline RpcResponseHeader() : RpcResponseHeader(nullptr) {}
+  ~RpcResponseHeader() override;
+  explicit PROTOBUF_CONSTEXPR RpcResponseHeader(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  RpcResponseHeader(const RpcResponseHeader& from);
+  RpcResponseHeader(RpcResponseHeader&& from) noexcept
+    : RpcResponseHeader() {
+    *this = ::std::move(from);
+  }
+
+  inline RpcResponseHeader& operator=(const RpcResponseHeader& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline RpcResponseHeader& operator=(RpcResponseHeader&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RpcResponseHeader& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const RpcResponseHeader* internal_default_instance() {
+    return reinterpret_cast<const RpcResponseHeader*>(
+               &_RpcResponseHeader_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(RpcResponseHeader& a, RpcResponseHeader& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(RpcResponseHeader* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(RpcResponseHeader* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  RpcResponseHeader* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RpcResponseHeader>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const RpcResponseHeader& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RpcResponseHeader& from) {
+    RpcResponseHeader::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(RpcResponseHeader* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "tinyrpc.RpcResponseHeader";
+  }
+  protected:
+  explicit RpcResponseHeader(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kErrorTextFieldNumber = 3,
+    kCallIdFieldNumber = 1,
+    kErrorCodeFieldNumber = 2,
+    kAttachmentSizeFieldNumber = 4,
+  };
+  // string error_text = 3;
+  void clear_error_text();
+  const std::string& error_text() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_error_text(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_error_text();
+  PROTOBUF_NODISCARD std::string* release_error_text();
+  void set_allocated_error_text(std::string* error_text);
+  private:
+  const std::string& _internal_error_text() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_error_text(const std::string& value);
+  std::string* _internal_mutable_error_text();
+  public:
+
+  // uint64 call_id = 1;
+  void clear_call_id();
+  uint64_t call_id() const;
+  void set_call_id(uint64_t value);
+  private:
+  uint64_t _internal_call_id() const;
+  void _internal_set_call_id(uint64_t value);
+  public:
+
+  // int32 error_code = 2;
+  void clear_error_code();
+  int32_t error_code() const;
+  void set_error_code(int32_t value);
+  private:
+  int32_t _internal_error_code() const;
+  void _internal_set_error_code(int32_t value);
+  public:
+
+  // uint32 attachment_size = 4;
+  void clear_attachment_size();
+  uint32_t attachment_size() const;
+  void set_attachment_size(uint32_t value);
+  private:
+  uint32_t _internal_attachment_size() const;
+  void _internal_set_attachment_size(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:tinyrpc.RpcResponseHeader)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_text_;
+    uint64_t call_id_;
+    int32_t error_code_;
+    uint32_t attachment_size_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -365,9 +610,225 @@ inline void RpcHeader::set_args_len(uint32_t value) {
   // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.args_len)
 }
 
+// uint64 call_id = 4;
+inline void RpcHeader::clear_call_id() {
+  _impl_.call_id_ = uint64_t{0u};
+}
+inline uint64_t RpcHeader::_internal_call_id() const {
+  return _impl_.call_id_;
+}
+inline uint64_t RpcHeader::call_id() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcHeader.call_id)
+  return _internal_call_id();
+}
+inline void RpcHeader::_internal_set_call_id(uint64_t value) {
+  
+  _impl_.call_id_ = value;
+}
+inline void RpcHeader::set_call_id(uint64_t value) {
+  _internal_set_call_id(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.call_id)
+}
+
+// fixed64 trace_id = 5;
+inline void RpcHeader::clear_trace_id() {
+  _impl_.trace_id_ = uint64_t{0u};
+}
+inline uint64_t RpcHeader::_internal_trace_id() const {
+  return _impl_.trace_id_;
+}
+inline uint64_t RpcHeader::trace_id() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcHeader.trace_id)
+  return _internal_trace_id();
+}
+inline void RpcHeader::_internal_set_trace_id(uint64_t value) {
+  
+  _impl_.trace_id_ = value;
+}
+inline void RpcHeader::set_trace_id(uint64_t value) {
+  _internal_set_trace_id(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.trace_id)
+}
+
+// fixed64 span_id = 6;
+inline void RpcHeader::clear_span_id() {
+  _impl_.span_id_ = uint64_t{0u};
+}
+inline uint64_t RpcHeader::_internal_span_id() const {
+  return _impl_.span_id_;
+}
+inline uint64_t RpcHeader::span_id() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcHeader.span_id)
+  return _internal_span_id();
+}
+inline void RpcHeader::_internal_set_span_id(uint64_t value) {
+  
+  _impl_.span_id_ = value;
+}
+inline void RpcHeader::set_span_id(uint64_t value) {
+  _internal_set_span_id(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.span_id)
+}
+
+// uint32 trace_flags = 7;
+inline void RpcHeader::clear_trace_flags() {
+  _impl_.trace_flags_ = 0u;
+}
+inline uint32_t RpcHeader::_internal_trace_flags() const {
+  return _impl_.trace_flags_;
+}
+inline uint32_t RpcHeader::trace_flags() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcHeader.trace_flags)
+  return _internal_trace_flags();
+}
+inline void RpcHeader::_internal_set_trace_flags(uint32_t value) {
+  
+  _impl_.trace_flags_ = value;
+}
+inline void RpcHeader::set_trace_flags(uint32_t value) {
+  _internal_set_trace_flags(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.trace_flags)
+}
+
+// uint32 attachment_size = 8;
+inline void RpcHeader::clear_attachment_size() {
+  _impl_.attachment_size_ = 0u;
+}
+inline uint32_t RpcHeader::_internal_attachment_size() const {
+  return _impl_.attachment_size_;
+}
+inline uint32_t RpcHeader::attachment_size() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcHeader.attachment_size)
+  return _internal_attachment_size();
+}
+inline void RpcHeader::_internal_set_attachment_size(uint32_t value) {
+  
+  _impl_.attachment_size_ = value;
+}
+inline void RpcHeader::set_attachment_size(uint32_t value) {
+  _internal_set_attachment_size(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcHeader.attachment_size)
+}
+
+// -------------------------------------------------------------------
+
+// RpcResponseHeader
+
+// uint64 call_id = 1;
+inline void RpcResponseHeader::clear_call_id() {
+  _impl_.call_id_ = uint64_t{0u};
+}
+inline uint64_t RpcResponseHeader::_internal_call_id() const {
+  return _impl_.call_id_;
+}
+inline uint64_t RpcResponseHeader::call_id() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcResponseHeader.call_id)
+  return _internal_call_id();
+}
+inline void RpcResponseHeader::_internal_set_call_id(uint64_t value) {
+  
+  _impl_.call_id_ = value;
+}
+inline void RpcResponseHeader::set_call_id(uint64_t value) {
+  _internal_set_call_id(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcResponseHeader.call_id)
+}
+
+// int32 error_code = 2;
+inline void RpcResponseHeader::clear_error_code() {
+  _impl_.error_code_ = 0;
+}
+inline int32_t RpcResponseHeader::_internal_error_code() const {
+  return _impl_.error_code_;
+}
+inline int32_t RpcResponseHeader::error_code() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcResponseHeader.error_code)
+  return _internal_error_code();
+}
+inline void RpcResponseHeader::_internal_set_error_code(int32_t value) {
+  
+  _impl_.error_code_ = value;
+}
+inline void RpcResponseHeader::set_error_code(int32_t value) {
+  _internal_set_error_code(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcResponseHeader.error_code)
+}
+
+// string error_text = 3;
+inline void RpcResponseHeader::clear_error_text() {
+  _impl_.error_text_.ClearToEmpty();
+}
+inline const std::string& RpcResponseHeader::error_text() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcResponseHeader.error_text)
+  return _internal_error_text();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RpcResponseHeader::set_error_text(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.error_text_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcResponseHeader.error_text)
+}
+inline std::string* RpcResponseHeader::mutable_error_text() {
+  std::string* _s = _internal_mutable_error_text();
+  // @@protoc_insertion_point(field_mutable:tinyrpc.RpcResponseHeader.error_text)
+  return _s;
+}
+inline const std::string& RpcResponseHeader::_internal_error_text() const {
+  return _impl_.error_text_.Get();
+}
+inline void RpcResponseHeader::_internal_set_error_text(const std::string& value) {
+  
+  _impl_.error_text_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RpcResponseHeader::_internal_mutable_error_text() {
+  
+  return _impl_.error_text_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RpcResponseHeader::release_error_text() {
+  // @@protoc_insertion_point(field_release:tinyrpc.RpcResponseHeader.error_text)
+  return _impl_.error_text_.Release();
+}
+inline void RpcResponseHeader::set_allocated_error_text(std::string* error_text) {
+  if (error_text != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.error_text_.SetAllocated(error_text, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_text_.IsDefault()) {
+    _impl_.error_text_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:tinyrpc.RpcResponseHeader.error_text)
+}
+
+// uint32 attachment_size = 4;
+inline void RpcResponseHeader::clear_attachment_size() {
+  _impl_.attachment_size_ = 0u;
+}
+inline uint32_t RpcResponseHeader::_internal_attachment_size() const {
+  return _impl_.attachment_size_;
+}
+inline uint32_t RpcResponseHeader::attachment_size() const {
+  // @@protoc_insertion_point(field_get:tinyrpc.RpcResponseHeader.attachment_size)
+  return _internal_attachment_size();
+}
+inline void RpcResponseHeader::_internal_set_attachment_size(uint32_t value) {
+  
+  _impl_.attachment_size_ = value;
+}
+inline void RpcResponseHeader::set_attachment_size(uint32_t value) {
+  _internal_set_attachment_size(value);
+  // @@protoc_insertion_point(field_set:tinyrpc.RpcResponseHeader.attachment_size)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
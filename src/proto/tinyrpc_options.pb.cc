@@ -0,0 +1,70 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: tinyrpc_options.proto
+
+#include "tinyrpc_options.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+
+PROTOBUF_PRAGMA_INIT_SEG
+
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
+
+namespace tinyrpc {
+}  // namespace tinyrpc
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_tinyrpc_5foptions_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_tinyrpc_5foptions_2eproto = nullptr;
+const uint32_t TableStruct_tinyrpc_5foptions_2eproto::offsets[1] = {};
+static constexpr ::_pbi::MigrationSchema* schemas = nullptr;
+static constexpr ::_pb::Message* const* file_default_instances = nullptr;
+
+const char descriptor_table_protodef_tinyrpc_5foptions_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\025tinyrpc_options.proto\022\007tinyrpc\032 google"
+  "/protobuf/descriptor.proto:2\n\010coalesce\022\036"
+  ".google.protobuf.MethodOptions\030\321\206\003 \001(\010:6"
+  "\n\014cache_ttl_ms\022\036.google.protobuf.MethodO"
+  "ptions\030\322\206\003 \001(\rb\006proto3"
+  ;
+static const ::_pbi::DescriptorTable* const descriptor_table_tinyrpc_5foptions_2eproto_deps[1] = {
+  &::descriptor_table_google_2fprotobuf_2fdescriptor_2eproto,
+};
+static ::_pbi::once_flag descriptor_table_tinyrpc_5foptions_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_tinyrpc_5foptions_2eproto = {
+    false, false, 182, descriptor_table_protodef_tinyrpc_5foptions_2eproto,
+    "tinyrpc_options.proto",
+    &descriptor_table_tinyrpc_5foptions_2eproto_once, descriptor_table_tinyrpc_5foptions_2eproto_deps, 1, 0,
+    schemas, file_default_instances, TableStruct_tinyrpc_5foptions_2eproto::offsets,
+    nullptr, file_level_enum_descriptors_tinyrpc_5foptions_2eproto,
+    file_level_service_descriptors_tinyrpc_5foptions_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_tinyrpc_5foptions_2eproto_getter() {
+  return &descriptor_table_tinyrpc_5foptions_2eproto;
+}
+
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_tinyrpc_5foptions_2eproto(&descriptor_table_tinyrpc_5foptions_2eproto);
+namespace tinyrpc {
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::PROTOBUF_NAMESPACE_ID::MethodOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false>
+  coalesce(kCoalesceFieldNumber, false, nullptr);
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::PROTOBUF_NAMESPACE_ID::MethodOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< uint32_t >, 13, false>
+  cache_ttl_ms(kCacheTtlMsFieldNumber, 0u, nullptr);
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace tinyrpc
+PROTOBUF_NAMESPACE_OPEN
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file           : ClientTransport.h
+  * @author         : xy
+  * @brief          : 客户端到单个节点的传输方式：TCP/UDS（RpcConnection）或共享内存（ShmConnection）
+  * @attention      : None
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_CLIENTTRANSPORT_H_
+#define TINYRPC_SRC_RPC_CLIENTTRANSPORT_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "utils/HvProtocol.h"
+
+// 响应附件：data 指向 buffer（收到的响应帧）中的一段，不拷贝；没有附件时 buffer 为空
+struct ResponseAttachment {
+  std::shared_ptr<const std::string> buffer;
+  std::string_view data;
+};
+
+class ClientTransport {
+ public:
+  // error_code 为 RPC_OK 时 body 为响应消息的序列化数据，attachment 为响应附件
+  using Callback = std::function<void(int error_code, const std::string &error_text, const std::string &body,
+									  ResponseAttachment attachment)>;
+
+  virtual ~ClientTransport() = default;
+  // 线程安全；frame 为已打包好的请求帧，响应、超时或连接异常时回调
+  virtual void Send(uint64_t call_id, std::string frame, int timeout_ms, Callback callback) = 0;
+  // 带附件的请求帧；默认拼接后发送，支持分段写的传输方式可覆盖以免拷贝附件
+  virtual void Send(uint64_t call_id, FrameParts frame, int timeout_ms, Callback callback) {
+	  Send(call_id, frame.join(), timeout_ms, std::move(callback));
+  }
+  // 对端在帧头中声明的可解码编码集合，收到首个响应前为 0（不压缩）
+  virtual uint8_t PeerAccept() const = 0;
+  virtual size_t MaxFrameSize() const { return SIZE_MAX; }
+};
+
+// 解析后的响应帧
+struct ResponseFrame {
+  uint8_t accept = 0;
+  uint8_t flags = 0;
+  uint64_t call_id = 0;
+  int error_code = 0;
+  std::string error_text;
+  std::string body;    // 已解压
+  ResponseAttachment attachment;
+};
+
+// 拆包、校验并解压响应帧。帧本身损坏时返回 false；只有消息体解压失败时返回 true，error_code 置为 RPC_ERR_BAD_RESPONSE
+bool decodeResponse(const char *data, size_t size, ResponseFrame &frame);
+// 拆开批量响应帧后逐个解析，任一内层帧损坏时返回 false
+bool decodeBatchResponse(const char *data, size_t size, std::vector<ResponseFrame> &frames);
+
+#endif //TINYRPC_SRC_RPC_CLIENTTRANSPORT_H_
@@ -0,0 +1,199 @@
+/**
+  ******************************************************************************
+  * @file           : Endpoint.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#include <sstream>
+#include <unistd.h>
+#include "Endpoint.h"
+#include "utils/Clock.h"
+#include "utils/Config.h"
+
+Endpoint::Endpoint(const hv::EventLoopPtr &loop, const RegistryEntry &entry, const OutlierConfig &config,
+				   size_t shm_ring_size)
+	: address(entry.Address()), stats(config) {
+	// 套接字文件可访问才说明与服务端共享文件系统（同一 ip 也可能是另一个容器）
+	uds = !entry.uds_path.empty() && isLocalAddress(entry.ip) && access(entry.uds_path.c_str(), R_OK | W_OK) == 0;
+	if (uds) {
+		connection = std::make_unique<RpcConnection>(loop, entry.uds_path, -1);    // libhv 中 port < 0 表示 UDS
+	} else {
+		connection = std::make_unique<RpcConnection>(loop, entry.ip, entry.port);
+	}
+
+	if (shm_ring_size != 0 && !entry.shm_path.empty() && isLocalAddress(entry.ip)
+		&& access(entry.shm_path.c_str(), R_OK | W_OK) == 0) {
+		shm = ShmConnection::Connect(loop, entry.shm_path, shm_ring_size);
+	}
+}
+
+EndpointManager *EndpointManager::instance = nullptr;
+
+EndpointManager *EndpointManager::getInstance() {
+	static std::once_flag flag;
+	std::call_once(flag, [&] {
+	  instance = new EndpointManager();
+	  atexit(destroy);
+	});
+	return instance;
+}
+
+EndpointManager::EndpointManager()
+	: outlier_config(OutlierConfig::fromConfig()) {
+	auto ring_kb = Config::getInstance()->get("shm_ring_kb");
+	shm_ring_size = ring_kb == std::nullopt ? kDefaultShmRingSize : std::stoull(ring_kb.value()) * 1024;
+	prewarm = Config::getInstance()->get("prewarm") != "0";
+	loop_thread.start();
+	if (prewarm) {
+		refresher = std::thread([this]() { RefreshLoop(); });
+	}
+}
+
+EndpointManager::~EndpointManager() {
+	refresh_paths.stop();
+	if (refresher.joinable()) {
+		refresher.join();
+	}
+	loop_thread.stop();
+}
+
+void EndpointManager::destroy() {
+	if (instance) {
+		delete instance;
+		instance = nullptr;
+	}
+}
+
+std::shared_ptr<Endpoint> EndpointManager::Resolve(const std::string &service_name, const std::string &method_name,
+												   std::string &error) {
+	auto path = "/" + service_name + "/" + method_name;
+	RegistryEntry entry;
+	if (!RegistryEntry::Parse(Lookup(path), entry)) {
+		error = "get data from zk failed: " + path;
+		return nullptr;
+	}
+
+	return GetEndpoint(path, entry);
+}
+
+/**
+ * @brief 每条路由只有一个节点时名额总是不足，节点不会被摘除（摘除后该路由将无节点可用）
+ */
+std::shared_ptr<Endpoint> EndpointManager::GetEndpoint(const std::string &path, const RegistryEntry &entry) {
+	std::lock_guard<std::mutex> lock(mtx);
+	auto address = entry.Address();
+	auto &endpoint = endpoints[address];
+	if (!endpoint) {
+		endpoint = std::make_shared<Endpoint>(Loop(), entry, outlier_config, shm_ring_size);
+	}
+	auto &route = route_budgets[path];
+	if (!route.budget) {
+		route.budget = std::make_unique<EjectionBudget>(outlier_config.max_ejection_percent);
+	}
+	if (route.address != address) {
+		// 路由改由另一个节点服务，原节点退出该路由的名额
+		auto old_iter = endpoints.find(route.address);
+		if (old_iter != endpoints.end()) {
+			old_iter->second->Stats().LeaveBudget(route.budget.get());
+		}
+		endpoint->Stats().JoinBudget(route.budget.get());
+		route.address = address;
+	}
+	return endpoint;
+}
+
+size_t EndpointManager::Prewarm(const std::string &service_name) {
+	std::call_once(zk_flag, [this]() { zk.start(); });
+	std::unordered_map<std::string, std::shared_ptr<Endpoint>> warmed;
+	for (const auto &method_name : zk.getChildren("/" + service_name)) {
+		RegistryEntry entry;
+		if (RegistryEntry::Parse(Lookup("/" + service_name + "/" + method_name), entry)) {
+			warmed.emplace(entry.Address(), GetEndpoint("/" + service_name + "/" + method_name, entry));
+		}
+	}
+	for (const auto &item : warmed) {
+		item.second->Warmup();
+	}
+	return warmed.size();
+}
+
+/**
+ * @brief 节点变更后重新查询（同时重新注册 watch），新节点在下一次调用之前就开始建立连接
+ */
+void EndpointManager::RefreshLoop() {
+	std::string path;
+	while (refresh_paths.pop(path)) {
+		RegistryEntry entry;
+		if (RegistryEntry::Parse(Lookup(path), entry)) {
+			GetEndpoint(path, entry)->Warmup();
+		}
+	}
+}
+
+/**
+ * @brief 路由缓存未命中时查询 zk，并注册 watch 在节点变化时使缓存失效
+ * @attention 查询 zk 时不能持有 mtx：watch 回调在 zk 线程中执行并需要获取 mtx
+ */
+std::string EndpointManager::Lookup(const std::string &path) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		auto iter = routes.find(path);
+		if (iter != routes.end()) {
+			return iter->second;
+		}
+	}
+
+	std::call_once(zk_flag, [this]() { zk.start(); });
+	auto address = zk.getData(path, [this, path]() {
+	  {
+		  std::lock_guard<std::mutex> lock(mtx);
+		  routes.erase(path);
+	  }
+	  if (prewarm) {
+		  refresh_paths.push(path);
+	  }
+	});
+	if (!address.empty()) {
+		std::lock_guard<std::mutex> lock(mtx);
+		routes[path] = address;
+	}
+	return address;
+}
+
+std::string EndpointManager::Dump() {
+	std::vector<std::shared_ptr<Endpoint>> list;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		for (const auto &item : endpoints) {
+			list.push_back(item.second);
+		}
+	}
+
+	auto now = nowNs();
+	std::ostringstream oss;
+	for (const auto &endpoint : list) {
+		auto snapshot = endpoint->Stats().Snapshot(now);
+		oss << endpoint->Address() << (endpoint->IsShm() ? " [shm]" : endpoint->IsUds() ? " [uds]" : "")
+			<< (snapshot.ejected ? " [ejected]" : "")
+			<< " inflight=" << snapshot.inflight
+			<< " requests=" << snapshot.requests
+			<< " errors=" << snapshot.errors
+			<< " timeouts=" << snapshot.timeouts
+			<< " connect_failures=" << snapshot.connect_failures
+			<< " ejections=" << snapshot.ejections
+			<< " ewma_us=" << snapshot.latency_ewma_ns / 1000
+			<< " p50_us=" << snapshot.latency.percentile(0.5) / 1000
+			<< " p99_us=" << snapshot.latency.percentile(0.99) / 1000 << "\n";
+		for (const auto &method : endpoint->Stats().MethodLatency()) {
+			oss << "  " << method.first
+				<< " count=" << method.second.count
+				<< " p50_us=" << method.second.percentile(0.5) / 1000
+				<< " p99_us=" << method.second.percentile(0.99) / 1000 << "\n";
+		}
+	}
+	return oss.str();
+}
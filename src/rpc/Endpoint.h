@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file           : Endpoint.h
+  * @author         : xy
+  * @brief          : 客户端的服务发现与节点管理
+  * @attention      : EndpointManager 为进程级单例，持有 zk 会话、路由缓存、各节点的持久连接与统计，
+  *                   不再在每次 CallMethod 时重建；prewarm=1 时节点变更（zk watch）后在后台重新查询并预先连接新节点，
+  *                   调用方也可以在启动时用 Prewarm 连接一个服务的全部节点
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_ENDPOINT_H_
+#define TINYRPC_SRC_RPC_ENDPOINT_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <hv/EventLoop.h>
+#include "EndpointStats.h"
+#include "RpcConnection.h"
+#include "ShmTransport.h"
+#include "RegistryEntry.h"
+#include "utils/SafeQueue.h"
+#include "utils/Zookeeper.h"
+
+class Endpoint {
+ public:
+  // 节点在本机时优先使用共享内存，其次 UDS，否则走 TCP
+  Endpoint(const hv::EventLoopPtr &loop, const RegistryEntry &entry, const OutlierConfig &config, size_t shm_ring_size);
+  const std::string &Address() const { return address; }
+  bool IsUds() const { return uds; }
+  bool IsShm() const { return shm && shm->Alive(); }
+  EndpointStats &Stats() { return stats; }
+  // 共享内存断开或帧超过环的容量时改用 UDS/TCP 连接
+  ClientTransport &Connection(size_t frame_size = 0) {
+	  if (shm && shm->Alive() && frame_size <= shm->MaxFrameSize()) {
+		  return *shm;
+	  }
+	  return *connection;
+  }
+  // 流式调用只走 UDS/TCP 连接
+  RpcConnection &StreamConnection() { return *connection; }
+  void Warmup() { connection->Warmup(); }
+ private:
+  std::string address;    // ip:port
+  bool uds = false;
+  EndpointStats stats;
+  std::unique_ptr<RpcConnection> connection;
+  std::unique_ptr<ShmConnection> shm;
+};
+
+class EndpointManager {
+ public:
+  static EndpointManager *getInstance();
+  // 查找提供该方法的节点，失败时返回 nullptr 并写入 error
+  std::shared_ptr<Endpoint> Resolve(const std::string &service_name, const std::string &method_name, std::string &error);
+  // 查询该服务全部方法的节点并预先建立连接，返回节点数
+  size_t Prewarm(const std::string &service_name);
+  // 各节点的调用统计（文本）
+  std::string Dump();
+  const hv::EventLoopPtr &Loop() { return loop_thread.loop(); }
+ private:
+  EndpointManager();
+  ~EndpointManager();
+  static void destroy();
+  std::string Lookup(const std::string &path);
+  // path 为该节点服务的路由（zk 路径），节点加入该路由的摘除名额
+  std::shared_ptr<Endpoint> GetEndpoint(const std::string &path, const RegistryEntry &entry);
+  void RefreshLoop();
+ private:
+  static EndpointManager *instance;
+  hv::EventLoopThread loop_thread;    // 所有客户端连接共用的 IO 线程
+  Zookeeper zk;
+  std::once_flag zk_flag;
+  OutlierConfig outlier_config;
+  size_t shm_ring_size;    // 配置项 shm_ring_kb，0 表示不使用共享内存
+  bool prewarm = true;     // 配置项 prewarm
+  SafeQueue<std::string> refresh_paths;    // 发生变更的 zk 路径，zk 回调线程中不能发起同步请求，交给 refresher 查询
+  std::thread refresher;
+  std::mutex mtx;
+  std::unordered_map<std::string, std::string> routes;                        // zk 路径 -> 节点数据（RegistryEntry）
+  struct RouteBudget {
+	std::unique_ptr<EjectionBudget> budget;
+	std::string address;    // 当前服务该路由的节点
+  };
+  std::unordered_map<std::string, RouteBudget> route_budgets;                 // zk 路径 -> 摘除名额，须在 endpoints 之后析构
+  std::unordered_map<std::string, std::shared_ptr<Endpoint>> endpoints;       // ip:port -> 节点
+};
+
+#endif //TINYRPC_SRC_RPC_ENDPOINT_H_
@@ -0,0 +1,262 @@
+/**
+  ******************************************************************************
+  * @file           : EndpointStats.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#include <algorithm>
+#include "EndpointStats.h"
+#include "utils/Config.h"
+
+/**
+ * @brief 从配置文件读取摘除参数，未配置的项保持默认值
+ */
+OutlierConfig OutlierConfig::fromConfig() {
+	OutlierConfig config;
+	auto config_file = Config::getInstance();
+	if (auto value = config_file->get("outlier_consecutive_errors")) {
+		config.consecutive_errors = std::stoul(value.value());
+	}
+	if (auto value = config_file->get("outlier_error_rate")) {
+		config.error_rate = std::stod(value.value());
+	}
+	if (auto value = config_file->get("outlier_min_requests")) {
+		config.min_requests = std::stoul(value.value());
+	}
+	if (auto value = config_file->get("outlier_latency_ms")) {
+		config.latency_ns = std::stoull(value.value()) * 1000000;
+	}
+	if (auto value = config_file->get("outlier_window_ms")) {
+		config.window_ns = std::stoull(value.value()) * 1000000;
+	}
+	if (auto value = config_file->get("outlier_eject_ms")) {
+		config.eject_ns = std::stoull(value.value()) * 1000000;
+	}
+	if (auto value = config_file->get("outlier_max_ejection_percent")) {
+		config.max_ejection_percent = std::stoul(value.value());
+	}
+	return config;
+}
+
+bool EjectionBudget::TryEject() {
+	auto current = ejected.load(std::memory_order_relaxed);
+	do {
+		auto total = endpoints.load(std::memory_order_relaxed);
+		if (current + 1 >= total || (current + 1) * 100 > static_cast<size_t>(max_percent) * total) {
+			return false;
+		}
+	} while (!ejected.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+	return true;
+}
+
+EndpointStats::EndpointStats(const OutlierConfig &config, EjectionBudget *budget) : config(config) {
+	if (budget != nullptr) {
+		JoinBudget(budget);
+	}
+}
+
+EndpointStats::~EndpointStats() {
+	std::lock_guard<std::mutex> lock(window_mtx);
+	ReleaseBudgets();
+	for (auto &slot : budgets) {
+		slot.budget->RemoveEndpoint();
+	}
+}
+
+/**
+ * @brief 摘除期间加入的名额不计入本次摘除，恢复时也不归还
+ */
+void EndpointStats::JoinBudget(EjectionBudget *budget) {
+	std::lock_guard<std::mutex> lock(window_mtx);
+	for (auto &slot : budgets) {
+		if (slot.budget == budget) {
+			return;
+		}
+	}
+	budget->AddEndpoint();
+	budgets.push_back({budget, false});
+}
+
+void EndpointStats::LeaveBudget(EjectionBudget *budget) {
+	std::lock_guard<std::mutex> lock(window_mtx);
+	for (auto iter = budgets.begin(); iter != budgets.end(); ++iter) {
+		if (iter->budget == budget) {
+			if (iter->charged) {
+				budget->Release();
+			}
+			budget->RemoveEndpoint();
+			budgets.erase(iter);
+			return;
+		}
+	}
+}
+
+void EndpointStats::ReleaseBudgets() {
+	for (auto &slot : budgets) {
+		if (slot.charged) {
+			slot.budget->Release();
+			slot.charged = false;
+		}
+	}
+}
+
+void EndpointStats::OnStart() {
+	inflight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EndpointStats::OnFinish(const std::string &method, uint64_t latency_ns, CallResult result, uint64_t now_ns) {
+	inflight.fetch_sub(1, std::memory_order_relaxed);
+	requests.fetch_add(1, std::memory_order_relaxed);
+	latency.record(latency_ns);
+
+	auto &stats = MethodStats(method);
+	stats.requests.fetch_add(1, std::memory_order_relaxed);
+	stats.latency.record(latency_ns);
+
+	if (result == CallResult::ERROR) {
+		errors.fetch_add(1, std::memory_order_relaxed);
+		stats.errors.fetch_add(1, std::memory_order_relaxed);
+	} else if (result == CallResult::TIMEOUT) {
+		timeouts.fetch_add(1, std::memory_order_relaxed);
+		stats.timeouts.fetch_add(1, std::memory_order_relaxed);
+	} else if (result == CallResult::CONNECT_FAILED) {
+		connect_failures.fetch_add(1, std::memory_order_relaxed);
+		stats.errors.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	UpdateEwma(latency_ns);
+	RecordOutcome(result != CallResult::OK, now_ns);
+}
+
+bool EndpointStats::Available(uint64_t now_ns) {
+	if (!ejected.load(std::memory_order_acquire)) {
+		return true;
+	}
+	if (Ejected(now_ns)) {
+		return false;
+	}
+	bool expected = false;
+	return probe_sent.compare_exchange_strong(expected, true, std::memory_order_relaxed);
+}
+
+ClientMethodStats &EndpointStats::MethodStats(const std::string &method) {
+	std::lock_guard<std::mutex> lock(method_mtx);
+	auto &stats = method_stats[method];
+	if (!stats) {
+		stats = std::make_unique<ClientMethodStats>();
+	}
+	return *stats;
+}
+
+/**
+ * @brief 延迟 EWMA，权重 1/8
+ */
+void EndpointStats::UpdateEwma(uint64_t latency_ns) {
+	auto old_value = latency_ewma_ns.load(std::memory_order_relaxed);
+	uint64_t new_value;
+	do {
+		new_value = old_value == 0 ? latency_ns
+								   : old_value - old_value / 8 + latency_ns / 8;
+	} while (!latency_ewma_ns.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed));
+}
+
+void EndpointStats::RecordOutcome(bool failed, uint64_t now_ns) {
+	std::lock_guard<std::mutex> lock(window_mtx);
+	if (ejected.load(std::memory_order_relaxed)) {
+		// 摘除期间只看探测请求的结果，摘除前发出的请求不再参与判断
+		if (!probe_sent.load(std::memory_order_relaxed)) {
+			return;
+		}
+		ejected.store(false, std::memory_order_release);
+		probe_sent.store(false, std::memory_order_relaxed);
+		ReleaseBudgets();
+		if (failed) {
+			Eject(now_ns);
+		} else {
+			eject_times = 0;    // 节点已恢复，下次摘除重新从 eject_ns 开始
+		}
+		return;
+	}
+
+	if (now_ns - window_start_ns >= config.window_ns) {
+		// 一个完整窗口内没有失败，认为节点已恢复，摘除时长重新计算
+		if (window_requests > 0 && window_failures == 0) {
+			eject_times = 0;
+		}
+		window_start_ns = now_ns;
+		window_requests = 0;
+		window_failures = 0;
+	}
+
+	window_requests++;
+	if (failed) {
+		window_failures++;
+		consecutive_failures++;
+	} else {
+		consecutive_failures = 0;
+	}
+
+	bool eject = consecutive_failures >= config.consecutive_errors;
+	if (window_requests >= config.min_requests
+		&& static_cast<double>(window_failures) / window_requests > config.error_rate) {
+		eject = true;
+	}
+	if (config.latency_ns != 0 && latency_ewma_ns.load(std::memory_order_relaxed) > config.latency_ns) {
+		eject = true;
+	}
+	if (eject) {
+		Eject(now_ns);
+	}
+}
+
+/**
+ * @brief 摘除节点，调用方持有 window_mtx；任一路由的名额用尽时保持可用，之后的失败会再次尝试
+ */
+void EndpointStats::Eject(uint64_t now_ns) {
+	for (auto &slot : budgets) {
+		if (!slot.budget->TryEject()) {
+			ReleaseBudgets();
+			return;
+		}
+		slot.charged = true;
+	}
+	auto duration = config.eject_ns << std::min(eject_times, config.max_eject_times);
+	ejected_until_ns.store(now_ns + duration, std::memory_order_relaxed);
+	ejected.store(true, std::memory_order_release);
+	eject_times++;
+	ejections.fetch_add(1, std::memory_order_relaxed);
+
+	// 恢复后重新观察
+	window_start_ns = now_ns;
+	window_requests = 0;
+	window_failures = 0;
+	consecutive_failures = 0;
+	latency_ewma_ns.store(0, std::memory_order_relaxed);
+}
+
+EndpointStatsSnapshot EndpointStats::Snapshot(uint64_t now_ns) const {
+	EndpointStatsSnapshot snapshot;
+	snapshot.inflight = inflight.load(std::memory_order_relaxed);
+	snapshot.requests = requests.load(std::memory_order_relaxed);
+	snapshot.errors = errors.load(std::memory_order_relaxed);
+	snapshot.timeouts = timeouts.load(std::memory_order_relaxed);
+	snapshot.connect_failures = connect_failures.load(std::memory_order_relaxed);
+	snapshot.ejections = ejections.load(std::memory_order_relaxed);
+	snapshot.latency_ewma_ns = latency_ewma_ns.load(std::memory_order_relaxed);
+	snapshot.ejected = Ejected(now_ns);
+	latency.snapshotInto(snapshot.latency);
+	return snapshot;
+}
+
+std::unordered_map<std::string, HistogramSnapshot> EndpointStats::MethodLatency() const {
+	std::unordered_map<std::string, HistogramSnapshot> result;
+	std::lock_guard<std::mutex> lock(method_mtx);
+	for (const auto &item : method_stats) {
+		item.second->latency.snapshotInto(result[item.first]);
+	}
+	return result;
+}
@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file           : EndpointStats.h
+  * @author         : xy
+  * @brief          : 客户端按节点、按方法的调用统计，以及异常节点摘除（outlier ejection）
+  * @attention      : 计数器与直方图无锁；摘除判断用的时间窗口加锁维护；
+  *                   每条路由（服务/方法）的节点共享一个 EjectionBudget，被摘除的节点不超过 max_ejection_percent，
+  *                   且不会摘除最后一个可用节点；节点服务多条路由时须在每条路由上都取得名额才会被摘除；
+  *                   摘除到期后只放行一个探测请求，成功则恢复并重置摘除时长，失败则立即再次摘除
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_ENDPOINTSTATS_H_
+#define TINYRPC_SRC_RPC_ENDPOINTSTATS_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/Histogram.h"
+
+enum class CallResult {
+  OK,
+  ERROR,
+  TIMEOUT,
+  CONNECT_FAILED
+};
+
+struct OutlierConfig {
+  uint32_t consecutive_errors = 5;     // 连续失败次数达到该值即摘除
+  double error_rate = 0.5;             // 窗口内错误率超过该值即摘除
+  uint32_t min_requests = 20;          // 窗口内请求数达到该值才按错误率判断
+  uint64_t latency_ns = 0;             // 延迟 EWMA 超过该值即摘除，0 表示不按延迟判断
+  uint64_t window_ns = 10'000'000'000;
+  uint64_t eject_ns = 10'000'000'000;  // 首次摘除时长，之后每次翻倍
+  uint32_t max_eject_times = 5;        // 翻倍次数上限
+  uint32_t max_ejection_percent = 50;  // 同时被摘除的节点占比上限
+
+  static OutlierConfig fromConfig();
+};
+
+// 能服务同一路由的一组节点共享的摘除名额
+class EjectionBudget {
+ public:
+  explicit EjectionBudget(uint32_t max_percent) : max_percent(max_percent) {}
+  void AddEndpoint() { endpoints.fetch_add(1, std::memory_order_relaxed); }
+  void RemoveEndpoint() { endpoints.fetch_sub(1, std::memory_order_relaxed); }
+  // 摘除后仍有可用节点且不超过占比上限时占用一个名额并返回 true
+  bool TryEject();
+  void Release() { ejected.fetch_sub(1, std::memory_order_relaxed); }
+  size_t EjectedNum() const { return ejected.load(std::memory_order_relaxed); }
+ private:
+  uint32_t max_percent;
+  std::atomic<size_t> endpoints = 0;
+  std::atomic<size_t> ejected = 0;
+};
+
+struct ClientMethodStats {
+  std::atomic<uint64_t> requests = 0;
+  std::atomic<uint64_t> errors = 0;
+  std::atomic<uint64_t> timeouts = 0;
+  Histogram latency;
+};
+
+struct EndpointStatsSnapshot {
+  int64_t inflight = 0;
+  uint64_t requests = 0;
+  uint64_t errors = 0;
+  uint64_t timeouts = 0;
+  uint64_t connect_failures = 0;
+  uint64_t ejections = 0;
+  uint64_t latency_ewma_ns = 0;
+  bool ejected = false;
+  HistogramSnapshot latency;
+};
+
+class EndpointStats {
+ public:
+  // budget 不为 nullptr 时加入该名额；未加入任何名额时不限制摘除（只用于单独测试摘除条件）
+  explicit EndpointStats(const OutlierConfig &config, EjectionBudget *budget = nullptr);
+  ~EndpointStats();
+  // 节点开始/不再服务某条路由时加入/退出该路由的名额，重复加入不重复计数；budget 须在退出前一直有效
+  void JoinBudget(EjectionBudget *budget);
+  void LeaveBudget(EjectionBudget *budget);
+  void OnStart();
+  void OnFinish(const std::string &method, uint64_t latency_ns, CallResult result, uint64_t now_ns);
+  // 当前是否可以向该节点发送请求；摘除到期后第一次调用返回 true（探测请求），结果返回前其余调用返回 false
+  bool Available(uint64_t now_ns);
+  // 处于摘除时长内，不占用探测名额
+  bool Ejected(uint64_t now_ns) const {
+	  return ejected.load(std::memory_order_acquire) && now_ns < ejected_until_ns.load(std::memory_order_relaxed);
+  }
+  EndpointStatsSnapshot Snapshot(uint64_t now_ns) const;
+  // 快照里的直方图按方法给出
+  std::unordered_map<std::string, HistogramSnapshot> MethodLatency() const;
+ private:
+  ClientMethodStats &MethodStats(const std::string &method);
+  void UpdateEwma(uint64_t latency_ns);
+  void RecordOutcome(bool failed, uint64_t now_ns);
+  void Eject(uint64_t now_ns);
+  // 归还已占用的名额，调用方持有 window_mtx
+  void ReleaseBudgets();
+ private:
+  struct BudgetSlot {
+	EjectionBudget *budget;
+	bool charged;    // 当前摘除是否占用了该名额
+  };
+ private:
+  OutlierConfig config;
+  std::atomic<int64_t> inflight = 0;
+  std::atomic<uint64_t> requests = 0;
+  std::atomic<uint64_t> errors = 0;
+  std::atomic<uint64_t> timeouts = 0;
+  std::atomic<uint64_t> connect_failures = 0;
+  std::atomic<uint64_t> ejections = 0;
+  std::atomic<uint64_t> latency_ewma_ns = 0;
+  std::atomic<bool> ejected = false;
+  std::atomic<bool> probe_sent = false;
+  std::atomic<uint64_t> ejected_until_ns = 0;
+  Histogram latency;
+
+  mutable std::mutex method_mtx;
+  std::unordered_map<std::string, std::unique_ptr<ClientMethodStats>> method_stats;
+
+  // 摘除判断使用的窗口状态，受 window_mtx 保护
+  std::mutex window_mtx;
+  uint64_t window_start_ns = 0;
+  uint32_t window_requests = 0;
+  uint32_t window_failures = 0;
+  uint32_t consecutive_failures = 0;
+  uint32_t eject_times = 0;
+  std::vector<BudgetSlot> budgets;
+};
+
+#endif //TINYRPC_SRC_RPC_ENDPOINTSTATS_H_
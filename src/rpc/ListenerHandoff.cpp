@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file           : ListenerHandoff.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/10
+  ******************************************************************************
+  */
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ListenerHandoff.h"
+#include "utils/FdPassing.h"
+#include "utils/Log.h"
+
+namespace {
+
+constexpr uint32_t kHandoffMagic = 0x484f4646;    // "HOFF"
+constexpr int kHandoffTimeoutMs = 30000;          // 新进程接管（含连接注册中心）的最长时间
+constexpr char kHandoffAck = 'k';
+
+struct HandoffHeader {
+  uint32_t magic;
+  uint32_t tcp_count;
+  uint32_t has_uds;
+};
+
+bool fillAddress(const std::string &path, struct sockaddr_un &addr) {
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path)) {
+		return false;
+	}
+	memcpy(addr.sun_path, path.c_str(), path.size());
+	return true;
+}
+
+void setRecvTimeout(int sock, int timeout_ms) {
+	struct timeval tv;
+	tv.tv_sec = timeout_ms / 1000;
+	tv.tv_usec = (timeout_ms % 1000) * 1000;
+	setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+}  // namespace
+
+HandoffClient::~HandoffClient() {
+	if (sock >= 0) {
+		close(sock);
+	}
+}
+
+bool HandoffClient::Receive(const std::string &path, ListenerSet &listeners) {
+	struct sockaddr_un addr;
+	if (!fillAddress(path, addr)) {
+		LOG_ERROR("handoff path too long: {}", path);
+		return false;
+	}
+	sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock < 0) {
+		return false;
+	}
+	if (connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		close(sock);    // 没有旧进程在等待移交，属于正常启动
+		sock = -1;
+		return false;
+	}
+
+	HandoffHeader header{};
+	int fds[kMaxPassFds];
+	setRecvTimeout(sock, kHandoffTimeoutMs);
+	int n = recvFds(sock, &header, sizeof(header), fds, kMaxPassFds);
+	if (n < 0 || header.magic != kHandoffMagic || header.has_uds > 1
+		|| static_cast<uint32_t>(n) != header.tcp_count + header.has_uds) {
+		LOG_ERROR("handoff from {} failed: bad header or descriptors", path);
+		for (int i = 0; i < n; i++) {
+			close(fds[i]);
+		}
+		close(sock);
+		sock = -1;
+		return false;
+	}
+	listeners.tcp_fds.assign(fds, fds + header.tcp_count);
+	listeners.uds_fd = header.has_uds ? fds[header.tcp_count] : -1;
+	return true;
+}
+
+void HandoffClient::Ready() {
+	if (sock < 0) {
+		return;
+	}
+	(void) !write(sock, &kHandoffAck, 1);
+	close(sock);
+	sock = -1;
+}
+
+bool HandoffServer::Start(const std::string &path, const ListenerSet &listeners, Callback on_handoff) {
+	struct sockaddr_un addr;
+	if (!fillAddress(path, addr)) {
+		LOG_ERROR("handoff path too long: {}", path);
+		return false;
+	}
+	if (listeners.tcp_fds.size() + (listeners.uds_fd >= 0 ? 1 : 0) > static_cast<size_t>(kMaxPassFds)) {
+		LOG_ERROR("handoff: too many listeners");
+		return false;
+	}
+	listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listen_fd < 0) {
+		return false;
+	}
+	unlink(path.c_str());    // 上一个进程的套接字文件（已移交或异常退出）
+	if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd, 1) < 0) {
+		LOG_ERROR("handoff listener bind {} failed: {}", path, strerror(errno));
+		close(listen_fd);
+		listen_fd = -1;
+		return false;
+	}
+	this->path = path;
+	this->listeners = listeners;
+	this->on_handoff = std::move(on_handoff);
+	thread = std::thread([this]() {
+	  while (true) {
+		  int sock = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+		  if (sock < 0) {
+			  if (errno == EINTR || errno == ECONNABORTED) {
+				  continue;
+			  }
+			  return;
+		  }
+		  bool done = Transfer(sock);
+		  close(sock);
+		  if (done) {
+			  handed_off.store(true, std::memory_order_release);
+			  this->on_handoff();
+			  return;
+		  }
+	  }
+	});
+	return true;
+}
+
+/**
+ * @brief 发送监听套接字并等待新进程确认
+ * @return 新进程在超时前确认接管时返回 true
+ */
+bool HandoffServer::Transfer(int sock) {
+	HandoffHeader header{kHandoffMagic, static_cast<uint32_t>(listeners.tcp_fds.size()),
+						 listeners.uds_fd >= 0 ? 1u : 0u};
+	int fds[kMaxPassFds];
+	int count = 0;
+	for (int fd : listeners.tcp_fds) {
+		fds[count++] = fd;
+	}
+	if (listeners.uds_fd >= 0) {
+		fds[count++] = listeners.uds_fd;
+	}
+	if (sendFds(sock, &header, sizeof(header), fds, count) < 0) {
+		LOG_ERROR("handoff: send listeners failed: {}", strerror(errno));
+		return false;
+	}
+	setRecvTimeout(sock, kHandoffTimeoutMs);
+	char ack = 0;
+	ssize_t ret;
+	do {
+		ret = read(sock, &ack, 1);
+	} while (ret < 0 && errno == EINTR);
+	if (ret != 1 || ack != kHandoffAck) {
+		LOG_ERROR("handoff: new process did not take over, keep serving");
+		return false;
+	}
+	return true;
+}
+
+void HandoffServer::Stop() {
+	if (listen_fd < 0) {
+		return;
+	}
+	shutdown(listen_fd, SHUT_RDWR);    // 让阻塞的 accept 返回
+	if (thread.joinable()) {
+		thread.join();
+	}
+	close(listen_fd);
+	listen_fd = -1;
+	if (!HandedOff()) {
+		unlink(path.c_str());    // 已移交时该路径属于新进程
+	}
+}
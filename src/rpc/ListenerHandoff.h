@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file           : ListenerHandoff.h
+  * @author         : xy
+  * @brief          : 新旧进程之间移交监听套接字（SCM_RIGHTS），重启期间监听队列不中断
+  * @attention      : 旧进程在 rpc_handoff_path 上等待；新进程连接后收到监听套接字，开始 accept 并接管注册中心的节点后回复确认，
+  *                   旧进程收到确认才停止 accept 并排空；新进程未确认就断开时旧进程继续服务并等待下一次移交
+  * @date           : 2025/4/10
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_LISTENERHANDOFF_H_
+#define TINYRPC_SRC_RPC_LISTENERHANDOFF_H_
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 移交的监听套接字，TCP 与 UDS 合计不超过 kMaxPassFds
+struct ListenerSet {
+  std::vector<int> tcp_fds;
+  int uds_fd = -1;
+};
+
+// 新进程一侧
+class HandoffClient {
+ public:
+  ~HandoffClient();
+  // path 上没有旧进程时返回 false；成功后 listeners 中的描述符归调用方所有
+  bool Receive(const std::string &path, ListenerSet &listeners);
+  // 已开始 accept 并接管注册中心节点，通知旧进程排空
+  void Ready();
+ private:
+  int sock = -1;
+};
+
+// 旧进程一侧
+class HandoffServer {
+ public:
+  using Callback = std::function<void()>;
+  ~HandoffServer() { Stop(); }
+  // listeners 仍由调用方持有；新进程确认后在后台线程中调用 on_handoff，回调中不能调用 Stop
+  bool Start(const std::string &path, const ListenerSet &listeners, Callback on_handoff);
+  void Stop();
+  bool HandedOff() const { return handed_off.load(std::memory_order_acquire); }
+ private:
+  bool Transfer(int sock);
+ private:
+  int listen_fd = -1;
+  std::string path;
+  ListenerSet listeners;
+  Callback on_handoff;
+  std::atomic<bool> handed_off = false;
+  std::thread thread;
+};
+
+#endif //TINYRPC_SRC_RPC_LISTENERHANDOFF_H_
@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file           : LocalRegistry.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/8
+  ******************************************************************************
+  */
+
+#include <future>
+#include <memory>
+#include <google/protobuf/message.h>
+#include "LocalRegistry.h"
+#include "RpcController.h"
+#include "utils/Config.h"
+#include "utils/Trace.h"
+
+LocalRegistry *LocalRegistry::instance = nullptr;
+
+namespace {
+
+// 一次本地调用，服务方法执行 done 时把结果交回调用方
+struct LocalCall {
+  LocalMethod method;
+  RpcController server_controller;
+  google::protobuf::RpcController *controller = nullptr;
+  RpcController *rpc_controller = nullptr;    // 调用方使用本框架的控制器时才能传递附件
+  google::protobuf::Message *response = nullptr;
+  std::unique_ptr<google::protobuf::Message> own_request;     // 拷贝模式下交给服务方法的对象
+  std::unique_ptr<google::protobuf::Message> own_response;
+  google::protobuf::Closure *done = nullptr;
+  std::promise<void> *finished = nullptr;    // 同步调用时等待
+};
+
+void finishLocalCall(LocalCall *call) {
+	std::unique_ptr<LocalCall> guard(call);
+	if (call->server_controller.Failed()) {
+		call->controller->SetFailed(call->server_controller.ErrorText());
+	} else {
+		if (call->own_response) {
+			// 类型一致时交换即可，否则（如 DynamicMessage）经序列化转换
+			if (call->response->GetReflection() == call->own_response->GetReflection()) {
+				call->response->GetReflection()->Swap(call->response, call->own_response.get());
+			} else if (!call->response->ParseFromString(call->own_response->SerializeAsString())) {
+				call->controller->SetFailed("response parse error");
+			}
+		}
+		if (call->rpc_controller != nullptr) {
+			auto buffer = std::make_shared<const std::string>(call->server_controller.TakeAttachment());
+			call->rpc_controller->SetReceivedAttachment(buffer, *buffer);
+		}
+	}
+	auto done = call->done;
+	auto finished = call->finished;
+	guard.reset();
+	if (done != nullptr) {
+		done->Run();
+	} else {
+		finished->set_value();
+	}
+}
+
+void invokeLocal(LocalCall *call, const google::protobuf::Message *request, google::protobuf::Message *response) {
+	auto done = google::protobuf::NewCallback(&finishLocalCall, call);
+	const auto &method = call->method;
+	if (method.entry != nullptr) {
+		method.entry->invoke(method.skeleton, &call->server_controller, request, response, done);
+	} else {
+		method.service->CallMethod(method.descriptor, &call->server_controller, request, response, done);
+	}
+}
+
+}  // namespace
+
+LocalRegistry *LocalRegistry::getInstance() {
+	static std::once_flag flag;
+	std::call_once(flag, [&] {
+	  instance = new LocalRegistry();
+	  atexit(destroy);
+	});
+	return instance;
+}
+
+void LocalRegistry::destroy() {
+	delete instance;
+	instance = nullptr;
+}
+
+LocalRegistry::LocalRegistry() {
+	auto threads = Config::getInstance()->get("loopback_threads");
+	if (threads != std::nullopt) {
+		worker_num = std::max<size_t>(1, std::stoul(threads.value()));
+	}
+	// 两个开关都可热更新
+	watch_ids[0] = Config::getInstance()->watch("loopback_zero_copy", [this](const std::optional<std::string> &value) {
+	  SetZeroCopy(value == "1");
+	});
+	watch_ids[1] = Config::getInstance()->watch("loopback", [this](const std::optional<std::string> &value) {
+	  if (value == "inline") {
+		  SetMode(LoopbackMode::INLINE);
+	  } else if (value == "worker") {
+		  SetMode(LoopbackMode::WORKER);
+	  } else {
+		  SetMode(LoopbackMode::OFF);
+	  }
+	});
+}
+
+LocalRegistry::~LocalRegistry() {
+	for (auto id : watch_ids) {
+		Config::getInstance()->unwatch(id);
+	}
+	tasks.stop();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+void LocalRegistry::SetMode(LoopbackMode loopback_mode) {
+	if (loopback_mode == LoopbackMode::WORKER) {
+		StartWorkers();
+	}
+	mode.store(loopback_mode, std::memory_order_relaxed);
+}
+
+void LocalRegistry::StartWorkers() {
+	std::call_once(worker_flag, [this]() {
+	  for (size_t i = 0; i < worker_num; i++) {
+		  workers.emplace_back([this]() {
+			std::function<void()> task;
+			while (tasks.pop(task)) {
+				task();
+			}
+		  });
+	  }
+	});
+}
+
+void LocalRegistry::Publish(google::protobuf::Service *service) {
+	auto descriptor = service->GetDescriptor();
+	std::unordered_map<std::string, LocalMethod> methods;
+	for (int i = 0; i < descriptor->method_count(); i++) {
+		auto method = descriptor->method(i);
+		methods[method->name()] = LocalMethod{service, nullptr, method, nullptr, &service->GetRequestPrototype(method),
+											  &service->GetResponsePrototype(method)};
+	}
+	std::unique_lock<std::shared_mutex> lock(mtx);
+	services[descriptor->name()] = std::move(methods);
+}
+
+void LocalRegistry::Publish(RpcSkeleton *service, const google::protobuf::ServiceDescriptor *descriptor) {
+	auto factory = google::protobuf::MessageFactory::generated_factory();
+	const auto &table = service->DispatchTable();
+	std::unordered_map<std::string, LocalMethod> methods;
+	for (size_t i = 0; i < table.method_count; i++) {
+		auto method = descriptor->FindMethodByName(table.methods[i].name);
+		if (method == nullptr) {
+			continue;
+		}
+		methods[method->name()] = LocalMethod{nullptr, service, method, &table.methods[i],
+											  factory->GetPrototype(method->input_type()),
+											  factory->GetPrototype(method->output_type())};
+	}
+	std::unique_lock<std::shared_mutex> lock(mtx);
+	services[descriptor->name()] = std::move(methods);
+}
+
+void LocalRegistry::Unpublish(const std::string &service_name) {
+	std::unique_lock<std::shared_mutex> lock(mtx);
+	services.erase(service_name);
+}
+
+bool LocalRegistry::Find(const std::string &service_name, const std::string &method_name, LocalMethod &method) const {
+	std::shared_lock<std::shared_mutex> lock(mtx);
+	auto service_iter = services.find(service_name);
+	if (service_iter == services.end()) {
+		return false;
+	}
+	auto method_iter = service_iter->second.find(method_name);
+	if (method_iter == service_iter->second.end()) {
+		return false;
+	}
+	method = method_iter->second;
+	return true;
+}
+
+/**
+ * @brief 在本进程中执行调用，服务方法的错误与附件按远程调用的方式交回调用方的 controller
+ * @return 未启用本地调用或方法未在本进程注册时返回 false，由调用方走网络
+ */
+bool LocalRegistry::Call(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
+						 const google::protobuf::Message *request, google::protobuf::Message *response,
+						 google::protobuf::Closure *done) {
+	auto loopback_mode = mode.load(std::memory_order_relaxed);
+	if (loopback_mode == LoopbackMode::OFF) {
+		return false;
+	}
+	auto call = std::make_unique<LocalCall>();
+	if (!Find(method->service()->name(), method->name(), call->method)) {
+		return false;
+	}
+	call->controller = controller;
+	call->rpc_controller = dynamic_cast<RpcController *>(controller);
+	call->response = response;
+	call->done = done;
+
+	// 调用方的对象与服务方法期望的类型一致时可直接交给服务方法，否则拷贝一份
+	const google::protobuf::Message *server_request = request;
+	google::protobuf::Message *server_response = response;
+	bool direct = zero_copy.load(std::memory_order_relaxed)
+		&& request->GetReflection() == call->method.request_prototype->GetReflection()
+		&& response->GetReflection() == call->method.response_prototype->GetReflection();
+	if (!direct) {
+		call->own_request.reset(call->method.request_prototype->New());
+		call->own_request->CopyFrom(*request);
+		call->own_response.reset(call->method.response_prototype->New());
+		server_request = call->own_request.get();
+		server_response = call->own_response.get();
+	}
+	if (call->rpc_controller != nullptr && !call->rpc_controller->Attachment().empty()) {
+		auto buffer = std::make_shared<const std::string>(call->rpc_controller->TakeAttachment());
+		call->server_controller.SetReceivedAttachment(buffer, *buffer);
+	}
+
+	std::promise<void> finished;
+	if (done == nullptr) {
+		call->finished = &finished;
+	}
+	auto raw = call.release();
+	if (loopback_mode == LoopbackMode::WORKER) {
+		// 服务方法中发起的下游调用沿用调用方的追踪上下文
+		bool queued = tasks.push([raw, server_request, server_response, trace = Tracer::current()]() {
+		  TraceScope trace_scope(trace);
+		  invokeLocal(raw, server_request, server_response);
+		});
+		if (!queued) {
+			// 工作线程已停止，在当前线程执行，保证 done 被调用
+			invokeLocal(raw, server_request, server_response);
+		}
+	} else {
+		invokeLocal(raw, server_request, server_response);
+	}
+	if (done == nullptr) {
+		finished.get_future().wait();
+	}
+	return true;
+}
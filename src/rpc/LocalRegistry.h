@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file           : LocalRegistry.h
+  * @author         : xy
+  * @brief          : 进程内的服务注册表，调用方与服务方链接在同一进程时，RpcChannel 直接调用服务而不经过序列化、zk 与网络
+  * @attention      : RpcProvider::NotifyService 注册的服务都会发布到这里，是否走本地调用由配置项 loopback 决定：
+  *                   off（默认）不使用；inline 在调用线程中执行服务方法；worker 投递到 loopback_threads 个工作线程执行；
+  *                   loopback_zero_copy=1 时参数与响应对象直接交给服务方法（类型一致时），否则参数先拷贝一份；
+  *                   本地调用不计入节点统计，也不受超时控制；worker 模式下服务方法中不要发起同步的本地调用，以免工作线程耗尽
+  * @date           : 2025/4/8
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_LOCALREGISTRY_H_
+#define TINYRPC_SRC_RPC_LOCALREGISTRY_H_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/service.h>
+#include "RpcSkeleton.h"
+#include "utils/SafeQueue.h"
+
+enum class LoopbackMode {
+  OFF,
+  INLINE,     // 在调用线程中执行
+  WORKER,     // 在工作线程中执行
+};
+
+// 进程内的一个方法，service 与 skeleton 二选一
+struct LocalMethod {
+  google::protobuf::Service *service = nullptr;
+  RpcSkeleton *skeleton = nullptr;
+  const google::protobuf::MethodDescriptor *descriptor = nullptr;
+  const RpcMethodEntry *entry = nullptr;
+  const google::protobuf::Message *request_prototype = nullptr;     // 用于拷贝参数，并判断调用方的对象能否直接交给服务方法
+  const google::protobuf::Message *response_prototype = nullptr;
+};
+
+class LocalRegistry {
+ public:
+  static LocalRegistry *getInstance();
+  void Publish(google::protobuf::Service *service);
+  void Publish(RpcSkeleton *service, const google::protobuf::ServiceDescriptor *descriptor);
+  void Unpublish(const std::string &service_name);
+  bool Find(const std::string &service_name, const std::string &method_name, LocalMethod &method) const;
+  // 方法已在本进程注册且启用了本地调用时执行并返回 true；done 为 nullptr 时等待服务方法执行 done 后返回
+  bool Call(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
+			const google::protobuf::Message *request, google::protobuf::Message *response,
+			google::protobuf::Closure *done);
+  // 覆盖配置项，测试或程序内指定
+  void SetMode(LoopbackMode mode);
+  void SetZeroCopy(bool enable) { zero_copy.store(enable, std::memory_order_relaxed); }
+ private:
+  LocalRegistry();
+  ~LocalRegistry();
+  static void destroy();
+  void StartWorkers();
+ private:
+  static LocalRegistry *instance;
+  std::atomic<LoopbackMode> mode = LoopbackMode::OFF;
+  std::atomic<bool> zero_copy = false;
+  uint64_t watch_ids[2] = {0, 0};    // 配置项 loopback_zero_copy、loopback
+  mutable std::shared_mutex mtx;
+  std::unordered_map<std::string, std::unordered_map<std::string, LocalMethod>> services;    // 服务名 -> 方法名 -> 方法
+  size_t worker_num = 2;    // 配置项 loopback_threads
+  std::once_flag worker_flag;
+  SafeQueue<std::function<void()>> tasks;
+  std::vector<std::thread> workers;
+};
+
+#endif //TINYRPC_SRC_RPC_LOCALREGISTRY_H_
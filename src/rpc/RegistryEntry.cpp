@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file           : RegistryEntry.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/31
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <set>
+#include <stdexcept>
+#include "RegistryEntry.h"
+
+std::string RegistryEntry::ToString() const {
+	auto result = Address();
+	if (!uds_path.empty()) {
+		result += ";uds=" + uds_path;
+	}
+	if (!shm_path.empty()) {
+		result += ";shm=" + shm_path;
+	}
+	return result;
+}
+
+bool RegistryEntry::Parse(const std::string &data, RegistryEntry &entry) {
+	entry.uds_path.clear();
+	entry.shm_path.clear();
+	auto pos = data.find(';');
+	auto address = data.substr(0, pos);
+	while (pos != std::string::npos) {
+		auto next = data.find(';', pos + 1);
+		auto field = data.substr(pos + 1, next == std::string::npos ? std::string::npos : next - pos - 1);
+		if (field.rfind("uds=", 0) == 0) {
+			entry.uds_path = field.substr(4);
+		} else if (field.rfind("shm=", 0) == 0) {
+			entry.shm_path = field.substr(4);
+		}
+		pos = next;
+	}
+
+	auto idx = address.find_last_of(':');
+	if (idx == std::string::npos || idx == 0 || idx + 1 == address.size()) {
+		return false;
+	}
+	entry.ip = address.substr(0, idx);
+	try {
+		entry.port = std::stoi(address.substr(idx + 1));
+	} catch (const std::exception &) {
+		return false;
+	}
+	return entry.port > 0 && entry.port <= 65535;
+}
+
+/**
+ * @brief 本机网卡上的 IPv4 地址，只在首次调用时读取
+ */
+static std::set<std::string> localAddresses() {
+	std::set<std::string> result;
+	struct ifaddrs *list = nullptr;
+	if (getifaddrs(&list) != 0) {
+		return result;
+	}
+	for (auto ifa = list; ifa != nullptr; ifa = ifa->ifa_next) {
+		if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_INET) {
+			continue;
+		}
+		char buf[INET_ADDRSTRLEN];
+		auto addr = &reinterpret_cast<struct sockaddr_in *>(ifa->ifa_addr)->sin_addr;
+		if (inet_ntop(AF_INET, addr, buf, sizeof(buf)) != nullptr) {
+			result.insert(buf);
+		}
+	}
+	freeifaddrs(list);
+	return result;
+}
+
+bool isLocalAddress(const std::string &ip) {
+	if (ip.rfind("127.", 0) == 0 || ip == "localhost") {
+		return true;
+	}
+	static const std::set<std::string> local = localAddresses();
+	return local.count(ip) != 0;
+}
@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************
+  * @file           : RegistryEntry.h
+  * @author         : xy
+  * @brief          : zk 方法节点中记录的服务端地址
+  * @attention      : 格式为 ip:port，服务端开启 UDS / 共享内存时追加 ;uds=<路径> / ;shm=<握手套接字路径>，
+  *                   旧格式的节点仍可解析，未知的字段忽略
+  * @date           : 2025/3/31
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_REGISTRYENTRY_H_
+#define TINYRPC_SRC_RPC_REGISTRYENTRY_H_
+
+#include <string>
+
+struct RegistryEntry {
+  std::string ip;
+  int port = 0;
+  std::string uds_path;    // 为空表示未开启 UDS
+  std::string shm_path;    // 为空表示未开启共享内存传输
+
+  std::string Address() const { return ip + ":" + std::to_string(port); }
+  std::string ToString() const;
+  static bool Parse(const std::string &data, RegistryEntry &entry);
+};
+
+// ip 是否为本机地址（回环地址或本机网卡上的地址）
+bool isLocalAddress(const std::string &ip);
+
+#endif //TINYRPC_SRC_RPC_REGISTRYENTRY_H_
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file           : RequestCoalescer.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/12
+  ******************************************************************************
+  */
+
+#include "RequestCoalescer.h"
+#include "RpcErrorCode.h"
+
+std::string RequestCoalescer::makeKey(std::string_view service_name, std::string_view method_name,
+									  std::string_view args) {
+	std::string key;
+	key.reserve(service_name.size() + method_name.size() + args.size() + 2);
+	key.append(service_name).append(1, '\0').append(method_name).append(1, '\0').append(args);
+	return key;
+}
+
+CoalescedResult RequestCoalescer::makeResult(const RpcController &controller,
+											 const google::protobuf::Message &response) {
+	CoalescedResult result;
+	if (controller.Failed()) {
+		result.error_code = RPC_ERR_FAILED;
+		result.error_text = controller.ErrorText();
+		return result;
+	}
+	result.body = response.SerializeAsString();
+	result.attachment = controller.Attachment();
+	return result;
+}
+
+bool RequestCoalescer::Join(const std::string &key, Waiter waiter) {
+	std::lock_guard<std::mutex> lock(mtx);
+	auto iter = flights.find(key);
+	if (iter == flights.end()) {
+		flights.emplace(key, std::vector<Waiter>());
+		return true;
+	}
+	iter->second.push_back(std::move(waiter));
+	return false;
+}
+
+size_t RequestCoalescer::Finish(const std::string &key, const CoalescedResult &result) {
+	std::vector<Waiter> waiters;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		auto iter = flights.find(key);
+		if (iter == flights.end()) {
+			return 0;
+		}
+		waiters.swap(iter->second);
+		flights.erase(iter);
+	}
+	for (auto &waiter : waiters) {
+		waiter(result);
+	}
+	return waiters.size();
+}
+
+size_t RequestCoalescer::FlightNum() {
+	std::lock_guard<std::mutex> lock(mtx);
+	return flights.size();
+}
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file           : RequestCoalescer.h
+  * @author         : xy
+  * @brief          : 合并相同的进行中请求（singleflight）
+  * @attention      : 第一个请求（leader）执行业务方法，执行期间到达的相同请求只登记等待者，
+  *                   leader 完成后把序列化好的响应交给全部等待者；Finish 之后到达的请求成为新的 leader；线程安全
+  * @date           : 2025/4/12
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_REQUESTCOALESCER_H_
+#define TINYRPC_SRC_RPC_REQUESTCOALESCER_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/message.h>
+#include "RpcController.h"
+
+// 只对参数不超过该长度的请求合并，键中保存完整的参数字节，避免哈希冲突导致返回错误的响应
+constexpr size_t kMaxCoalesceArgs = 64 * 1024;
+
+// leader 的执行结果，body 为序列化后的响应消息
+struct CoalescedResult {
+  int error_code = 0;
+  std::string error_text;
+  std::string body;
+  std::string attachment;
+};
+
+class RequestCoalescer {
+ public:
+  using Waiter = std::function<void(const CoalescedResult &result)>;
+  // 键：服务名、方法名与参数字节
+  static std::string makeKey(std::string_view service_name, std::string_view method_name, std::string_view args);
+  // leader 的业务方法执行完成后的结果：调用了 SetFailed 时为 RPC_ERR_FAILED 与错误文本，否则序列化响应并带上附件
+  static CoalescedResult makeResult(const RpcController &controller, const google::protobuf::Message &response);
+  // 没有相同的进行中请求时返回 true，调用方作为 leader 执行并在完成后调用 Finish；否则登记 waiter 并返回 false
+  bool Join(const std::string &key, Waiter waiter);
+  // 在调用线程中依次执行全部等待者，返回等待者个数
+  size_t Finish(const std::string &key, const CoalescedResult &result);
+  size_t FlightNum();
+ private:
+  std::mutex mtx;
+  std::unordered_map<std::string, std::vector<Waiter>> flights;    // 键 -> 等待者（不含 leader）
+};
+
+#endif //TINYRPC_SRC_RPC_REQUESTCOALESCER_H_
@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file           : ResponseCache.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/13
+  ******************************************************************************
+  */
+
+#include "ResponseCache.h"
+#include "RpcErrorCode.h"
+#include "utils/Clock.h"
+
+namespace {
+
+constexpr size_t kSlotOverhead = 64;    // 每个条目除键与响应外的大致开销，计入预算
+
+uint64_t nowMs() {
+	return nowNs() / 1000000;
+}
+
+}  // namespace
+
+ResponseCache::Body ResponseCache::Get(const std::string &key) {
+	auto &shard = ShardOf(key);
+	std::lock_guard<std::mutex> lock(shard.mtx);
+	auto iter = shard.index.find(key);
+	if (iter == shard.index.end()) {
+		return nullptr;
+	}
+	auto &slot = shard.slots[iter->second];
+	if (slot.expire_ms <= nowMs()) {
+		Evict(shard, iter->second);
+		return nullptr;
+	}
+	slot.referenced = true;
+	return slot.body;
+}
+
+void ResponseCache::Put(const std::string &key, std::string body, uint32_t ttl_ms) {
+	size_t charge = key.size() + body.size() + kSlotOverhead;
+	size_t capacity = shard_capacity.load(std::memory_order_relaxed);
+	if (ttl_ms == 0 || charge > capacity) {
+		return;
+	}
+	auto value = std::make_shared<const std::string>(std::move(body));
+	auto now_ms = nowMs();
+	auto &shard = ShardOf(key);
+	std::lock_guard<std::mutex> lock(shard.mtx);
+	auto iter = shard.index.find(key);
+	if (iter != shard.index.end()) {
+		Evict(shard, iter->second);
+	}
+	EvictUntil(shard, capacity - charge, now_ms);
+
+	size_t index;
+	if (!shard.free_slots.empty()) {
+		index = shard.free_slots.back();
+		shard.free_slots.pop_back();
+	} else {
+		index = shard.slots.size();
+		shard.slots.emplace_back();
+	}
+	auto &slot = shard.slots[index];
+	slot.key = key;
+	slot.body = std::move(value);
+	slot.expire_ms = now_ms + ttl_ms;
+	slot.charge = charge;
+	slot.used = true;
+	slot.referenced = false;    // 新条目需要再被访问一次才能躲过下一轮淘汰，只访问一次的键不会挤掉热点
+	shard.index.emplace(key, index);
+	shard.bytes += charge;
+}
+
+bool ResponseCache::Store(const std::string &key, const CoalescedResult &result, uint32_t ttl_ms) {
+	if (result.error_code != RPC_OK || !result.attachment.empty()) {
+		return false;
+	}
+	Put(key, result.body, ttl_ms);
+	return true;
+}
+
+void ResponseCache::SetCapacity(size_t capacity_bytes) {
+	size_t capacity = capacity_bytes / kCacheShards;
+	shard_capacity.store(capacity, std::memory_order_relaxed);
+	auto now_ms = nowMs();
+	for (auto &shard : shards) {
+		std::lock_guard<std::mutex> lock(shard.mtx);
+		EvictUntil(shard, capacity, now_ms);
+	}
+}
+
+size_t ResponseCache::Bytes() const {
+	size_t bytes = 0;
+	for (const auto &shard : shards) {
+		std::lock_guard<std::mutex> lock(shard.mtx);
+		bytes += shard.bytes;
+	}
+	return bytes;
+}
+
+size_t ResponseCache::Size() const {
+	size_t size = 0;
+	for (const auto &shard : shards) {
+		std::lock_guard<std::mutex> lock(shard.mtx);
+		size += shard.index.size();
+	}
+	return size;
+}
+
+void ResponseCache::Evict(Shard &shard, size_t slot) {
+	auto &victim = shard.slots[slot];
+	shard.index.erase(victim.key);
+	shard.bytes -= victim.charge;
+	victim = Slot();
+	shard.free_slots.push_back(slot);
+}
+
+/**
+ * @brief 已过期或自上次经过后未被访问的条目被淘汰，被访问过的清除标记后留到下一轮
+ * @attention 占用不为 0 时至少有一个条目，指针最多转两圈
+ */
+void ResponseCache::EvictUntil(Shard &shard, size_t limit, uint64_t now_ms) {
+	while (shard.bytes > limit) {
+		auto slot = shard.hand;
+		shard.hand = (shard.hand + 1) % shard.slots.size();
+		auto &entry = shard.slots[slot];
+		if (!entry.used) {
+			continue;
+		}
+		if (entry.referenced && entry.expire_ms > now_ms) {
+			entry.referenced = false;
+			continue;
+		}
+		Evict(shard, slot);
+	}
+}
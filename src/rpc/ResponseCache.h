@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file           : ResponseCache.h
+  * @author         : xy
+  * @brief          : 服务端响应缓存，保存序列化好的响应，命中时跳过参数解析、业务方法与响应序列化
+  * @attention      : 键与合并请求相同（服务名、方法名与参数字节），按哈希分到 kCacheShards 个分片，每个分片一把锁；
+  *                   每个分片的容量为总字节预算的 1/kCacheShards，超出时按 CLOCK（二次机会）淘汰，过期的条目优先淘汰；
+  *                   只用于标记了 (tinyrpc.cache_ttl_ms) 的方法，即响应只取决于参数的方法；线程安全
+  * @date           : 2025/4/13
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RESPONSECACHE_H_
+#define TINYRPC_SRC_RPC_RESPONSECACHE_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RequestCoalescer.h"
+
+constexpr size_t kCacheShards = 16;
+// 只缓存参数不超过该长度的请求，键中保存完整的参数字节，避免哈希冲突导致返回错误的响应
+constexpr size_t kMaxCacheArgs = 64 * 1024;
+
+class ResponseCache {
+ public:
+  using Body = std::shared_ptr<const std::string>;
+  explicit ResponseCache(size_t capacity_bytes = 0) { SetCapacity(capacity_bytes); }
+  // 未命中或已过期时返回 nullptr；返回的响应在锁外使用，不会被并发的淘汰释放
+  Body Get(const std::string &key);
+  // 超过分片容量的响应不缓存；已存在时替换
+  void Put(const std::string &key, std::string body, uint32_t ttl_ms);
+  // 业务方法执行完成后写入：失败（SetFailed）或带附件的结果不缓存，返回是否写入
+  bool Store(const std::string &key, const CoalescedResult &result, uint32_t ttl_ms);
+  // 总字节预算，缩小时立即淘汰；0 表示不缓存
+  void SetCapacity(size_t capacity_bytes);
+  size_t Bytes() const;
+  size_t Size() const;
+ private:
+  struct Slot {
+	std::string key;
+	Body body;
+	uint64_t expire_ms = 0;
+	size_t charge = 0;
+	bool used = false;
+	bool referenced = false;    // 上次经过时钟指针后被访问过
+  };
+  struct alignas(64) Shard {
+	mutable std::mutex mtx;
+	std::unordered_map<std::string, size_t> index;    // 键 -> slots 下标
+	std::vector<Slot> slots;
+	std::vector<size_t> free_slots;
+	size_t hand = 0;
+	size_t bytes = 0;
+  };
+  Shard &ShardOf(const std::string &key) { return shards[std::hash<std::string>()(key) % kCacheShards]; }
+  static void Evict(Shard &shard, size_t slot);
+  // 转动时钟指针，直到分片占用不超过 limit
+  static void EvictUntil(Shard &shard, size_t limit, uint64_t now_ms);
+ private:
+  std::array<Shard, kCacheShards> shards;
+  std::atomic<size_t> shard_capacity = 0;
+};
+
+#endif //TINYRPC_SRC_RPC_RESPONSECACHE_H_
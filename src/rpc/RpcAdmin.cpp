@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file           : RpcAdmin.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/26
+  ******************************************************************************
+  */
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include "RpcAdmin.h"
+#include "RpcProvider.h"
+#include "utils/Log.h"
+#include "utils/Profiler.h"
+
+namespace {
+
+// 整数查询参数，非数字或越界时返回 false
+bool parseParam(const std::string &text, long &value) {
+	if (text.empty()) {
+		return false;
+	}
+	char *end = nullptr;
+	errno = 0;
+	value = std::strtol(text.c_str(), &end, 10);
+	return errno == 0 && *end == '\0';
+}
+
+}  // namespace
+
+RpcAdmin::RpcAdmin(RpcProvider *provider) : provider(provider) {
+	RegisterRoutes();
+}
+
+RpcAdmin::~RpcAdmin() {
+	if (http_server) {
+		http_server->stop();
+	}
+}
+
+bool RpcAdmin::Start(const std::string &ip, int port) {
+	http_server = std::make_unique<hv::HttpServer>(&router);
+	http_server->setHost(ip.c_str());
+	http_server->setPort(port);
+	http_server->setThreadNum(1);
+	if (http_server->start() != 0) {
+		LOG_ERROR("admin server start failed, port {}", port);
+		http_server.reset();
+		return false;
+	}
+	LOG_INFO("admin server start at {}:{}", ip, port);
+	return true;
+}
+
+void RpcAdmin::RegisterRoutes() {
+	router.GET("/metrics", [this](HttpRequest *req, HttpResponse *resp) {
+	  auto metrics = provider->CollectMetrics();
+	  std::ostringstream oss;
+	  oss << renderPrometheus(metrics);
+	  oss << "# TYPE tinyrpc_connections gauge\n";
+	  oss << "tinyrpc_connections " << provider->ConnectionNum() << "\n";
+	  oss << "# TYPE tinyrpc_inflight_calls gauge\n";
+	  oss << "tinyrpc_inflight_calls " << provider->InflightNum() << "\n";
+	  oss << "# TYPE tinyrpc_response_cache_bytes gauge\n";
+	  oss << "tinyrpc_response_cache_bytes " << provider->ResponseCacheBytes() << "\n";
+	  oss << "# TYPE tinyrpc_log_queue_depth gauge\n";
+	  oss << "tinyrpc_log_queue_depth " << Logger::getInstance()->queueSize() << "\n";
+	  oss << "# TYPE tinyrpc_log_dropped_total counter\n";
+	  oss << "tinyrpc_log_dropped_total " << Logger::getInstance()->droppedCount() << "\n";
+	  return resp->String(oss.str());
+	});
+
+	router.GET("/methods", [this](HttpRequest *req, HttpResponse *resp) {
+	  return resp->String(renderLatencyTable(provider->CollectMetrics()));
+	});
+
+	router.GET("/status", [this](HttpRequest *req, HttpResponse *resp) {
+	  return resp->String(StatusText());
+	});
+
+	// 采样最长阻塞 300 秒：异步处理函数在 libhv 的全局线程池中执行，采样期间 /metrics、/status 仍可访问
+	router.GET("/profile", [](const HttpRequestPtr &req, const HttpResponseWriterPtr &writer) {
+	  long seconds = 0;
+	  long hz = 0;
+	  if (!parseParam(req->GetParam("seconds", "10"), seconds) || !parseParam(req->GetParam("hz", "99"), hz)
+		  || seconds <= 0 || seconds > 300 || hz <= 0 || hz > 1000) {
+		  writer->response->status_code = HTTP_STATUS_BAD_REQUEST;
+		  writer->End("seconds must be in (0, 300], hz in (0, 1000]\n");
+		  return;
+	  }
+	  auto result = CpuProfiler::profile(static_cast<int>(seconds), static_cast<int>(hz));
+	  if (result == std::nullopt) {
+		  writer->response->status_code = HTTP_STATUS_CONFLICT;
+		  writer->End("another profile is running\n");
+		  return;
+	  }
+	  writer->End(result.value());
+	});
+}
+
+std::string RpcAdmin::StatusText() const {
+	std::ostringstream oss;
+	oss << "address: " << provider->Address() << "\n";
+	oss << "connections: " << provider->ConnectionNum() << "\n";
+	oss << "inflight_calls: " << provider->InflightNum() << "\n";
+	oss << "draining: " << (provider->Draining() ? "yes" : "no") << "\n";
+	oss << "response_cache: " << provider->ResponseCacheSize() << " entries, " << provider->ResponseCacheBytes()
+		<< " bytes\n";
+	oss << "log_queue_depth: " << Logger::getInstance()->queueSize() << "\n";
+	oss << "log_dropped: " << Logger::getInstance()->droppedCount() << "\n";
+	oss << "services:\n";
+	for (const auto &service : provider->ServiceList()) {
+		oss << "  " << service.first << "\n";
+		for (const auto &method : service.second) {
+			oss << "    " << method << "\n";
+		}
+	}
+	return oss.str();
+}
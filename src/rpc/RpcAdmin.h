@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file           : RpcAdmin.h
+  * @author         : xy
+  * @brief          : 服务端管理端口（HTTP），输出监控指标与运行状态
+  * @attention      : 配置了 admin_port 时由 RpcProvider::Run 启动
+  *                   /metrics  Prometheus 文本格式
+  *                   /methods  各方法各阶段耗时分位数
+  *                   /status   连接数、在途请求、队列深度、已注册服务
+  *                   /profile  按需 CPU 采样，参数 seconds（默认 10）、hz（默认 99）
+  * @date           : 2025/3/26
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCADMIN_H_
+#define TINYRPC_SRC_RPC_RPCADMIN_H_
+
+#include <memory>
+#include <string>
+#include <hv/HttpServer.h>
+
+class RpcProvider;
+
+class RpcAdmin {
+ public:
+  explicit RpcAdmin(RpcProvider *provider);
+  ~RpcAdmin();
+  bool Start(const std::string &ip, int port);
+ private:
+  void RegisterRoutes();
+  std::string StatusText() const;
+ private:
+  RpcProvider *provider;
+  hv::HttpService router;
+  std::unique_ptr<hv::HttpServer> http_server;
+};
+
+#endif //TINYRPC_SRC_RPC_RPCADMIN_H_
@@ -8,19 +8,64 @@
   ******************************************************************************
   */
 
-#include <hv/TcpClient.h>
+#include <future>
 #include "RpcChannel.h"
+#include "Endpoint.h"
+#include "LocalRegistry.h"
+#include "RpcController.h"
+#include "RpcErrorCode.h"
+#include "utils/Chunk.h"
+#include "utils/Clock.h"
+#include "utils/Compress.h"
 #include "utils/Config.h"
+#include "utils/Trace.h"
 #include "proto/rpc_header.pb.h"
 #include "utils/HvProtocol.h"
-#include "utils/Zookeeper.h"
 
+constexpr int kDefaultRpcTimeoutMs = 3000;
+
+static int rpcTimeoutMs() {
+	static const auto &timeout_ms = Config::getInstance()->bindInt("rpc_timeout_ms", kDefaultRpcTimeoutMs);
+	return static_cast<int>(timeout_ms.get());
+}
+
+static uint64_t nextCallId() {
+	static std::atomic<uint64_t> call_id = 0;
+	return call_id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+static CallResult toCallResult(int error_code) {
+	switch (error_code) {
+		case RPC_OK: return CallResult::OK;
+		case RPC_ERR_FAILED: return CallResult::OK;    // 业务失败说明节点正常工作，不计入摘除判断
+		case RPC_ERR_TIMEOUT: return CallResult::TIMEOUT;
+		case RPC_ERR_CONNECT: return CallResult::CONNECT_FAILED;
+		default: return CallResult::ERROR;
+	}
+}
+
+/**
+ * @brief 发起 RPC 调用
+ * @attention done 为 nullptr 时同步等待响应；否则立即返回，完成后在客户端 IO 线程中执行 done；
+ *            在客户端 IO 线程中（如另一个调用的 done 里）发起同步调用时直接失败，等待响应会使该线程死锁
+ */
 void RpcChannel::CallMethod(const google::protobuf::MethodDescriptor *method,
 							google::protobuf::RpcController *controller,
 							const google::protobuf::Message *request,
 							google::protobuf::Message *response,
 							google::protobuf::Closure *done) {
 
+	// 同一进程中注册的服务直接调用（配置项 loopback）
+	if (LocalRegistry::getInstance()->Call(method, controller, request, response, done)) {
+		return;
+	}
+
+	// 响应由客户端 IO 线程交付，在该线程中同步等待永远等不到
+	if (done == nullptr && EndpointManager::getInstance()->Loop()->isInLoopThread()) {
+		controller->SetFailed("synchronous call on client IO thread");
+		return;
+	}
+
 	tinyrpc::RpcHeader rpc_header;
 	auto service = method->service();
 
@@ -30,83 +75,185 @@ void RpcChannel::CallMethod(const google::protobuf::MethodDescriptor *method,
 	request->SerializeToString(&args_str);
 	uint32_t args_len = args_str.size();
 
+	auto call_id = nextCallId();
 	rpc_header.set_service_name(service_name);
 	rpc_header.set_method_name(method_name);
 	rpc_header.set_args_len(args_len);
+	rpc_header.set_call_id(call_id);
+
+	// 追踪：在服务端处理函数中发起的调用沿用当前上下文，否则新建根上下文
+	auto parent = Tracer::current();
+	auto trace = parent.valid() ? Tracer::newChild(parent) : Tracer::getInstance()->newRoot();
+	rpc_header.set_trace_id(trace.trace_id);
+	rpc_header.set_span_id(trace.span_id);
+	rpc_header.set_trace_flags(trace.flags);
+
+	// 附件放在消息体之后、不压缩，只有本框架的 RpcController 能携带
+	auto rpc_controller = dynamic_cast<RpcController *>(controller);
+	std::string attachment;
+	if (rpc_controller != nullptr) {
+		attachment = rpc_controller->TakeAttachment();
+		rpc_header.set_attachment_size(attachment.size());
+	}
 
 	// rpc_header 序列化
 	std::string rpc_header_str;
 	auto ret = rpc_header.SerializeToString(&rpc_header_str);
 	if (!ret) {
 		controller->SetFailed("rpc_header serialize error");
+		if (done != nullptr) {
+			done->Run();
+		}
 		return;
 	}
 
-	auto send_str = HvProtocol::packMessageAsString(rpc_header_str);    // 打包成协议格式 头部 4字节+内容
-
-	auto new_send_str = HvProtocol::packMessageAsString(send_str + args_str);    // 打包成协议格式 头部 4字节+内容
+	// 服务发现（带缓存）
+	std::string error;
+	auto endpoint = EndpointManager::getInstance()->Resolve(service_name, method_name, error);
+	if (!endpoint) {
+		controller->SetFailed(error);
+		if (done != nullptr) {
+			done->Run();
+		}
+		return;
+	}
 
+	// 参数足够大且对端声明支持时才压缩，args_len 仍为压缩前的长度
+	FrameHead frame_head;
+	frame_head.type = FRAME_REQUEST;
+	frame_head.flags = HvProtocol::defaultFlags() | FRAME_FLAG_CHUNK;
+	frame_head.accept = kSupportedCompress;
+	auto peer_accept = endpoint->Connection().PeerAccept();
+	if (peer_accept != 0 && args_str.size() >= Compress::threshold()) {
+		auto type = Compress::methodType(service_name + "." + method_name);
+		std::string compressed;
+		if (Compress::accepted(peer_accept, type) && Compress::compress(type, args_str, compressed)
+			&& compressed.size() < args_str.size()) {
+			frame_head.compress = type;
+			args_str.swap(compressed);
+		}
+	}
 
-	std::string zoo_str = "/" + service_name + "/" + method_name;
+	auto send_str = HvProtocol::packMessageAsString(rpc_header_str);    // 打包成协议格式 头部 4字节+内容
 
-	//ZkClient
-	Zookeeper zk = Zookeeper();
-	zk.start();
-	auto ip_port = zk.getData(zoo_str);
-	std::cout << "ip_port = " << ip_port << std::endl;
+	// 帧头 8字节+内容；附件作为单独的一段，发送时不拷贝进帧
+	FrameParts frame;
+	frame.prefix.reserve(FRAME_HEAD_LENGTH + send_str.size() + args_str.size());
+	frame.prefix.assign(FRAME_HEAD_LENGTH, '\0');
+	frame.prefix.append(send_str).append(args_str);
+	frame.attachment = std::move(attachment);
+	HvProtocol::finishFrame(frame_head, frame);
+	auto frame_size = frame.size();
+	if (frame_size > maxMessageSize()) {
+		controller->SetFailed("request too large: " + std::to_string(frame_size) + " bytes");
+		if (done != nullptr) {
+			done->Run();
+		}
+		return;
+	}
 
-	if (ip_port.empty()) {
-		controller->SetFailed("get data from zk failed");
+	// 检查节点是否被摘除；摘除到期后放行的探测请求必须执行到 OnFinish，因此放在所有提前返回之后
+	auto &stats = endpoint->Stats();
+	if (!stats.Available(nowNs())) {
+		controller->SetFailed("endpoint ejected: " + endpoint->Address());
+		if (done != nullptr) {
+			done->Run();
+		}
 		return;
 	}
+	stats.OnStart();
+	auto start_ns = nowNs();
+	auto full_name = service_name + "." + method_name;
+	auto start_us = trace.sampled() ? Tracer::nowUs() : 0;
 
-	int idx = ip_port.find_first_of(':');
-	std::string rpc_ip = ip_port.substr(0, idx);
-	uint16_t rpc_port = std::stoi(ip_port.substr(idx + 1, ip_port.size() - 1 - idx));
+	std::shared_ptr<std::promise<void>> finished;
+	if (done == nullptr) {
+		finished = std::make_shared<std::promise<void>>();
+	}
 
-	std::cout << "rpc_ip = " << rpc_ip << " rpc_port = " << rpc_port << std::endl;
+	auto callback = [&stats, start_ns, start_us, full_name, trace, parent, method, controller, rpc_controller,
+					 response, done, finished](int error_code, const std::string &error_text, const std::string &body,
+											   ResponseAttachment attachment) {
+	  if (error_code == RPC_OK && !response->ParseFromString(body)) {
+		  error_code = RPC_ERR_BAD_RESPONSE;
+	  }
+	  if (error_code == RPC_OK && rpc_controller != nullptr) {
+		  rpc_controller->SetReceivedAttachment(std::move(attachment.buffer), attachment.data);
+	  }
+	  if (error_code != RPC_OK) {
+		  controller->SetFailed(error_code == RPC_ERR_BAD_RESPONSE ? "response parse error" : error_text);
+	  }
+	  auto now = nowNs();
+	  stats.OnFinish(full_name, now - start_ns, toCallResult(error_code), now);
 
-	hv::TcpClient tcp_client;
-	auto conn_fd = tcp_client.createsocket(rpc_port, rpc_ip.c_str());
-	if (conn_fd < 0) {
-		controller->SetFailed("connect error");
-		return;
-	}
+	  if (trace.sampled()) {
+		  SpanRecord span;
+		  span.trace_id = trace.trace_id;
+		  span.span_id = trace.span_id;
+		  span.parent_span_id = parent.valid() ? parent.span_id : 0;
+		  span.start_us = start_us;
+		  span.duration_ns = now - start_ns;
+		  span.status = error_code;
+		  span.kind = SpanKind::CLIENT;
+		  span.setName(method->full_name());
+		  Tracer::getInstance()->submit(span);
+	  }
 
-	auto *server_unpack_setting = new unpack_setting_t();
-	memset(server_unpack_setting, 0, sizeof(unpack_setting_t));
-	server_unpack_setting->mode = UNPACK_BY_LENGTH_FIELD;
-	server_unpack_setting->package_max_length = DEFAULT_PACKAGE_MAX_LENGTH;
-	server_unpack_setting->body_offset = SERVER_HEAD_LENGTH;
-	server_unpack_setting->length_field_offset = SERVER_HEAD_LENGTH_FIELD_OFFSET;
-	server_unpack_setting->length_field_bytes = SERVER_HEAD_LENGTH_FIELD_BYTES;
-	server_unpack_setting->length_field_coding = ENCODE_BY_BIG_ENDIAN;
-	tcp_client.setUnpack(server_unpack_setting);
-
-	tcp_client.onConnection = [new_send_str](const auto &channel) {
-	  if (channel->isConnected()) {
-		  std::string peerAddr = channel->peeraddr();
-		  printf("connected to %s! conn_fd=%d\n", peerAddr.c_str(), channel->fd());
-		  channel->write(new_send_str);
+	  if (done != nullptr) {
+		  done->Run();
 	  } else {
-		  printf("connect failed\n");
+		  finished->set_value();
 	  }
 	};
+	auto timeout_ms = rpc_controller != nullptr && rpc_controller->Timeout() > 0 ? rpc_controller->Timeout() : rpcTimeoutMs();
+	auto &transport = endpoint->Connection(frame_size);
+	if (frame.attachment.empty()) {
+		frame.prefix.append(frame.suffix);    // 没有附件时按一个完整的帧发送
+		transport.Send(call_id, std::move(frame.prefix), timeout_ms, std::move(callback));
+	} else {
+		transport.Send(call_id, std::move(frame), timeout_ms, std::move(callback));
+	}
 
-	tcp_client.onMessage = [response](const auto &channel, const auto &buf) {
-
-	  std::cout << "client onMessage" << std::endl;
-
-	  std::string data = std::string((char *)buf->data(), buf->size());
+	if (finished) {
+		finished->get_future().wait();
+	}
+}
 
-	  std::string actual_data;
-	  auto len = HvProtocol::unpackMessage(data, actual_data);
+/**
+ * @brief 打开流：STREAM_OPEN 携带本端接收窗口和 RpcHeader，服务端回复 STREAM_WINDOW 后才能发送消息
+ */
+ClientStreamPtr RpcChannel::OpenStream(const google::protobuf::MethodDescriptor *method, std::string *error) {
+	auto service_name = method->service()->name();
+	auto method_name = method->name();
+	auto stream_id = nextCallId();
 
-	  std::cout << actual_data << std::endl;
-	  response->ParseFromArray(actual_data.c_str(), len);
-	};
+	tinyrpc::RpcHeader rpc_header;
+	rpc_header.set_service_name(service_name);
+	rpc_header.set_method_name(method_name);
+	rpc_header.set_call_id(stream_id);
+	auto parent = Tracer::current();
+	auto trace = parent.valid() ? Tracer::newChild(parent) : Tracer::getInstance()->newRoot();
+	rpc_header.set_trace_id(trace.trace_id);
+	rpc_header.set_span_id(trace.span_id);
+	rpc_header.set_trace_flags(trace.flags);
 
-	tcp_client.start();
+	std::string resolve_error;
+	auto endpoint = EndpointManager::getInstance()->Resolve(service_name, method_name, resolve_error);
+	// 流不计入调用统计，不能作为探测请求，摘除到期后直接放行
+	if (!endpoint || endpoint->Stats().Ejected(nowNs())) {
+		if (error != nullptr) {
+			*error = endpoint ? "endpoint ejected: " + endpoint->Address() : resolve_error;
+		}
+		return nullptr;
+	}
 
-	while (getchar() != '\n');
-}
\ No newline at end of file
+	// 流持有节点的引用，节点在流结束前不会被释放
+	auto stream = std::make_shared<ClientStream>(stream_id, [endpoint](const std::string &frame) {
+	  endpoint->StreamConnection().SendFrame(frame);
+	}, streamWindow());
+	stream->on_close = [endpoint, stream_id]() { endpoint->StreamConnection().CloseStream(stream_id); };
+	auto window = static_cast<uint32_t>(streamWindow());
+	endpoint->StreamConnection().OpenStream(
+		stream, packStreamFrame(stream_id, STREAM_OPEN, packStreamOpen(window, rpc_header.SerializeAsString())));
+	return stream;
+}
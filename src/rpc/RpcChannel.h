@@ -3,7 +3,10 @@
   * @file           : RpcChannel.h
   * @author         : xy
   * @brief          : 客户端使用
-  * @attention      : None
+  * @attention      : 节点发现、连接与统计由 EndpointManager 持有，RpcChannel 本身无状态；
+  *                   异步调用的 done 在客户端 IO 线程（共享内存传输时为其读线程）中执行，不要在其中发起同步调用，
+  *                   在客户端 IO 线程中发起的同步调用直接失败；
+  *                   调用本进程注册的服务（配置项 loopback 开启时）不经过网络，done 在服务方法执行 done 的线程中执行
   * @date           : 2025/3/21
   ******************************************************************************
   */
@@ -13,6 +16,8 @@
 
 #include<google/protobuf/service.h>
 #include<google/protobuf/descriptor.h>
+#include <string>
+#include "RpcStream.h"
 
 
 class RpcChannel : public google::protobuf::RpcChannel{
@@ -20,6 +25,8 @@ class RpcChannel : public google::protobuf::RpcChannel{
   void CallMethod(const google::protobuf::MethodDescriptor* method,
 				  google::protobuf::RpcController* controller, const google::protobuf::Message* request,
 				  google::protobuf::Message* response, google::protobuf::Closure* done);
+  // 打开流式方法（服务端以 NotifyStream 注册），失败时返回 nullptr 并写入 error
+  ClientStreamPtr OpenStream(const google::protobuf::MethodDescriptor* method, std::string* error = nullptr);
 };
 
 #endif //TINYRPC_SRC_RPC_RPCCHANNEL_H_
@@ -0,0 +1,520 @@
+/**
+  ******************************************************************************
+  * @file           : RpcConnection.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#include "RpcConnection.h"
+#include "RpcErrorCode.h"
+#include "utils/Compress.h"
+#include "utils/Config.h"
+#include "utils/HvProtocol.h"
+#include "utils/Log.h"
+#include "proto/rpc_header.pb.h"
+
+struct BatchOptions {
+  int window_ms = 0;              // 0 表示只合并同一轮事件循环中的请求，-1 表示不合并
+  size_t max_bytes = 64 * 1024;   // 待发送数据达到该长度时立即发送
+  bool frame = false;             // 合并的请求打包为批量帧
+};
+
+struct HeartbeatOptions {
+  int interval_ms = 10000;    // 0 表示不发送心跳
+  int timeout_ms = 3000;
+};
+
+constexpr size_t kDirectAttachment = 16 * 1024;    // 达到该长度的附件分段写入，不拷贝
+
+static const BatchOptions &batchOptions() {
+	static BatchOptions options = [] {
+	  BatchOptions result;
+	  auto config = Config::getInstance();
+	  if (auto value = config->get("batch_window_ms")) {
+		  result.window_ms = std::stoi(value.value());
+	  }
+	  if (auto value = config->get("batch_max_bytes")) {
+		  result.max_bytes = std::stoul(value.value());
+	  }
+	  result.frame = config->get("batch_frame") == "1";
+	  return result;
+	}();
+	return options;
+}
+
+static const HeartbeatOptions &heartbeatOptions() {
+	static HeartbeatOptions options = [] {
+	  HeartbeatOptions result;
+	  auto config = Config::getInstance();
+	  if (auto value = config->get("heartbeat_interval_ms")) {
+		  result.interval_ms = std::stoi(value.value());
+	  }
+	  if (auto value = config->get("heartbeat_timeout_ms")) {
+		  result.timeout_ms = std::stoi(value.value());
+	  }
+	  return result;
+	}();
+	return options;
+}
+
+RpcConnection::RpcConnection(const hv::EventLoopPtr &loop, const std::string &host, int port)
+	: loop(loop), tcp_client(loop), chunk_writer(chunkSize()), chunks(maxMessageSize(), 2 * maxMessageSize()) {
+	memset(&unpack_setting, 0, sizeof(unpack_setting_t));
+	unpack_setting.mode = UNPACK_BY_LENGTH_FIELD;
+	unpack_setting.package_max_length = DEFAULT_PACKAGE_MAX_LENGTH;
+	unpack_setting.body_offset = FRAME_HEAD_LENGTH;
+	unpack_setting.length_field_offset = SERVER_HEAD_LENGTH_FIELD_OFFSET;
+	unpack_setting.length_field_bytes = SERVER_HEAD_LENGTH_FIELD_BYTES;
+	unpack_setting.length_field_coding = ENCODE_BY_BIG_ENDIAN;
+	tcp_client.setUnpack(&unpack_setting);
+
+	tcp_client.onConnection = [this](const hv::SocketChannelPtr &channel) {
+	  OnConnection(channel);
+	};
+	tcp_client.onMessage = [this](const hv::SocketChannelPtr &channel, hv::Buffer *buf) {
+	  OnMessage(channel, buf);
+	};
+	tcp_client.onWriteComplete = [this](const hv::SocketChannelPtr &, hv::Buffer *) {
+	  if (!chunk_writer.empty()) {
+		  Pump();
+	  }
+	};
+
+	if (tcp_client.createsocket(port, host.c_str()) < 0) {
+		LOG_ERROR("createsocket failed {}:{}", host, port);
+	}
+	batch.assign(FRAME_HEAD_LENGTH, '\0');
+}
+
+/**
+ * @brief 发送一个请求，响应、超时或连接异常时回调
+ * @param call_id 请求编号，响应头中原样带回
+ * @param frame 已打包好的请求数据
+ */
+void RpcConnection::Send(uint64_t call_id, std::string frame, int timeout_ms, Callback callback) {
+	loop->runInLoop([this, call_id, frame = std::move(frame), timeout_ms, callback = std::move(callback)]() mutable {
+	  AddPending(call_id, timeout_ms, std::move(callback));
+	  Post(std::move(frame));
+	});
+}
+
+/**
+ * @brief 带附件的请求：已连接且附件较大时分段写入，附件不拷贝进合并缓冲区
+ */
+void RpcConnection::Send(uint64_t call_id, FrameParts frame, int timeout_ms, Callback callback) {
+	loop->runInLoop([this, call_id, frame = std::move(frame), timeout_ms, callback = std::move(callback)]() mutable {
+	  AddPending(call_id, timeout_ms, std::move(callback));
+	  if (!connected || frame.attachment.size() < kDirectAttachment) {
+		  Post(frame.join());
+		  return;
+	  }
+	  // 先发出已合并的请求以保持顺序
+	  Flush();
+	  if (frame.size() > chunkSize() && (peer_chunk || frame.size() > DEFAULT_PACKAGE_MAX_LENGTH)) {
+		  chunk_writer.add(std::move(frame));
+		  Pump();
+		  return;
+	  }
+	  // libhv 没有 writev，各段依次写入，套接字可写时不经过写缓冲
+	  tcp_client.channel->write(frame.prefix);
+	  tcp_client.channel->write(frame.attachment);
+	  if (!frame.suffix.empty()) {
+		  tcp_client.channel->write(frame.suffix);
+	  }
+	});
+}
+
+void RpcConnection::AddPending(uint64_t call_id, int timeout_ms, Callback callback) {
+	auto timer = loop->setTimeout(timeout_ms, [this, call_id](hv::TimerID) {
+	  Complete(call_id, RPC_ERR_TIMEOUT, "rpc timeout", "");
+	});
+	pending[call_id] = PendingCall{std::move(callback), timer};
+}
+
+void RpcConnection::OpenStream(const std::shared_ptr<RpcStream> &stream, std::string frame) {
+	loop->runInLoop([this, weak = std::weak_ptr<RpcStream>(stream), frame = std::move(frame)]() mutable {
+	  if (auto stream = weak.lock()) {
+		  streams[stream->Id()] = weak;
+		  Post(std::move(frame));
+	  }
+	});
+}
+
+void RpcConnection::SendFrame(std::string frame) {
+	loop->runInLoop([this, frame = std::move(frame)]() mutable { Post(std::move(frame)); });
+}
+
+void RpcConnection::CloseStream(uint64_t stream_id) {
+	loop->runInLoop([this, stream_id]() { streams.erase(stream_id); });
+}
+
+void RpcConnection::Warmup() {
+	loop->runInLoop([this]() {
+	  if (!connected && !connecting) {
+		  connecting = true;
+		  Connect();
+	  }
+	});
+}
+
+/**
+ * @brief 已连接时发送，否则缓存并发起连接
+ */
+void RpcConnection::Post(std::string frame) {
+	if (connected) {
+		Write(frame);
+		return;
+	}
+	outbox.push_back(std::move(frame));
+	if (!connecting) {
+		connecting = true;
+		// 可能处于上一条连接的关闭回调中，推迟到下一轮再发起连接
+		loop->queueInLoop([this]() { Connect(); });
+	}
+}
+
+void RpcConnection::Write(const std::string &frame) {
+	if (static_cast<uint8_t>(frame[4]) == FRAME_STREAM) {
+		Flush();
+		tcp_client.channel->write(frame);
+		return;
+	}
+	// 对端声明能重组，或帧已超过对端单帧上限（不分片也必然失败）时分片发送
+	if (frame.size() > chunkSize() && (peer_chunk || frame.size() > DEFAULT_PACKAGE_MAX_LENGTH)) {
+		Flush();
+		chunk_writer.add(frame);
+		Pump();
+		return;
+	}
+	Enqueue(frame);
+}
+
+void RpcConnection::Pump() {
+	if (pumping) {
+		return;    // 写入时同步触发的写完成回调
+	}
+	pumping = true;
+	std::string chunk;
+	auto limit = chunkSize();
+	while (connected && tcp_client.channel->writeBufsize() < limit && chunk_writer.next(chunk)) {
+		tcp_client.channel->write(chunk);
+	}
+	pumping = false;
+}
+
+void RpcConnection::Connect() {
+	if (tcp_client.startConnect() < 0) {
+		connecting = false;
+		FailAll(RPC_ERR_CONNECT, "connect error");
+	}
+}
+
+void RpcConnection::OnConnection(const hv::SocketChannelPtr &channel) {
+	if (channel->isConnected()) {
+		connected = true;
+		connecting = false;
+		heartbeat_recv_count = recv_count;
+		if (heartbeatOptions().interval_ms > 0) {
+			// 定时器随连接释放
+			channel->setHeartbeat(heartbeatOptions().interval_ms, [this]() { Heartbeat(); });
+		}
+		for (const auto &frame : outbox) {
+			Write(frame);
+		}
+		outbox.clear();
+		Flush();
+		return;
+	}
+
+	bool was_connected = connected;
+	if (ping_timer != 0) {
+		loop->killTimer(ping_timer);
+		ping_timer = 0;
+	}
+	batch.resize(FRAME_HEAD_LENGTH);
+	batch_num = 0;
+	chunk_writer.clear();
+	chunks.clear();
+	connected = false;
+	connecting = false;
+	if (was_connected) {
+		FailAll(RPC_ERR_CLOSED, "connection closed");
+	} else {
+		FailAll(RPC_ERR_CONNECT, "connect failed");
+	}
+}
+
+/**
+ * @brief 请求先追加到 batch 中，在本轮事件循环末尾（或 batch_window_ms 后）一起发送
+ */
+void RpcConnection::Enqueue(const std::string &frame) {
+	const auto &options = batchOptions();
+	if (options.window_ms < 0) {
+		tcp_client.channel->write(frame);
+		return;
+	}
+	if (batch.size() > FRAME_HEAD_LENGTH && batch.size() + frame.size() > options.max_bytes) {
+		Flush();
+	}
+	batch.append(frame);
+	batch_num++;
+	if (batch.size() >= options.max_bytes) {
+		Flush();
+		return;
+	}
+	if (flush_scheduled) {
+		return;
+	}
+	flush_scheduled = true;
+	if (options.window_ms > 0) {
+		loop->setTimeout(options.window_ms, [this](hv::TimerID) { Flush(); });
+	} else {
+		loop->queueInLoop([this]() { Flush(); });
+	}
+}
+
+void RpcConnection::Flush() {
+	flush_scheduled = false;
+	if (batch_num == 0 || !connected) {
+		return;
+	}
+	if (batch_num > 1 && peer_batch && batchOptions().frame) {
+		FrameHead head;
+		head.type = FRAME_BATCH;
+		head.flags = HvProtocol::defaultFlags();
+		head.accept = kSupportedCompress;
+		HvProtocol::finishFrame(head, batch);
+		tcp_client.channel->write(batch);
+	} else {
+		tcp_client.channel->write(batch.data() + FRAME_HEAD_LENGTH, static_cast<int>(batch.size() - FRAME_HEAD_LENGTH));
+	}
+	batch.resize(FRAME_HEAD_LENGTH);
+	batch_num = 0;
+}
+
+void RpcConnection::OnMessage(const hv::SocketChannelPtr &channel, hv::Buffer *buf) {
+	recv_count++;
+	OnFrame((const char *)buf->data(), buf->size());
+}
+
+/**
+ * @brief 每个心跳周期执行一次：周期内收到过帧说明连接正常，否则发送心跳并等待应答
+ */
+void RpcConnection::Heartbeat() {
+	if (!connected || !peer_ping) {
+		return;
+	}
+	if (recv_count != heartbeat_recv_count) {
+		heartbeat_recv_count = recv_count;
+		return;
+	}
+	if (ping_timer != 0) {
+		return;
+	}
+	FrameHead head;
+	head.type = FRAME_PING;
+	head.flags = HvProtocol::defaultFlags();
+	ping_seq++;
+	std::string body(reinterpret_cast<const char *>(&ping_seq), sizeof(ping_seq));
+	tcp_client.channel->write(HvProtocol::packFrame(head, body));
+	auto sent_count = recv_count;
+	ping_timer = loop->setTimeout(heartbeatOptions().timeout_ms, [this, sent_count](hv::TimerID) {
+	  ping_timer = 0;
+	  if (connected && recv_count == sent_count) {
+		  LOG_ERROR("heartbeat timeout peer={}", tcp_client.channel->peeraddr());
+		  tcp_client.channel->close();
+	  }
+	});
+}
+
+void RpcConnection::OnFrame(const char *data, size_t size) {
+	auto &channel = tcp_client.channel;
+	if (size > FRAME_HEAD_LENGTH && static_cast<uint8_t>(data[4]) == FRAME_CHUNK) {
+		OnChunk(data, size);
+		return;
+	}
+	if (size > FRAME_HEAD_LENGTH && static_cast<uint8_t>(data[4]) == FRAME_BATCH) {
+		std::vector<ResponseFrame> frames;
+		if (!decodeBatchResponse(data, size, frames)) {
+			channel->close();
+			return;
+		}
+		for (auto &frame : frames) {
+			OnResponse(frame);
+		}
+		return;
+	}
+	if (size > FRAME_HEAD_LENGTH && static_cast<uint8_t>(data[4]) == FRAME_STREAM) {
+		OnStreamFrame(data, size);
+		return;
+	}
+	if (size >= FRAME_HEAD_LENGTH && static_cast<uint8_t>(data[4]) == FRAME_PONG) {
+		peer_ping = static_cast<uint8_t>(data[5]) & FRAME_FLAG_PING;
+		return;    // 收到即可，recv_count 已更新
+	}
+
+	ResponseFrame frame;
+	if (!decodeResponse(data, size, frame)) {
+		// 无法确定是哪个请求的响应，断开连接让等待中的请求尽快失败
+		channel->close();
+		return;
+	}
+	OnResponse(frame);
+}
+
+void RpcConnection::OnResponse(ResponseFrame &frame) {
+	peer_accept.store(frame.accept, std::memory_order_relaxed);
+	peer_batch = frame.flags & FRAME_FLAG_BATCH;
+	peer_chunk = frame.flags & FRAME_FLAG_CHUNK;
+	peer_ping = frame.flags & FRAME_FLAG_PING;
+	Complete(frame.call_id, frame.error_code, frame.error_text, frame.body, std::move(frame.attachment));
+}
+
+void RpcConnection::OnChunk(const char *data, size_t size) {
+	FrameHead head;
+	std::string body;
+	std::string frame;
+	if (!HvProtocol::unpackFrame(data, size, head, body)) {
+		LOG_ERROR("chunk frame unpack failed");
+		tcp_client.channel->close();
+		return;
+	}
+	auto result = chunks.feed(body, frame);
+	if (result == ChunkAssembler::CHUNK_ERROR
+		|| (result == ChunkAssembler::CHUNK_COMPLETE && static_cast<uint8_t>(frame[4]) == FRAME_CHUNK)) {
+		tcp_client.channel->close();
+		return;
+	}
+	if (result == ChunkAssembler::CHUNK_COMPLETE) {
+		OnFrame(frame.data(), frame.size());
+	}
+}
+
+void RpcConnection::OnStreamFrame(const char *data, size_t size) {
+	FrameHead head;
+	std::string body;
+	uint64_t stream_id;
+	StreamKind kind;
+	std::string payload;
+	if (!HvProtocol::unpackFrame(data, size, head, body) || !parseStreamFrame(body, stream_id, kind, payload)) {
+		LOG_ERROR("stream frame unpack failed");
+		tcp_client.channel->close();
+		return;
+	}
+	auto iter = streams.find(stream_id);
+	if (iter == streams.end()) {
+		return;    // 已关闭的流
+	}
+	auto stream = iter->second.lock();
+	if (!stream) {
+		streams.erase(iter);
+		return;
+	}
+	stream->OnFrame(kind, payload);
+}
+
+void RpcConnection::Complete(uint64_t call_id, int error_code, const std::string &error_text, const std::string &body,
+							 ResponseAttachment attachment) {
+	auto iter = pending.find(call_id);
+	if (iter == pending.end()) {
+		return;    // 已超时的请求，响应直接丢弃
+	}
+	auto call = std::move(iter->second);
+	pending.erase(iter);
+	if (error_code != RPC_ERR_TIMEOUT) {
+		loop->killTimer(call.timer);
+	}
+	call.callback(error_code, error_text, body, std::move(attachment));
+}
+
+/**
+ * @brief 连接失败或断开时，让所有等待中的请求失败
+ */
+void RpcConnection::FailAll(int error_code, const std::string &error_text) {
+	// 回调中可能再次发送请求，先把待处理集合换出来
+	std::unordered_map<uint64_t, PendingCall> failed;
+	failed.swap(pending);
+	outbox.clear();
+	for (auto &item : failed) {
+		loop->killTimer(item.second.timer);
+		item.second.callback(error_code, error_text, "", {});
+	}
+	std::unordered_map<uint64_t, std::weak_ptr<RpcStream>> aborted;
+	aborted.swap(streams);
+	for (auto &item : aborted) {
+		if (auto stream = item.second.lock()) {
+			stream->Abort(error_code, error_text);
+		}
+	}
+}
+
+bool decodeResponse(const char *data, size_t size, ResponseFrame &frame) {
+	FrameHead head;
+	std::string frame_body;
+	if (!HvProtocol::unpackFrame(data, size, head, frame_body) || frame_body.size() < SERVER_HEAD_LENGTH) {
+		LOG_ERROR("response frame unpack failed (bad length or checksum)");
+		return false;
+	}
+	frame.accept = head.accept;
+	frame.flags = head.flags;
+
+	std::string_view actual_data;
+	auto header_len = HvProtocol::unpackMessage(frame_body, actual_data);
+
+	tinyrpc::RpcResponseHeader response_header;
+	if (header_len > actual_data.size()
+		|| !response_header.ParseFromArray(actual_data.data(), static_cast<int>(header_len))) {
+		LOG_ERROR("response header parse failed");
+		return false;
+	}
+	frame.call_id = response_header.call_id();
+	frame.error_code = response_header.error_code();
+	frame.error_text = response_header.error_text();
+
+	// 附件位于消息体之后，不压缩
+	size_t attachment_size = response_header.attachment_size();
+	if (attachment_size > actual_data.size() - header_len) {
+		LOG_ERROR("bad attachment size {}", attachment_size);
+		return false;
+	}
+	auto body_end = actual_data.size() - attachment_size;
+	frame.body.assign(actual_data.substr(header_len, body_end - header_len));
+	if (attachment_size != 0) {
+		// 整个帧体交给 shared_ptr，附件作为其中的一段交给调用方，按偏移重新定位（短字符串移动后地址会变）
+		auto offset = static_cast<size_t>(actual_data.data() + body_end - frame_body.data());
+		auto buffer = std::make_shared<const std::string>(std::move(frame_body));
+		frame.attachment.data = std::string_view(*buffer).substr(offset, attachment_size);
+		frame.attachment.buffer = std::move(buffer);
+	}
+	if (head.compress != COMPRESS_NONE) {
+		std::string raw;
+		if (!Compress::decompress(static_cast<CompressType>(head.compress), frame.body, raw)) {
+			frame.error_code = RPC_ERR_BAD_RESPONSE;
+			frame.error_text = "response decompress error";
+			frame.body.clear();
+			return true;
+		}
+		frame.body.swap(raw);
+	}
+	return true;
+}
+
+bool decodeBatchResponse(const char *data, size_t size, std::vector<ResponseFrame> &frames) {
+	FrameHead head;
+	std::string body;
+	std::vector<std::pair<const char *, size_t>> inner;
+	if (!HvProtocol::unpackFrame(data, size, head, body) || !HvProtocol::splitBatch(body.data(), body.size(), inner)) {
+		LOG_ERROR("batch response unpack failed");
+		return false;
+	}
+	frames.resize(inner.size());
+	for (size_t i = 0; i < inner.size(); i++) {
+		if (!decodeResponse(inner[i].first, inner[i].second, frames[i])) {
+			return false;
+		}
+	}
+	return true;
+}
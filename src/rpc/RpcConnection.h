@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file           : RpcConnection.h
+  * @author         : xy
+  * @brief          : 客户端到单个节点的持久连接，按 call_id 复用同一条 TCP 连接
+  * @attention      : 所有状态只在客户端 EventLoop 线程中访问；断开后下次发送时自动重连；
+  *                   同一轮事件循环（或 batch_window_ms 内）发送的请求合并为一次 write，
+  *                   开启 batch_frame 且对端支持时再打包为一个批量帧；流帧不参与批量帧，发送前先发出已合并的请求以保持顺序；
+  *                   超过 chunk_kb 的请求分片发送，写缓冲积压不到一个分片时才写下一片，其他请求可以插在分片之间；
+  *                   对端支持时，连接在一个 heartbeat_interval_ms 周期内没有收到任何帧就发送心跳，
+  *                   heartbeat_timeout_ms 内仍未收到则认为对端已失效，断开连接让等待中的请求立即失败
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCCONNECTION_H_
+#define TINYRPC_SRC_RPC_RPCCONNECTION_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <hv/TcpClient.h>
+#include "ClientTransport.h"
+#include "RpcStream.h"
+#include "utils/Chunk.h"
+
+// 回调在 EventLoop 线程中执行
+class RpcConnection : public ClientTransport {
+ public:
+  // port 为 -1 时 host 为 UDS 路径
+  RpcConnection(const hv::EventLoopPtr &loop, const std::string &host, int port);
+  void Send(uint64_t call_id, std::string frame, int timeout_ms, Callback callback) override;
+  void Send(uint64_t call_id, FrameParts frame, int timeout_ms, Callback callback) override;
+  uint8_t PeerAccept() const override { return peer_accept.load(std::memory_order_relaxed); }
+  // 以下线程安全。登记流并发送 STREAM_OPEN 帧，连接断开时流以 RPC_ERR_CLOSED 终止
+  void OpenStream(const std::shared_ptr<RpcStream> &stream, std::string frame);
+  // 发送流的其余帧
+  void SendFrame(std::string frame);
+  void CloseStream(uint64_t stream_id);
+  // 预先建立连接，首次调用不再等待连接建立
+  void Warmup();
+ private:
+  void Post(std::string frame);
+  void Write(const std::string &frame);
+  void Connect();
+  void OnConnection(const hv::SocketChannelPtr &channel);
+  void OnMessage(const hv::SocketChannelPtr &channel, hv::Buffer *buf);
+  void OnFrame(const char *data, size_t size);
+  void OnChunk(const char *data, size_t size);
+  void Pump();
+  void Enqueue(const std::string &frame);
+  void Flush();
+  void OnResponse(ResponseFrame &frame);
+  void AddPending(uint64_t call_id, int timeout_ms, Callback callback);
+  void OnStreamFrame(const char *data, size_t size);
+  void Complete(uint64_t call_id, int error_code, const std::string &error_text, const std::string &body,
+				ResponseAttachment attachment = {});
+  void FailAll(int error_code, const std::string &error_text);
+  void Heartbeat();
+ private:
+  struct PendingCall {
+	Callback callback;
+	hv::TimerID timer;
+  };
+  hv::EventLoopPtr loop;
+  hv::TcpClientEventLoopTmpl<hv::SocketChannel> tcp_client;
+  unpack_setting_t unpack_setting;
+  bool connected = false;
+  bool connecting = false;
+  std::atomic<uint8_t> peer_accept = 0;
+  bool peer_batch = false;                              // 对端能处理批量帧
+  bool peer_chunk = false;                              // 对端能重组分片帧
+  bool peer_ping = false;                               // 对端能应答心跳
+  uint64_t recv_count = 0;                              // 收到的帧数，心跳据此判断连接上是否有数据
+  uint64_t heartbeat_recv_count = 0;                    // 上一个心跳周期结束时的 recv_count
+  uint64_t ping_seq = 0;
+  hv::TimerID ping_timer = 0;                           // 等待心跳应答，0 表示没有发出的心跳
+  ChunkWriter chunk_writer;
+  ChunkAssembler chunks;
+  bool pumping = false;
+  std::string batch;                                    // 帧头占位 + 待发送的请求帧
+  size_t batch_num = 0;
+  bool flush_scheduled = false;
+  std::vector<std::string> outbox;                      // 连接建立前缓存的请求
+  std::unordered_map<uint64_t, PendingCall> pending;    // 等待响应的请求
+  std::unordered_map<uint64_t, std::weak_ptr<RpcStream>> streams;    // 进行中的流
+};
+
+#endif //TINYRPC_SRC_RPC_RPCCONNECTION_H_
@@ -26,4 +26,13 @@ std::string RpcController::ErrorText() const {
 void RpcController::Reset() {
 	is_fail = false;
 	fail_text.clear();
+	attachment.clear();
+	received_buffer.reset();
+	received = {};
+	timeout = 0;
+}
+
+void RpcController::SetReceivedAttachment(std::shared_ptr<const std::string> buffer, std::string_view view) {
+	received_buffer = std::move(buffer);
+	received = view;
 }
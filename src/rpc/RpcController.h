@@ -3,7 +3,8 @@
   * @file           : RpcController.h
   * @author         : xy
   * @brief          : None
-  * @attention      : None
+  * @attention      : 附件：与消息体并列的原始字节，不经过 protobuf 序列化与压缩，适合图片、张量等大块数据；
+  *                   客户端 SetAttachment 设置请求附件，调用完成后 ReceivedAttachment 为响应附件；服务端相反
   * @date           : 2025/3/22
   ******************************************************************************
   */
@@ -12,7 +13,9 @@
 #define TINYRPC_SRC_RPC_RPCCONTROLLER_H_
 
 #include<google/protobuf/service.h>
+#include<memory>
 #include<string>
+#include<string_view>
 
  class RpcController : public google::protobuf::RpcController{
  public:
@@ -25,9 +28,26 @@
   void StartCancel(){}
   bool IsCanceled() const { return false; }
   void NotifyOnCancel(google::protobuf::Closure* callback){}
+
+  // 本端要发送的附件，以移动方式接管数据
+  void SetAttachment(std::string data) { attachment = std::move(data); }
+  const std::string &Attachment() const { return attachment; }
+  std::string TakeAttachment() { return std::move(attachment); }
+  // 对端发来的附件；服务端为指向接收缓冲区的视图，在 done 执行前有效
+  std::string_view ReceivedAttachment() const { return received; }
+  // buffer 为 view 所指的缓冲区，由控制器持有
+  void SetReceivedAttachment(std::shared_ptr<const std::string> buffer, std::string_view view);
+
+  // 本次调用的超时（毫秒），0 表示使用配置项 rpc_timeout_ms
+  void SetTimeout(int timeout_ms) { timeout = timeout_ms; }
+  int Timeout() const { return timeout; }
  private:
   bool is_fail=false;
   std::string fail_text;
+  std::string attachment;
+  std::shared_ptr<const std::string> received_buffer;
+  std::string_view received;
+  int timeout = 0;
 };
 
 #endif //TINYRPC_SRC_RPC_RPCCONTROLLER_H_
@@ -0,0 +1,337 @@
+/**
+  ******************************************************************************
+  * @file           : RpcCoroutine.h
+  * @author         : xy
+  * @brief          : 基于 C++20 协程的客户端调用接口
+  * @attention      : 库本身按 C++17 编译，本头文件只在使用方以 C++20 编译时生效；
+  *                   co_await asyncCall(stub, &Stub::Login, request) 发起调用，协程在客户端 IO 线程中恢复，
+  *                   等待期间不占用线程；whenAll 并发等待多个 Task；服务端方法中用 serveAsync 以协程处理请求，
+  *                   挂起等待下游调用时同样不占用 IO 线程，协程结束后自动执行 done
+  * @date           : 2025/4/6
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCCOROUTINE_H_
+#define TINYRPC_SRC_RPC_RPCCOROUTINE_H_
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <google/protobuf/service.h>
+#include "RpcController.h"
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+// 协程结束时转移到等待者（对称转移，不增加调用栈深度）
+struct FinalAwaiter {
+  bool await_ready() const noexcept { return false; }
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+	  auto continuation = handle.promise().continuation;
+	  return continuation ? continuation : std::noop_coroutine();
+  }
+  void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+  std::coroutine_handle<> continuation;
+  std::exception_ptr error;
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  FinalAwaiter final_suspend() noexcept { return {}; }
+  void unhandled_exception() { error = std::current_exception(); }
+};
+
+// 立即开始执行、结束后自行销毁的协程，用于在普通函数中启动 Task
+struct Detached {
+  struct promise_type {
+	Detached get_return_object() noexcept { return {}; }
+	std::suspend_never initial_suspend() noexcept { return {}; }
+	std::suspend_never final_suspend() noexcept { return {}; }
+	void return_void() noexcept {}
+	void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}  // namespace detail
+
+// 惰性启动的协程：被 co_await 时才开始执行，结束后恢复等待者
+template <typename T>
+class Task {
+ public:
+  struct promise_type : detail::PromiseBase {
+	std::optional<T> value;
+
+	Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+	template <typename U>
+	void return_value(U &&result) { value.emplace(std::forward<U>(result)); }
+  };
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+  Task &operator=(Task &&other) noexcept {
+	  if (this != &other) {
+		  reset();
+		  handle = std::exchange(other.handle, nullptr);
+	  }
+	  return *this;
+  }
+  ~Task() { reset(); }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiter) noexcept {
+	  handle.promise().continuation = waiter;
+	  return handle;
+  }
+  T await_resume() {
+	  auto &promise = handle.promise();
+	  if (promise.error) {
+		  std::rethrow_exception(promise.error);
+	  }
+	  return std::move(*promise.value);
+  }
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+  void reset() {
+	  if (handle) {
+		  handle.destroy();
+		  handle = nullptr;
+	  }
+  }
+  std::coroutine_handle<promise_type> handle;
+};
+
+template <>
+class Task<void> {
+ public:
+  struct promise_type : detail::PromiseBase {
+	Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+	void return_void() noexcept {}
+  };
+
+  Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+  Task &operator=(Task &&other) noexcept {
+	  if (this != &other) {
+		  reset();
+		  handle = std::exchange(other.handle, nullptr);
+	  }
+	  return *this;
+  }
+  ~Task() { reset(); }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiter) noexcept {
+	  handle.promise().continuation = waiter;
+	  return handle;
+  }
+  void await_resume() {
+	  if (handle.promise().error) {
+		  std::rethrow_exception(handle.promise().error);
+	  }
+  }
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+  void reset() {
+	  if (handle) {
+		  handle.destroy();
+		  handle = nullptr;
+	  }
+  }
+  std::coroutine_handle<promise_type> handle;
+};
+
+// 一次调用的结果，controller 中为错误信息与响应附件
+template <typename Response>
+struct RpcResult {
+  std::unique_ptr<RpcController> controller = std::make_unique<RpcController>();
+  Response response;
+
+  bool ok() const { return !controller->Failed(); }
+  std::string error() const { return controller->ErrorText(); }
+};
+
+// co_await 一次 RPC 调用，done 在客户端 IO 线程中执行并恢复协程；出错前即同步完成时不挂起
+template <typename Stub, typename Request, typename Response>
+class CallAwaiter {
+ public:
+  using Method = void (Stub::*)(google::protobuf::RpcController *, const Request *, Response *,
+								google::protobuf::Closure *);
+
+  CallAwaiter(Stub &stub, Method method, const Request &request, int timeout_ms)
+	  : stub(stub), method(method), request(request) {
+	  result.controller->SetTimeout(timeout_ms);
+  }
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> handle) {
+	  waiter = handle;
+	  (stub.*method)(result.controller.get(), &request, &result.response,
+					 google::protobuf::NewCallback(this, &CallAwaiter::OnDone));
+	  // done 已在调用过程中执行时直接继续，否则等待 done 恢复
+	  return !completed.exchange(true, std::memory_order_acq_rel);
+  }
+  RpcResult<Response> await_resume() { return std::move(result); }
+ private:
+  void OnDone() {
+	  if (completed.exchange(true, std::memory_order_acq_rel)) {
+		  waiter.resume();
+	  }
+  }
+ private:
+  Stub &stub;
+  Method method;
+  const Request &request;
+  RpcResult<Response> result;
+  std::coroutine_handle<> waiter;
+  std::atomic<bool> completed = false;
+};
+
+// timeout_ms 为本次调用的超时，0 表示使用配置项 rpc_timeout_ms
+template <typename Stub, typename Request, typename Response>
+CallAwaiter<Stub, Request, Response> asyncCall(
+	Stub &stub, void (Stub::*method)(google::protobuf::RpcController *, const Request *, Response *,
+									 google::protobuf::Closure *),
+	const Request &request, int timeout_ms = 0) {
+	return CallAwaiter<Stub, Request, Response>(stub, method, request, timeout_ms);
+}
+
+// 在普通函数中启动协程，不等待其结束
+inline void spawn(Task<void> task) {
+	[](Task<void> task) -> detail::Detached {
+	  try {
+		  co_await task;
+	  } catch (const std::exception &) {
+		  // 后台协程的异常无人接收，直接丢弃
+	  }
+	}(std::move(task));
+}
+
+// 服务端：在方法实现中调用，以协程处理请求，协程结束（含异常）后执行 done 发送响应
+inline void serveAsync(google::protobuf::RpcController *controller, google::protobuf::Closure *done, Task<void> task) {
+	[](google::protobuf::RpcController *controller, google::protobuf::Closure *done, Task<void> task) -> detail::Detached {
+	  try {
+		  co_await task;
+	  } catch (const std::exception &e) {
+		  if (controller != nullptr) {
+			  controller->SetFailed(e.what());
+		  }
+	  }
+	  done->Run();
+	}(controller, done, std::move(task));
+}
+
+// 阻塞当前线程直到协程结束，用于 main 等非协程的入口；不要在客户端 IO 线程中调用
+template <typename T>
+T syncWait(Task<T> task) {
+	std::promise<T> promise;
+	auto future = promise.get_future();
+	[](Task<T> task, std::promise<T> &promise) -> detail::Detached {
+	  try {
+		  if constexpr (std::is_void_v<T>) {
+			  co_await task;
+			  promise.set_value();
+		  } else {
+			  promise.set_value(co_await task);
+		  }
+	  } catch (...) {
+		  promise.set_exception(std::current_exception());
+	  }
+	}(std::move(task), promise);
+	return future.get();
+}
+
+namespace detail {
+
+// whenAll 的计数器：初始为任务数 + 1，多出的 1 由发起方在启动全部任务后扣除，避免任务同步完成时提前恢复
+struct WhenAllLatch {
+  explicit WhenAllLatch(size_t count) : remaining(count + 1) {}
+  // 返回 true 表示自己是最后一个
+  bool arrive() { return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+  std::atomic<size_t> remaining;
+  std::coroutine_handle<> waiter;
+};
+
+template <typename T>
+Detached whenAllItem(Task<T> task, std::optional<T> &slot, std::exception_ptr &error, WhenAllLatch &latch) {
+	try {
+		slot.emplace(co_await task);
+	} catch (...) {
+		error = std::current_exception();
+	}
+	if (latch.arrive()) {
+		latch.waiter.resume();
+	}
+}
+
+template <typename Start>
+struct WhenAllAwaiter {
+  WhenAllLatch &latch;
+  Start start;
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> handle) {
+	  latch.waiter = handle;
+	  start();
+	  return !latch.arrive();
+  }
+  void await_resume() const noexcept {}
+};
+
+}  // namespace detail
+
+// 并发执行全部任务，全部结束后按顺序返回结果；任一任务抛出异常时在全部结束后重新抛出
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+	std::vector<std::optional<T>> slots(tasks.size());
+	std::vector<std::exception_ptr> errors(tasks.size());
+	detail::WhenAllLatch latch(tasks.size());
+	auto start = [&]() {
+	  for (size_t i = 0; i < tasks.size(); i++) {
+		  detail::whenAllItem(std::move(tasks[i]), slots[i], errors[i], latch);
+	  }
+	};
+	co_await detail::WhenAllAwaiter<decltype(start)>{latch, start};
+	std::vector<T> results;
+	results.reserve(slots.size());
+	for (size_t i = 0; i < slots.size(); i++) {
+		if (errors[i]) {
+			std::rethrow_exception(errors[i]);
+		}
+		results.push_back(std::move(*slots[i]));
+	}
+	co_return results;
+}
+
+// 不同类型的任务：auto [a, b] = co_await whenAll(callA(), callB());
+template <typename... T>
+Task<std::tuple<T...>> whenAll(Task<T>... tasks) {
+	std::tuple<std::optional<T>...> slots;
+	std::exception_ptr errors[sizeof...(T)];
+	detail::WhenAllLatch latch(sizeof...(T));
+	auto start = [&]() {
+	  [&]<size_t... I>(std::index_sequence<I...>) {
+		(detail::whenAllItem(std::move(tasks), std::get<I>(slots), errors[I], latch), ...);
+	  }(std::index_sequence_for<T...>());
+	};
+	co_await detail::WhenAllAwaiter<decltype(start)>{latch, start};
+	for (auto &error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	co_return std::apply([](auto &...slot) { return std::tuple<T...>(std::move(*slot)...); }, slots);
+}
+
+#endif  // C++20
+
+#endif //TINYRPC_SRC_RPC_RPCCOROUTINE_H_
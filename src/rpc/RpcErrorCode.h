@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file           : RpcErrorCode.h
+  * @author         : xy
+  * @brief          : 客户端与服务端共用的错误码，服务端错误经 RpcResponseHeader 带回
+  * @attention      : None
+  * @date           : 2025/3/27
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCERRORCODE_H_
+#define TINYRPC_SRC_RPC_RPCERRORCODE_H_
+
+enum RpcErrorCode {
+  RPC_OK = 0,
+  // 服务端返回
+  RPC_ERR_SERVICE_NOT_FOUND = 1,
+  RPC_ERR_METHOD_NOT_FOUND = 2,
+  RPC_ERR_BAD_REQUEST = 3,      // 请求头或参数解析失败
+  RPC_ERR_INTERNAL = 4,         // 响应序列化失败等
+  RPC_ERR_CANCELLED = 5,        // 流被任一端取消
+  RPC_ERR_UNAVAILABLE = 6,      // 服务端流数量达到上限
+  RPC_ERR_FAILED = 7,           // 业务方法调用了 SetFailed，错误文本为其参数
+  // 客户端本地产生
+  RPC_ERR_DISCOVERY = 100,      // 服务发现失败
+  RPC_ERR_CONNECT = 101,
+  RPC_ERR_TIMEOUT = 102,
+  RPC_ERR_CLOSED = 103,         // 等待响应时连接断开
+  RPC_ERR_EJECTED = 104,        // 节点因异常被暂时摘除
+  RPC_ERR_BAD_RESPONSE = 105,
+};
+
+#endif //TINYRPC_SRC_RPC_RPCERRORCODE_H_
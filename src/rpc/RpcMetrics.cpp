@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file           : RpcMetrics.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/25
+  ******************************************************************************
+  */
+
+#include <iomanip>
+#include <sstream>
+#include "RpcMetrics.h"
+
+static const double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+size_t threadShardIndex() {
+	static std::atomic<size_t> next_index = 0;
+	thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+	return index;
+}
+
+/**
+ * @brief 合并所有分片，得到该方法的统计快照
+ */
+MethodMetricsSnapshot MethodMetrics::snapshot() const {
+	MethodMetricsSnapshot snapshot;
+	for (const auto &shard : shards_) {
+		snapshot.requests += shard.requests.load(std::memory_order_relaxed);
+		snapshot.errors += shard.errors.load(std::memory_order_relaxed);
+		snapshot.coalesced += shard.coalesced.load(std::memory_order_relaxed);
+		snapshot.cache_hits += shard.cache_hits.load(std::memory_order_relaxed);
+		snapshot.bytes_in += shard.bytes_in.load(std::memory_order_relaxed);
+		snapshot.bytes_out += shard.bytes_out.load(std::memory_order_relaxed);
+		shard.queue_time.snapshotInto(snapshot.queue_time);
+		shard.handler_time.snapshotInto(snapshot.handler_time);
+		shard.serialize_time.snapshotInto(snapshot.serialize_time);
+	}
+	return snapshot;
+}
+
+static void appendSummary(std::ostringstream &oss, const char *name, const char *help, const MethodMetricsList &methods,
+						  const HistogramSnapshot MethodMetricsSnapshot::*member) {
+	oss << "# HELP " << name << " " << help << "\n";
+	oss << "# TYPE " << name << " summary\n";
+	for (const auto &method : methods) {
+		const auto &histogram = method.second.*member;
+		for (auto q : kQuantiles) {
+			oss << name << "{method=\"" << method.first << "\",quantile=\"" << q << "\"} "
+				<< static_cast<double>(histogram.percentile(q)) / 1e9 << "\n";
+		}
+		oss << name << "_sum{method=\"" << method.first << "\"} " << static_cast<double>(histogram.sum) / 1e9 << "\n";
+		oss << name << "_count{method=\"" << method.first << "\"} " << histogram.count << "\n";
+	}
+}
+
+static void appendCounter(std::ostringstream &oss, const char *name, const char *help, const MethodMetricsList &methods,
+						  uint64_t MethodMetricsSnapshot::*member) {
+	oss << "# HELP " << name << " " << help << "\n";
+	oss << "# TYPE " << name << " counter\n";
+	for (const auto &method : methods) {
+		oss << name << "{method=\"" << method.first << "\"} " << method.second.*member << "\n";
+	}
+}
+
+std::string renderPrometheus(const MethodMetricsList &methods) {
+	std::ostringstream oss;
+	appendCounter(oss, "tinyrpc_requests_total", "Requests received.", methods, &MethodMetricsSnapshot::requests);
+	appendCounter(oss, "tinyrpc_errors_total", "Requests failed.", methods, &MethodMetricsSnapshot::errors);
+	appendCounter(oss, "tinyrpc_coalesced_total", "Requests served by an identical in-flight request.", methods,
+				  &MethodMetricsSnapshot::coalesced);
+	appendCounter(oss, "tinyrpc_cache_hits_total", "Requests served from the response cache.", methods,
+				  &MethodMetricsSnapshot::cache_hits);
+	appendCounter(oss, "tinyrpc_bytes_in_total", "Request bytes received.", methods, &MethodMetricsSnapshot::bytes_in);
+	appendCounter(oss, "tinyrpc_bytes_out_total", "Response bytes sent.", methods, &MethodMetricsSnapshot::bytes_out);
+	appendSummary(oss, "tinyrpc_queue_seconds", "Time from packet received to handler start.", methods,
+				  &MethodMetricsSnapshot::queue_time);
+	appendSummary(oss, "tinyrpc_handler_seconds", "Handler execution time.", methods,
+				  &MethodMetricsSnapshot::handler_time);
+	appendSummary(oss, "tinyrpc_serialize_seconds", "Response serialize time.", methods,
+				  &MethodMetricsSnapshot::serialize_time);
+	return oss.str();
+}
+
+std::string renderLatencyTable(const MethodMetricsList &methods) {
+	std::ostringstream oss;
+	oss << std::left << std::setw(40) << "method" << std::setw(12) << "phase" << std::right
+		<< std::setw(10) << "count" << std::setw(10) << "mean" << std::setw(10) << "p50"
+		<< std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "p999" << "\n";
+	for (const auto &method : methods) {
+		const std::pair<const char *, const HistogramSnapshot *> phases[] = {
+			{"queue", &method.second.queue_time},
+			{"handler", &method.second.handler_time},
+			{"serialize", &method.second.serialize_time},
+		};
+		for (const auto &phase : phases) {
+			const auto &histogram = *phase.second;
+			oss << std::left << std::setw(40) << method.first << std::setw(12) << phase.first << std::right
+				<< std::setw(10) << histogram.count << std::setw(10) << histogram.mean() / 1000;
+			for (auto q : kQuantiles) {
+				oss << std::setw(10) << histogram.percentile(q) / 1000;
+			}
+			oss << "\n";
+		}
+	}
+	return oss.str();
+}
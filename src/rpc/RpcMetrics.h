@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file           : RpcMetrics.h
+  * @author         : xy
+  * @brief          : 服务端每个方法的计数器与耗时直方图
+  * @attention      : 按线程分片记录（每次调用只做几次 relaxed 原子加），读取时合并各分片
+  * @date           : 2025/3/25
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCMETRICS_H_
+#define TINYRPC_SRC_RPC_RPCMETRICS_H_
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "utils/Histogram.h"
+
+constexpr size_t kMetricShards = 16;
+
+// 当前线程对应的分片下标，线程首次调用时分配
+size_t threadShardIndex();
+
+struct MethodMetricsSnapshot {
+  uint64_t requests = 0;
+  uint64_t errors = 0;
+  uint64_t coalesced = 0;              // 合并到进行中的相同请求、未执行业务方法的请求
+  uint64_t cache_hits = 0;             // 由响应缓存直接返回的请求
+  uint64_t bytes_in = 0;
+  uint64_t bytes_out = 0;
+  HistogramSnapshot queue_time;        // 收到完整数据包 -> 开始执行业务方法
+  HistogramSnapshot handler_time;      // 业务方法执行耗时
+  HistogramSnapshot serialize_time;    // 响应序列化耗时
+};
+
+class MethodMetrics {
+ public:
+  void onRequest(size_t bytes_in) {
+	  auto &shard = localShard();
+	  shard.requests.fetch_add(1, std::memory_order_relaxed);
+	  shard.bytes_in.fetch_add(bytes_in, std::memory_order_relaxed);
+  }
+  void onError() { localShard().errors.fetch_add(1, std::memory_order_relaxed); }
+  void onCoalesced() { localShard().coalesced.fetch_add(1, std::memory_order_relaxed); }
+  void onCacheHit() { localShard().cache_hits.fetch_add(1, std::memory_order_relaxed); }
+  void onResponse(size_t bytes_out) { localShard().bytes_out.fetch_add(bytes_out, std::memory_order_relaxed); }
+  void recordQueueTime(uint64_t ns) { localShard().queue_time.record(ns); }
+  void recordHandlerTime(uint64_t ns) { localShard().handler_time.record(ns); }
+  void recordSerializeTime(uint64_t ns) { localShard().serialize_time.record(ns); }
+
+  MethodMetricsSnapshot snapshot() const;
+ private:
+  struct alignas(64) Shard {
+	std::atomic<uint64_t> requests = 0;
+	std::atomic<uint64_t> errors = 0;
+	std::atomic<uint64_t> coalesced = 0;
+	std::atomic<uint64_t> cache_hits = 0;
+	std::atomic<uint64_t> bytes_in = 0;
+	std::atomic<uint64_t> bytes_out = 0;
+	Histogram queue_time;
+	Histogram handler_time;
+	Histogram serialize_time;
+  };
+  Shard &localShard() { return shards_[threadShardIndex()]; }
+ private:
+  std::array<Shard, kMetricShards> shards_;
+};
+
+using MethodMetricsList = std::vector<std::pair<std::string, MethodMetricsSnapshot>>;
+
+// Prometheus 文本格式，耗时以 summary（分位数 + _sum + _count）给出，单位秒
+std::string renderPrometheus(const MethodMetricsList &methods);
+// 便于人工查看的分位数表，单位微秒
+std::string renderLatencyTable(const MethodMetricsList &methods);
+
+#endif //TINYRPC_SRC_RPC_RPCMETRICS_H_
@@ -8,14 +8,80 @@
   ******************************************************************************
   */
 
+#include <chrono>
+#include <cinttypes>
+#include <csignal>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
 #include <hv/EventLoop.h>
 
 #include "RpcProvider.h"
 #include "utils/Log.h"
+#include "utils/Clock.h"
 #include "utils/Config.h"
 #include "utils/HvProtocol.h"
+#include "utils/Chunk.h"
 #include "utils/Zookeeper.h"
 #include "proto/rpc_header.pb.h"
+#include "proto/tinyrpc_options.pb.h"
+#include "RpcErrorCode.h"
+#include "RegistryEntry.h"
+#include "LocalRegistry.h"
+#include "utils/Listener.h"
+#include "ListenerHandoff.h"
+#ifdef TINYRPC_WITH_IO_URING
+#include "UringServer.h"
+#endif
+
+constexpr int kIoThreadNum = 4;    // TCP 连接的 IO 线程数
+constexpr uint8_t kServerFlags = FRAME_FLAG_BATCH | FRAME_FLAG_CHUNK | FRAME_FLAG_PING;    // 服务端在帧头中声明的能力
+
+// 同时进行的流的上限，每个流占用一个处理线程
+static size_t maxStreams() {
+	static const auto &max_streams = Config::getInstance()->bindInt("max_streams", 1024);
+	return static_cast<size_t>(max_streams.get());
+}
+
+// SIGTERM/SIGINT 或标准输入回车时置位；信号处理函数只能做这一件事，由 Run 轮询
+static std::atomic<bool> external_stop{false};
+
+static void onStopSignal(int) {
+	external_stop.store(true, std::memory_order_relaxed);
+}
+
+// 处理函数只生效一次（SA_RESETHAND），排空卡住时再发一次信号即按默认方式结束进程
+static void installStopHandlers() {
+	struct sigaction action{};
+	action.sa_handler = &onStopSignal;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESETHAND | SA_RESTART;
+	sigaction(SIGTERM, &action, nullptr);
+	sigaction(SIGINT, &action, nullptr);
+
+	static std::once_flag stdin_flag;
+	std::call_once(stdin_flag, []() {
+	  std::thread([]() {
+		int c;
+		while ((c = getchar()) != EOF) {    // 标准输入关闭（后台运行）时不再等待回车
+			if (c == '\n') {
+				external_stop.store(true, std::memory_order_relaxed);
+				return;
+			}
+		}
+	  }).detach();
+	});
+}
+
+RpcProvider::~RpcProvider() {
+	if (slow_watch_id != 0) {
+		Config::getInstance()->unwatch(slow_watch_id);
+	}
+	if (cache_watch_id != 0) {
+		Config::getInstance()->unwatch(cache_watch_id);
+	}
+}
 
 void RpcProvider::Run() {
 	// 从配置文件中读取 rpc_server 的 ip 和 port
@@ -33,42 +99,188 @@ void RpcProvider::Run() {
 	}
 	const std::string &rpc_ip = ip.value();
 
-	auto ip_port = rpc_ip + ":" + std::to_string(rpc_port);
+	ip_port = rpc_ip + ":" + std::to_string(rpc_port);
 
-	// 创建TcpServer
-	hv::TcpServer tcp_server;
-	auto listen_fd = tcp_server.createsocket(rpc_port, rpc_ip.c_str());
-	if (listen_fd < 0) {
-		LOG_ERROR("tcp_server.createsocket failed");
-		return;
+	// 同一轮事件循环中产生的 TCP/UDS 响应合并发送，write_coalesce=0 时逐个发送
+	write_coalesce = Config::getInstance()->get("write_coalesce") != "0";
+
+	// 空闲连接回收，客户端按 heartbeat_interval_ms 发送心跳，正常的空闲连接不会被回收
+	idle_timeout_ms = static_cast<int>(Config::getInstance()->bindInt("server_idle_timeout_ms", 0).get());
+
+	// 慢请求阈值，换算成 tick 后每次请求只需一次比较（首次换算会校准时钟）；配置重新加载时重新换算
+	slow_watch_id = Config::getInstance()->watch("slow_request_ms", [this](const std::optional<std::string> &value) {
+	  auto slow_ms = value == std::nullopt ? 0 : std::strtoull(value->c_str(), nullptr, 10);
+	  slow_threshold_ticks.store(slow_ms == 0 ? 0 : nsToTicks(slow_ms * 1000000), std::memory_order_relaxed);
+	});
+
+	// 响应缓存的总字节预算，默认 64MB，0 表示不缓存；重新加载时缩小会立即淘汰
+	cache_watch_id = Config::getInstance()->watch("response_cache_bytes", [this](const std::optional<std::string> &value) {
+	  response_cache.SetCapacity(value == std::nullopt ? 64 * 1024 * 1024 : std::strtoull(value->c_str(), nullptr, 10));
+	});
+
+	// 修改配置文件或发送 SIGHUP 后重新加载，已绑定的配置项（超时、限额、日志级别等）随之生效
+	if (Config::getInstance()->get("config_watch") != "0") {
+		Config::getInstance()->startWatcher();
 	}
 
-	// 设置拆包规则
-	server_unpack_setting = new unpack_setting_t();
-	memset(server_unpack_setting, 0, sizeof(unpack_setting_t));
-	server_unpack_setting->mode = UNPACK_BY_LENGTH_FIELD;
-	server_unpack_setting->package_max_length = DEFAULT_PACKAGE_MAX_LENGTH;
-	server_unpack_setting->body_offset = SERVER_HEAD_LENGTH;
-	server_unpack_setting->length_field_offset = SERVER_HEAD_LENGTH_FIELD_OFFSET;
-	server_unpack_setting->length_field_bytes = SERVER_HEAD_LENGTH_FIELD_BYTES;
-	server_unpack_setting->length_field_coding = ENCODE_BY_BIG_ENDIAN;
-	tcp_server.setUnpack(server_unpack_setting);
+	// 配置了 rpc_handoff_path 时先向该路径上的旧进程索取监听套接字，没有旧进程时按正常方式监听
+	auto handoff_path = Config::getInstance()->get("rpc_handoff_path");
+	bool use_handoff = handoff_path != std::nullopt && !handoff_path->empty();
+	ListenerSet inherited;
+	HandoffClient handoff_client;
+	bool inherit = use_handoff && handoff_client.Receive(handoff_path.value(), inherited);
+	if (inherit) {
+		std::cout << "RpcProvider take over listeners from " << handoff_path.value() << std::endl;
+	}
 
+	// TCP 监听默认使用 libhv；编译时开启 TINYRPC_WITH_IO_URING 后可配置 io_engine=io_uring 切换，内核不支持时回退
+#ifdef TINYRPC_WITH_IO_URING
+	std::unique_ptr<UringServer> uring_server;
+	if (Config::getInstance()->get("io_engine") == "io_uring") {
+		uring_server = std::make_unique<UringServer>();
+		auto handler = [this](const RpcSessionPtr &session, const char *data, size_t size) {
+		  Dispatch(session, data, size);
+		};
+		auto on_connection = [this](bool connected) {
+		  if (connected) {
+			  connection_num.fetch_add(1, std::memory_order_relaxed);
+		  } else {
+			  connection_num.fetch_sub(1, std::memory_order_relaxed);
+		  }
+		};
+		if (!uring_server->Start(rpc_ip, rpc_port, kIoThreadNum, handler, on_connection)) {
+			LOG_ERROR("io_uring server start failed, fall back to libhv");
+			uring_server.reset();
+		}
+	}
+	bool use_uring = uring_server != nullptr;
+#else
+	bool use_uring = false;
+#endif
+
+	// 设置拆包规则
+	memset(&server_unpack_setting, 0, sizeof(unpack_setting_t));
+	server_unpack_setting.mode = UNPACK_BY_LENGTH_FIELD;
+	server_unpack_setting.package_max_length = DEFAULT_PACKAGE_MAX_LENGTH;
+	server_unpack_setting.body_offset = FRAME_HEAD_LENGTH;
+	server_unpack_setting.length_field_offset = SERVER_HEAD_LENGTH_FIELD_OFFSET;
+	server_unpack_setting.length_field_bytes = SERVER_HEAD_LENGTH_FIELD_BYTES;
+	server_unpack_setting.length_field_coding = ENCODE_BY_BIG_ENDIAN;
 
 	// 设置回调
-	tcp_server.onConnection = [this](const hv::SocketChannelPtr &conn) {
+	auto on_connection = [this](const hv::SocketChannelPtr &conn) {
 	  this->OnConnection(conn);
 	};
-	tcp_server.onMessage = [this](const hv::SocketChannelPtr &conn, hv::Buffer *buf) {
+	auto on_message = [this](const hv::SocketChannelPtr &conn, hv::Buffer *buf) {
 	  this->OnMessage(conn, buf);
 	};
+	auto on_write_complete = [](const hv::SocketChannelPtr &conn, hv::Buffer *) {
+	  auto session = conn->getContextPtr<TcpSession>();
+	  if (session) {
+		  session->OnWriteComplete();
+	  }
+	};
+
+	// 创建TcpServer：默认一个监听套接字，acceptor 线程把连接分给 4 个 IO 线程；
+	// reuseport_listeners=1 时每个 IO 线程持有自己的 SO_REUSEPORT 监听套接字并就地 accept，由内核分配连接；
+	// 接管旧进程的监听套接字时沿用其监听方式（io_uring 自行绑定 SO_REUSEPORT 监听套接字，不使用移交的套接字）
+	std::vector<std::unique_ptr<hv::TcpServer>> tcp_servers;
+	bool reuse_port = Config::getInstance()->get("reuseport_listeners") == "1";
+	if (use_uring) {
+		for (int fd : inherited.tcp_fds) {
+			close(fd);
+		}
+		inherited.tcp_fds.clear();
+	} else if (!inherited.tcp_fds.empty()) {
+		reuse_port = inherited.tcp_fds.size() > 1;
+	}
+	int listener_num = use_uring ? 0 : !inherited.tcp_fds.empty() ? static_cast<int>(inherited.tcp_fds.size())
+		: (reuse_port ? kIoThreadNum : 1);
+	for (int i = 0; i < listener_num; i++) {
+		auto tcp_server = std::make_unique<hv::TcpServer>();
+		if (!inherited.tcp_fds.empty()) {
+			tcp_server->listenfd = inherited.tcp_fds[i];
+		} else if (reuse_port) {
+			tcp_server->listenfd = listenTcp(rpc_ip, rpc_port, true);
+		} else {
+			tcp_server->createsocket(rpc_port, rpc_ip.c_str());
+		}
+		tcp_server->setThreadNum(reuse_port ? 0 : kIoThreadNum);    // reuseport 时连接留在 accept 所在的事件循环中处理
+		if (tcp_server->listenfd < 0) {
+			LOG_ERROR("tcp_server.createsocket failed");
+			// 关闭已创建与未用到的监听套接字；不通知旧进程排空，handoff_client 析构时断开，旧进程继续服务
+			for (auto &created : tcp_servers) {
+				created->closesocket();
+			}
+			for (size_t j = i + 1; j < inherited.tcp_fds.size(); j++) {
+				close(inherited.tcp_fds[j]);
+			}
+			if (inherited.uds_fd >= 0) {
+				close(inherited.uds_fd);
+			}
+#ifdef TINYRPC_WITH_IO_URING
+			if (uring_server) {
+				uring_server->Stop();
+			}
+#endif
+			return;
+		}
+		tcp_server->setUnpack(&server_unpack_setting);
+		tcp_server->onConnection = on_connection;
+		tcp_server->onMessage = on_message;
+		tcp_server->onWriteComplete = on_write_complete;
+		tcp_servers.push_back(std::move(tcp_server));
+	}
+
+	// 同机调用方使用的 UDS 监听（可选），与 TCP 共用拆包规则与回调
+	RegistryEntry entry;
+	entry.ip = rpc_ip;
+	entry.port = rpc_port;
+	hv::TcpServer uds_server;
+	auto uds_path = Config::getInstance()->get("rpc_uds_path");
+	if (uds_path != std::nullopt && !uds_path->empty()) {
+		if (inherited.uds_fd >= 0) {
+			uds_server.listenfd = inherited.uds_fd;    // 套接字文件仍指向它，不能删除
+			inherited.uds_fd = -1;
+		} else {
+			unlink(uds_path->c_str());    // 清理上次异常退出留下的套接字文件
+			uds_server.createsocket(-1, uds_path->c_str());
+		}
+		if (uds_server.listenfd < 0) {
+			LOG_ERROR("uds_server.createsocket failed: {}", uds_path.value());
+		} else {
+			uds_server.setUnpack(&server_unpack_setting);
+			uds_server.onConnection = on_connection;
+			uds_server.onMessage = on_message;
+			uds_server.onWriteComplete = on_write_complete;
+			uds_server.setThreadNum(2);
+			entry.uds_path = uds_path.value();
+		}
+	}
 
-	tcp_server.setThreadNum(4);
+	if (inherited.uds_fd >= 0) {
+		close(inherited.uds_fd);    // 新配置不再监听 UDS
+	}
+
+	// 同机调用方的共享内存传输（可选），请求在各会话线程中处理
+	auto shm_path = Config::getInstance()->get("rpc_shm_path");
+	if (shm_path != std::nullopt && !shm_path->empty()) {
+		shm_listener = std::make_unique<ShmListener>();
+		auto handler = [this](const RpcSessionPtr &session, const char *data, size_t size) {
+		  Dispatch(session, data, size);
+		};
+		if (shm_listener->Start(shm_path.value(), handler)) {
+			entry.shm_path = shm_path.value();
+		} else {
+			shm_listener.reset();
+		}
+	}
 
 	Zookeeper zk{};
 	zk.start();  // 连接 zk 服务器
 
-// 注册服务
+// 注册服务；接管旧进程时旧进程的临时节点仍在，先删除再以本进程的会话创建
+	std::vector<std::string> registered_paths;    // 本进程创建的方法节点，排空时删除
 	for (const auto& service : service_dic) {
 		auto service_path = "/" + service.first;
 
@@ -79,17 +291,136 @@ void RpcProvider::Run() {
 		for (const auto& method : service.second.method_dic) {
 			auto method_path = service_path + "/" + method.first;
 
+			if (inherit) {
+				zk.remove(method_path);
+			}
 			if (!zk.exists(method_path)) {
-				zk.create(method_path, ip_port, ZOO_EPHEMERAL);  // 创建方法节点并记录 rpc 服务器的 ip 和 port
+				zk.create(method_path, entry.ToString(), ZOO_EPHEMERAL);  // 创建方法节点并记录 rpc 服务器的地址
+				registered_paths.push_back(method_path);
 			}
 		}
 	}
 
-	tcp_server.start();
+	for (auto &tcp_server : tcp_servers) {
+		tcp_server->start();
+	}
+	if (!entry.uds_path.empty()) {
+		uds_server.start();
+	}
+
+	std::cout << "RpcProvider start service at " << "ip: " << rpc_ip << " port: " << rpc_port
+			  << (use_uring ? " (io_uring)" : reuse_port ? " (reuseport)" : "") << std::endl;
+	if (!entry.uds_path.empty()) {
+		std::cout << "RpcProvider start service at " << "uds: " << entry.uds_path << std::endl;
+	}
+	if (!entry.shm_path.empty()) {
+		std::cout << "RpcProvider start service at " << "shm: " << entry.shm_path << std::endl;
+	}
+
+	// 管理端口（可选）
+	auto admin_port = Config::getInstance()->bindInt("admin_port", 0).get();
+	if (admin_port > 0) {
+		admin = std::make_unique<RpcAdmin>(this);
+		admin->Start(rpc_ip, static_cast<int>(admin_port));
+	}
+
+	// 已开始 accept 并接管了注册中心节点，旧进程可以排空；随后本进程等待下一次重启来接管
+	handoff_client.Ready();
+	HandoffServer handoff_server;
+	if (use_handoff) {
+		ListenerSet listeners;
+		for (auto &tcp_server : tcp_servers) {
+			listeners.tcp_fds.push_back(tcp_server->listenfd);
+		}
+		listeners.uds_fd = entry.uds_path.empty() ? -1 : uds_server.listenfd;
+		handoff_server.Start(handoff_path.value(), listeners, [this]() { Stop(); });
+	}
+
+	WaitStop();
+	draining.store(true, std::memory_order_relaxed);
+	bool handed_off = handoff_server.HandedOff();
+	std::cout << "RpcProvider draining" << (handed_off ? " (listeners handed off)" : "") << std::endl;
+
+	// 1. 从注册中心摘除（已移交时节点属于新进程），留出时间让调用方收到通知后不再选择本节点
+	if (!handed_off && !registered_paths.empty()) {
+		for (const auto &path : registered_paths) {
+			zk.remove(path);
+		}
+		const auto &grace_ms = Config::getInstance()->bindInt("drain_grace_ms", 1000);
+		std::this_thread::sleep_for(std::chrono::milliseconds(grace_ms.get()));
+	}
+
+	// 2. 停止接受新连接，已建立的连接继续处理（已移交时监听套接字在新进程中继续 accept）
+	handoff_server.Stop();
+	for (auto &tcp_server : tcp_servers) {
+		tcp_server->closesocket();
+	}
+	if (!entry.uds_path.empty()) {
+		uds_server.closesocket();
+	}
+	if (shm_listener) {
+		shm_listener->StopAccept();
+	}
+
+	// 3. 等待进行中的调用与流结束
+	const auto &timeout_ms = Config::getInstance()->bindInt("drain_timeout_ms", 10000);
+	if (!WaitIdle(timeout_ms.get())) {
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		LOG_ERROR("drain timeout, abandon {} calls and cancel {} streams", InflightNum(), streams.size());
+	}
+	CancelStreams();
+
+	// 4. 关闭
+	for (auto &tcp_server : tcp_servers) {
+		tcp_server->stop();
+	}
+	if (!entry.uds_path.empty()) {
+		uds_server.stop();
+		if (!handed_off) {
+			unlink(entry.uds_path.c_str());
+		}
+	}
+	if (shm_listener) {
+		shm_listener->Stop();
+	}
+#ifdef TINYRPC_WITH_IO_URING
+	if (uring_server) {
+		uring_server->Stop();
+	}
+#endif
+	std::cout << "RpcProvider stopped" << std::endl;
+}
+
+void RpcProvider::Stop() {
+	std::lock_guard<std::mutex> lock(stop_mtx);
+	stop_requested = true;
+	stop_cv.notify_all();
+}
 
-	std::cout << "RpcProvider start service at " << "ip: " << rpc_ip << " port: " << rpc_port << std::endl;
+void RpcProvider::WaitStop() {
+	installStopHandlers();
+	std::unique_lock<std::mutex> lock(stop_mtx);
+	while (!stop_requested && !external_stop.load(std::memory_order_relaxed)) {
+		stop_cv.wait_for(lock, std::chrono::milliseconds(100));
+	}
+}
 
-	while (getchar() != '\n');
+bool RpcProvider::WaitIdle(int64_t timeout_ms) {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+	while (true) {
+		size_t stream_num;
+		{
+			std::lock_guard<std::mutex> lock(stream_mtx);
+			stream_num = streams.size();
+		}
+		if (InflightNum() == 0 && stream_num == 0) {
+			return true;
+		}
+		if (std::chrono::steady_clock::now() >= deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
 }
 
 /**
@@ -103,103 +434,891 @@ void RpcProvider::NotifyService(google::protobuf::Service *service) {
 	auto method_count = service_ptr->method_count();        // 获得方法个数
 
 	// 存储方法，便于查询
-	std::unordered_map<std::string, const google::protobuf::MethodDescriptor *> method_map;
+	ServiceInfo service_info;
+	service_info.service_ptr = service;
 	for (int i = 0; i < method_count; i++) {
 		const auto method = service_ptr->method(i);
 		const std::string method_name = method->name();
-		method_map[method_name] = method;
+		service_info.method_dic[method_name] = MethodInfo{method, std::make_unique<MethodMetrics>(),
+														  Compress::methodType(service_name + "." + method_name), nullptr, nullptr,
+														  method->options().GetExtension(tinyrpc::coalesce),
+														  method->options().GetExtension(tinyrpc::cache_ttl_ms)};
+	}
+
+	service_dic[service_name] = std::move(service_info);
+	LocalRegistry::getInstance()->Publish(service);
+}
+
+/**
+ * @brief 注册生成的服务骨架，描述信息只在此处查找一次，用于统计与日志
+ * @param service
+ * @return 描述信息缺失或与分发表不一致时返回 false
+ */
+bool RpcProvider::NotifyService(RpcSkeleton *service) {
+	const auto &table = service->DispatchTable();
+	auto descriptor = google::protobuf::DescriptorPool::generated_pool()->FindServiceByName(table.full_name);
+	if (descriptor == nullptr) {
+		LOG_ERROR("NotifyService: descriptor of {} not found", table.full_name);
+		return false;
+	}
+
+	const std::string service_name = descriptor->name();
+	ServiceInfo service_info;
+	service_info.skeleton = service;
+	for (size_t i = 0; i < table.method_count; i++) {
+		const auto &entry = table.methods[i];
+		auto method = descriptor->FindMethodByName(entry.name);
+		if (method == nullptr) {
+			LOG_ERROR("NotifyService: method {}.{} not found", service_name, entry.name);
+			return false;
+		}
+		service_info.method_dic[entry.name] = MethodInfo{method, std::make_unique<MethodMetrics>(),
+														 Compress::methodType(service_name + "." + entry.name), nullptr,
+														 &entry, method->options().GetExtension(tinyrpc::coalesce),
+														 method->options().GetExtension(tinyrpc::cache_ttl_ms)};
+	}
+
+	service_dic[service_name] = std::move(service_info);
+	LocalRegistry::getInstance()->Publish(service, descriptor);
+	return true;
+}
+
+bool RpcProvider::NotifyStream(const std::string &service_name, const std::string &method_name,
+							   StreamHandler handler) {
+	auto service_iter = service_dic.find(service_name);
+	if (service_iter == service_dic.end()) {
+		LOG_ERROR("NotifyStream: service {} not registered", service_name);
+		return false;
+	}
+	auto method_iter = service_iter->second.method_dic.find(method_name);
+	if (method_iter == service_iter->second.method_dic.end()) {
+		LOG_ERROR("NotifyStream: method {}.{} not found", service_name, method_name);
+		return false;
+	}
+	method_iter->second.stream_handler = std::move(handler);
+	return true;
+}
+
+/**
+ * @brief 打包响应：帧头(8字节) + [响应头长度(4字节) + RpcResponseHeader + 响应消息]
+ * @attention 先计算各部分长度，响应头与消息体直接序列化到 frame 中，不经过中间字符串；压缩后没有变小时按原文发送；
+ *            body 为 nullptr 时消息体取已序列化的 serialized_body（都为 nullptr 表示没有消息体）
+ */
+static void packResponseFrame(std::string &frame, uint64_t call_id, int error_code, const std::string &error_text,
+							  const google::protobuf::Message *body, const std::string *serialized_body,
+							  CompressType compress, uint8_t accept, std::string_view attachment) {
+	tinyrpc::RpcResponseHeader response_header;
+	response_header.set_call_id(call_id);
+	response_header.set_error_code(error_code);
+	response_header.set_error_text(error_text);
+	response_header.set_attachment_size(attachment.size());
+	auto header_size = response_header.ByteSizeLong();
+	auto body_size = body != nullptr ? body->ByteSizeLong() : serialized_body != nullptr ? serialized_body->size() : 0;
+
+	FrameHead frame_head;
+	frame_head.type = FRAME_RESPONSE;
+	frame_head.flags = HvProtocol::defaultFlags() | kServerFlags;
+	frame_head.accept = kSupportedCompress;
+
+	// 需要压缩时消息体先序列化到线程内复用的缓冲区
+	const std::string *payload = serialized_body;
+	if (body_size >= Compress::threshold() && Compress::accepted(accept, compress)) {
+		thread_local std::string raw;
+		thread_local std::string compressed;
+		if (body != nullptr) {
+			raw.resize(body_size);
+			body->SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(raw.data()));
+			payload = &raw;
+			body = nullptr;    // 消息体已在 payload 中
+		}
+		if (Compress::compress(compress, *payload, compressed) && compressed.size() < payload->size()) {
+			frame_head.compress = compress;
+			payload = &compressed;
+		}
 	}
 
-	ServiceInfo service_info = {service, method_map};
-	service_dic[service_name] = service_info;
+	auto payload_size = body != nullptr ? body_size : payload != nullptr ? payload->size() : 0;
+	frame.resize(FRAME_HEAD_LENGTH + SERVER_HEAD_LENGTH + header_size + payload_size + attachment.size());
+	auto ptr = reinterpret_cast<uint8_t *>(frame.data()) + FRAME_HEAD_LENGTH;
+	auto header_len = htonl(static_cast<uint32_t>(header_size));
+	memcpy(ptr, &header_len, SERVER_HEAD_LENGTH);
+	ptr = response_header.SerializeWithCachedSizesToArray(ptr + SERVER_HEAD_LENGTH);
+	if (body != nullptr) {
+		ptr = body->SerializeWithCachedSizesToArray(ptr);
+	} else if (payload != nullptr) {
+		ptr = static_cast<uint8_t *>(memcpy(ptr, payload->data(), payload->size())) + payload->size();
+	}
+	if (!attachment.empty()) {
+		memcpy(ptr, attachment.data(), attachment.size());
+	}
+	HvProtocol::finishFrame(frame_head, frame);
+}
+
+void RpcProvider::packResponse(std::string &frame, uint64_t call_id, int error_code, const std::string &error_text,
+							   const google::protobuf::Message *body, CompressType compress, uint8_t accept,
+							   std::string_view attachment) {
+	packResponseFrame(frame, call_id, error_code, error_text, body, nullptr, compress, accept, attachment);
+}
+
+void RpcProvider::packSerializedResponse(std::string &frame, uint64_t call_id, const std::string &body,
+										 CompressType compress, uint8_t accept, std::string_view attachment) {
+	packResponseFrame(frame, call_id, RPC_OK, "", nullptr, &body, compress, accept, attachment);
+}
+
+/**
+ * @brief 当前线程打包响应用的缓冲区，发送后保留容量供下一个响应使用
+ */
+static std::string &frameBuffer() {
+	constexpr size_t kMaxRetained = 1024 * 1024;    // 偶发的大响应之后释放内存
+	thread_local std::string frame;
+	if (frame.capacity() > kMaxRetained) {
+		std::string().swap(frame);
+	}
+	return frame;
 }
 
 void RpcProvider::OnMessage(const hv::SocketChannelPtr &conn, hv::Buffer *buf) {
-	auto data = std::string((char *)buf->data(), buf->size());
+	RpcSessionPtr session = conn->getContextPtr<TcpSession>();
+	Dispatch(session, (char *)buf->data(), buf->size());
+}
+
+/**
+ * @brief 批量请求帧中各请求的响应先收集起来，全部到齐后合并为一个批量响应帧
+ * @attention 合并后超过对端能接收的帧长时退回逐个发送
+ */
+class BatchSession : public RpcSession {
+ public:
+  BatchSession(RpcSessionPtr parent, size_t count) : parent(std::move(parent)), count(count) {
+	  frames.assign(FRAME_HEAD_LENGTH, '\0');    // 帧头占位
+  }
+  void Write(const std::string &frame) override { Collect(&frame); }
+  // 分片发送的大响应不进入批量帧，只计数
+  bool WriteChunked(const std::string &frame) override {
+	  if (!parent->WriteChunked(frame)) {
+		  return false;
+	  }
+	  Collect(nullptr);
+	  return true;
+  }
+  void Close() override { parent->Close(); }
+  std::string PeerAddr() override { return parent->PeerAddr(); }
+  size_t MaxFrameSize() const override { return parent->MaxFrameSize(); }
+ private:
+  void Collect(const std::string *frame) {
+	  {
+		  std::lock_guard<std::mutex> lock(mtx);
+		  if (frame != nullptr) {
+			  frames.append(*frame);
+		  }
+		  if (++done < count) {
+			  return;
+		  }
+	  }
+	  if (frames.size() == FRAME_HEAD_LENGTH) {
+		  return;
+	  }
+	  if (frames.size() + FRAME_CHECKSUM_LENGTH > std::min<size_t>(parent->MaxFrameSize(), DEFAULT_PACKAGE_MAX_LENGTH)) {
+		  std::vector<std::pair<const char *, size_t>> inner;
+		  HvProtocol::splitBatch(frames.data() + FRAME_HEAD_LENGTH, frames.size() - FRAME_HEAD_LENGTH, inner);
+		  for (const auto &item : inner) {
+			  parent->Write(std::string(item.first, item.second));
+		  }
+		  return;
+	  }
+	  FrameHead head;
+	  head.type = FRAME_BATCH;
+	  head.flags = HvProtocol::defaultFlags() | kServerFlags;
+	  head.accept = kSupportedCompress;
+	  HvProtocol::finishFrame(head, frames);
+	  parent->Write(frames);
+  }
+ private:
+  RpcSessionPtr parent;
+  size_t count;
+  std::mutex mtx;
+  size_t done = 0;
+  std::string frames;
+};
+
+void RpcProvider::DispatchBatch(const RpcSessionPtr &session, const std::string &body) {
+	std::vector<std::pair<const char *, size_t>> frames;
+	if (!HvProtocol::splitBatch(body.data(), body.size(), frames) || frames.empty()) {
+		LOG_ERROR("bad batch frame peer={}", session->PeerAddr());
+		session->Close();
+		return;
+	}
+	for (const auto &frame : frames) {
+		if (static_cast<uint8_t>(frame.first[4]) != FRAME_REQUEST) {
+			LOG_ERROR("non-request frame in batch peer={}", session->PeerAddr());
+			session->Close();
+			return;
+		}
+	}
+	// 各请求照常分发，响应由 BatchSession 汇总；处理函数可能异步完成，最后一个响应到达时发出
+	auto batch = std::make_shared<BatchSession>(session, frames.size());
+	for (const auto &frame : frames) {
+		Dispatch(batch, frame.first, frame.second);
+	}
+}
+
+void RpcProvider::DispatchStream(const RpcSessionPtr &session, const std::string &body) {
+	uint64_t stream_id;
+	StreamKind kind;
+	std::string payload;
+	if (!parseStreamFrame(body, stream_id, kind, payload)) {
+		LOG_ERROR("bad stream frame peer={}", session->PeerAddr());
+		session->Close();
+		return;
+	}
+	if (kind != STREAM_OPEN) {
+		ServerStreamPtr stream;
+		{
+			std::lock_guard<std::mutex> lock(stream_mtx);
+			auto iter = streams.find({session.get(), stream_id});
+			if (iter != streams.end()) {
+				stream = iter->second;
+			}
+		}
+		if (stream) {
+			stream->OnFrame(kind, payload);
+		}
+		return;    // 已结束的流的迟到帧直接丢弃
+	}
+
+	auto reject = [&session, stream_id](int code, const std::string &text) {
+	  session->Write(packStreamFrame(stream_id, STREAM_RESET, packStreamStatus(code, text)));
+	};
+	uint32_t peer_window;
+	std::string header_data;
+	tinyrpc::RpcHeader rpc_header;
+	if (!parseStreamOpen(payload, peer_window, header_data) || !rpc_header.ParseFromString(header_data)) {
+		LOG_ERROR("bad stream open peer={}", session->PeerAddr());
+		reject(RPC_ERR_BAD_REQUEST, "bad stream open");
+		return;
+	}
+	auto service_iter = service_dic.find(rpc_header.service_name());
+	if (service_iter == service_dic.end()) {
+		reject(RPC_ERR_SERVICE_NOT_FOUND, "service not found: " + rpc_header.service_name());
+		return;
+	}
+	auto method_iter = service_iter->second.method_dic.find(rpc_header.method_name());
+	if (method_iter == service_iter->second.method_dic.end() || !method_iter->second.stream_handler) {
+		reject(RPC_ERR_METHOD_NOT_FOUND, "stream method not found: " + rpc_header.method_name());
+		return;
+	}
+	auto &method_info = method_iter->second;
+	method_info.metrics->onRequest(body.size());
 
-	std::string tmp_data;
-	auto tmp_len = HvProtocol::unpackMessage(data, tmp_data);
+	auto stream = std::make_shared<ServerStream>(
+		stream_id, [session](const std::string &frame) { session->Write(frame); }, streamWindow(), peer_window);
+	{
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		if (streams_closed) {
+			reject(RPC_ERR_UNAVAILABLE, "server stopping");
+			return;
+		}
+		if (streams.size() >= maxStreams()) {
+			method_info.metrics->onError();
+			reject(RPC_ERR_UNAVAILABLE, "too many streams");
+			return;
+		}
+		if (!streams.emplace(std::make_pair(session.get(), stream_id), stream).second) {
+			reject(RPC_ERR_BAD_REQUEST, "duplicate stream id");
+			return;
+		}
+	}
+	// 连接断开时终止其上所有的流，阻塞在 Read/Write 中的处理函数随之返回
+	session->SetCloseHook([this, raw = session.get()]() { AbortStreams(raw); });
+	session->Write(packStreamFrame(stream_id, STREAM_WINDOW, packStreamStatus(static_cast<int>(streamWindow()), "")));
 
-	std::string actual_data;
-	auto header_len = HvProtocol::unpackMessage(tmp_data, actual_data);
+	TraceContext trace;
+	if (rpc_header.trace_id() != 0) {
+		trace = Tracer::newChild({rpc_header.trace_id(), rpc_header.span_id(), rpc_header.trace_flags()});
+	} else {
+		trace = Tracer::getInstance()->newRoot();
+	}
+	// 处理函数可能长时间阻塞在流上，不占用 IO 线程
+	std::vector<std::thread> exited;
+	{
+		// 持锁创建，线程结束时一定能在 stream_threads 中找到自己
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		if (streams_closed) {
+			return;    // 注册后、启动处理线程前 Run 已终止全部流
+		}
+		exited.swap(exited_stream_threads);
+		auto thread_id = next_stream_thread++;
+		stream_threads.emplace(thread_id, std::thread([this, session, stream, trace, thread_id,
+														handler = &method_info.stream_handler]() {
+		  {
+			  TraceScope trace_scope(trace);
+			  (*handler)(*stream);
+			  if (!stream->Finished()) {
+				  stream->Finish();
+			  }
+			  UnregisterStream(session.get(), stream);
+		  }
+		  std::lock_guard<std::mutex> lock(stream_mtx);
+		  auto iter = stream_threads.find(thread_id);
+		  if (iter != stream_threads.end()) {    // 否则已被 CancelStreams 取走，由其 join
+			  exited_stream_threads.push_back(std::move(iter->second));
+			  stream_threads.erase(iter);
+		  }
+		}));
+	}
+	for (auto &thread : exited) {
+		thread.join();
+	}
+}
+
+void RpcProvider::UnregisterStream(RpcSession *session, const ServerStreamPtr &stream) {
+	std::lock_guard<std::mutex> lock(stream_mtx);
+	auto iter = streams.find({session, stream->Id()});
+	if (iter != streams.end() && iter->second == stream) {
+		streams.erase(iter);
+	}
+}
+
+void RpcProvider::AbortStreams(RpcSession *session) {
+	std::vector<ServerStreamPtr> aborted;
+	{
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		auto iter = streams.lower_bound({session, 0});
+		while (iter != streams.end() && iter->first.first == session) {
+			aborted.push_back(std::move(iter->second));
+			iter = streams.erase(iter);
+		}
+	}
+	for (auto &stream : aborted) {
+		stream->Abort(RPC_ERR_CLOSED, "connection closed");
+	}
+}
+
+void RpcProvider::CancelStreams() {
+	std::vector<ServerStreamPtr> cancelled;
+	{
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		streams_closed = true;
+		for (auto &item : streams) {
+			cancelled.push_back(std::move(item.second));
+		}
+		streams.clear();
+	}
+	for (auto &stream : cancelled) {
+		stream->Cancel("server stopping");
+	}
+
+	// 处理函数从 Read/Write 返回后线程退出；join 时不能持锁，线程退出前需要获取 stream_mtx
+	std::vector<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(stream_mtx);
+		threads.swap(exited_stream_threads);
+		for (auto &item : stream_threads) {
+			threads.push_back(std::move(item.second));
+		}
+		stream_threads.clear();
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+
+void RpcProvider::Dispatch(const RpcSessionPtr &session, const char *data, size_t size) {
+	auto recv_ns = nowNs();
+	PhaseTimer phases;
+	phases.begin();
+	FrameHead frame_head;
+	// 帧体由 shared_ptr 持有，请求附件以视图的形式交给业务方法；从读缓冲拷出帧体之后不再拷贝
+	auto payload = std::make_shared<std::string>();
+	auto &frame_body = *payload;
+	if (!HvProtocol::unpackFrame(data, size, frame_head, frame_body)) {
+		LOG_ERROR("unpackFrame failed (bad length or checksum) peer={}", session->PeerAddr());
+		session->Close();
+		return;
+	}
+	if (frame_head.type == FRAME_PING) {
+		// 心跳原样带回，帧头同时告知本端的能力
+		FrameHead pong;
+		pong.type = FRAME_PONG;
+		pong.flags = HvProtocol::defaultFlags() | kServerFlags;
+		pong.accept = kSupportedCompress;
+		session->Write(HvProtocol::packFrame(pong, frame_body));
+		return;
+	}
+	if (frame_head.type == FRAME_BATCH) {
+		DispatchBatch(session, frame_body);
+		return;
+	}
+	if (frame_head.type == FRAME_STREAM) {
+		DispatchStream(session, frame_body);
+		return;
+	}
+	if (frame_head.type == FRAME_CHUNK) {
+		// 收齐后按原帧重新分发，原帧不能再是分片
+		std::string frame;
+		auto result = session->Chunks().feed(frame_body, frame);
+		if (result == ChunkAssembler::CHUNK_ERROR
+			|| (result == ChunkAssembler::CHUNK_COMPLETE && static_cast<uint8_t>(frame[4]) == FRAME_CHUNK)) {
+			LOG_ERROR("bad chunk peer={}", session->PeerAddr());
+			session->Close();
+			return;
+		}
+		if (result == ChunkAssembler::CHUNK_COMPLETE) {
+			Dispatch(session, frame.data(), frame.size());
+		}
+		return;
+	}
+	if (frame_body.size() < SERVER_HEAD_LENGTH) {
+		LOG_ERROR("frame body too short peer={}", session->PeerAddr());
+		session->Close();
+		return;
+	}
 
-	auto header_data = actual_data.substr(0, header_len);
-	auto args_data = actual_data.substr(header_len);
+	std::string_view actual_data;
+	auto header_len = HvProtocol::unpackMessage(frame_body, actual_data);
+	if (header_len > actual_data.size()) {
+		LOG_ERROR("bad header length");
+		session->Close();
+		return;
+	}
+	phases.mark(PHASE_UNPACK);
 
 	tinyrpc::RpcHeader rpc_header = tinyrpc::RpcHeader();
-	if (!rpc_header.ParseFromString(header_data)) {
+	if (!rpc_header.ParseFromArray(actual_data.data(), static_cast<int>(header_len))) {
 		LOG_ERROR("ParseFromString failed");
+		session->Close();    // 拿不到 call_id，无法回复，只能断开
 		return;
 	}
+	phases.mark(PHASE_HEADER);
+
+	// 帧体末尾 attachment_size 字节为附件，其余为参数
+	size_t attachment_size = rpc_header.attachment_size();
+	if (attachment_size > actual_data.size() - header_len) {
+		LOG_ERROR("bad attachment size {}", attachment_size);
+		SendErrorResponse(session, rpc_header.call_id(), RPC_ERR_BAD_REQUEST, "bad attachment size");
+		return;
+	}
+	std::string_view args_data(actual_data.data() + header_len, actual_data.size() - header_len - attachment_size);
+	std::string_view attachment(args_data.data() + args_data.size(), attachment_size);
 
 	// 反序列化
 	auto service_name = rpc_header.service_name();
 	auto method_name = rpc_header.method_name();
-	auto args_len = rpc_header.args_len();
+	auto call_id = rpc_header.call_id();
 
-	// 遍历 service_dic
-	for (auto &service : service_dic) {
-		std::cout << "service_name: " << service.first << std::endl;
+	// 追踪上下文：沿用调用方的 trace，未携带时新建
+	TraceContext trace;
+	uint64_t parent_span_id = 0;
+	if (rpc_header.trace_id() != 0) {
+		parent_span_id = rpc_header.span_id();
+		trace = Tracer::newChild({rpc_header.trace_id(), parent_span_id, rpc_header.trace_flags()});
+	} else {
+		trace = Tracer::getInstance()->newRoot();
 	}
 
 	// 找到服务
 	auto service_iter = service_dic.find(service_name);
 	if (service_iter == service_dic.end()) {
 		LOG_ERROR("service not found");
+		SendErrorResponse(session, call_id, RPC_ERR_SERVICE_NOT_FOUND, "service not found: " + service_name);
 		return;
 	}
-	auto service_info = service_iter->second;
+	auto &service_info = service_iter->second;
 	auto service = service_info.service_ptr;
 
 	// 找到服务对应的方法
 	auto method_iter = service_info.method_dic.find(method_name);
 	if (method_iter == service_info.method_dic.end()) {
 		LOG_ERROR("method not found");
+		SendErrorResponse(session, call_id, RPC_ERR_METHOD_NOT_FOUND, "method not found: " + method_name);
 		return;
 	}
-	auto method = method_iter->second;
+	if (method_iter->second.stream_handler) {
+		SendErrorResponse(session, call_id, RPC_ERR_METHOD_NOT_FOUND, "stream method must be opened as stream: " + method_name);
+		return;
+	}
+	auto method = method_iter->second.descriptor;
+	auto entry = method_iter->second.entry;
+	auto metrics = method_iter->second.metrics.get();
+	metrics->onRequest(size);
+	phases.mark(PHASE_DISPATCH);
 
-	// 方法所需的参数
-	auto request = service->GetRequestPrototype(method).New();
+	// 客户端压缩过的参数先解压
+	std::string raw_args;
+	if (frame_head.compress != COMPRESS_NONE) {
+		if (!Compress::decompress(static_cast<CompressType>(frame_head.compress), std::string(args_data), raw_args)) {
+			LOG_ERROR("decompress failed");
+			metrics->onError();
+			SendErrorResponse(session, call_id, RPC_ERR_BAD_REQUEST, "request decompress error");
+			return;
+		}
+		args_data = raw_args;
+	}
+
+	inflight_num.fetch_add(1, std::memory_order_relaxed);
+	auto call = new RpcCall();
+	call->method = method;
+	call->metrics = metrics;
+	call->recv_ns = recv_ns;
+	call->call_id = call_id;
+	call->compress = method_iter->second.compress;
+	call->accept = frame_head.accept;
+	call->peer_chunk = frame_head.flags & FRAME_FLAG_CHUNK;
+	if (!attachment.empty()) {
+		call->controller.SetReceivedAttachment(payload, attachment);
+	}
+	call->trace = trace;
+	call->parent_span_id = parent_span_id;
+	if (trace.sampled()) {
+		call->start_us = Tracer::nowUs();
+	}
 
-	if (!request->ParseFromString(args_data)) {
+	// 标记了 (tinyrpc.cache_ttl_ms) 的方法先查响应缓存，命中时不解析参数、不执行业务方法也不序列化响应；带附件的请求不缓存
+	if (method_iter->second.cache_ttl_ms > 0 && attachment.empty() && args_data.size() <= kMaxCacheArgs) {
+		call->cache_key = RequestCoalescer::makeKey(service_name, method_name, args_data);
+		call->cache_ttl_ms = method_iter->second.cache_ttl_ms;
+		if (auto body = response_cache.Get(call->cache_key)) {
+			metrics->onCacheHit();
+			call->phases = phases;
+			call->phases.mark(PHASE_REQUEST);
+			SendSerializedResponse(session, call, *body, {});
+			return;
+		}
+	}
+
+	// 标记了 (tinyrpc.coalesce) 的方法：与进行中的相同请求合并，不解析参数也不执行业务方法；带附件的请求不合并
+	if (method_iter->second.coalesce && attachment.empty() && args_data.size() <= kMaxCoalesceArgs) {
+		call->coalesce_key = call->cache_key.empty() ? RequestCoalescer::makeKey(service_name, method_name, args_data)
+													 : call->cache_key;
+		call->phases = phases;
+		call->phases.mark(PHASE_REQUEST);
+		bool leader = coalescer.Join(call->coalesce_key, [this, session, call](const CoalescedResult &result) {
+		  SendCoalescedResponse(session, call, result);
+		});
+		if (!leader) {
+			metrics->onCoalesced();
+			return;
+		}
+	}
+
+	// 方法所需的参数，生成的骨架直接构造具体类型
+	auto request = entry != nullptr ? entry->new_request() : service->GetRequestPrototype(method).New();
+	call->request = request;
+	if (!request->ParseFromArray(args_data.data(), static_cast<int>(args_data.size()))) {
 		LOG_ERROR("ParseFromString failed");
+		metrics->onError();
+		inflight_num.fetch_sub(1, std::memory_order_relaxed);
+		if (!call->coalesce_key.empty()) {
+			coalescer.Finish(call->coalesce_key, CoalescedResult{RPC_ERR_BAD_REQUEST, "request parse error", {}, {}});
+		}
+		delete request;
+		delete call;
+		SendErrorResponse(session, call_id, RPC_ERR_BAD_REQUEST, "request parse error");
 		return;
 	}
 
-	auto response = service->GetResponsePrototype(method).New();
+	phases.mark(PHASE_REQUEST);
+	call->phases = phases;
+	call->response = entry != nullptr ? entry->new_response() : service->GetResponsePrototype(method).New();
+	auto response = call->response;
 
 	// 调用服务提供的方法
-	auto done = google::protobuf::NewCallback<RpcProvider, const hv::SocketChannelPtr &, google::protobuf::Message *>(
-		this, &RpcProvider::SendRpcResponse, conn, response);
-
-#if 1
-	// 打印服务名、方法名、参数
-	std::cout << "service_name: " << service_name << std::endl;
-	std::cout << "method_name: " << method_name << std::endl;
-	std::cout << "method_args: " << request->SerializeAsString() << std::endl;
-#endif
-	service->CallMethod(method, nullptr, request, response, done);        // 调用提供的 rpc 服务，其内部会调用本地 rpc 服务
+	auto done = google::protobuf::NewCallback<RpcProvider, const RpcSessionPtr &, RpcCall *>(
+		this, &RpcProvider::SendRpcResponse, session, call);
+
+	call->handler_start_ns = nowNs();
+	metrics->recordQueueTime(call->handler_start_ns - recv_ns);
+	TraceScope trace_scope(trace);    // 业务方法中发起的下游调用沿用该上下文
+	if (entry != nullptr) {
+		entry->invoke(service_info.skeleton, &call->controller, request, response, done);
+	} else {
+		service->CallMethod(method, &call->controller, request, response, done);        // 调用提供的 rpc 服务，其内部会调用本地 rpc 服务
+	}
+
+}
+
+void RpcProvider::SendRpcResponse(const RpcSessionPtr &session, RpcCall *call) {
+	call->phases.mark(PHASE_HANDLER);
+	auto serialize_start_ns = nowNs();
+	inflight_num.fetch_sub(1, std::memory_order_relaxed);
+	auto metrics = call->metrics;
+	metrics->recordHandlerTime(serialize_start_ns - call->handler_start_ns);
+
+	std::unique_ptr<RpcCall> call_guard(call);
+	std::unique_ptr<google::protobuf::Message> request_guard(call->request);
+	std::unique_ptr<google::protobuf::Message> response_guard(call->response);
+
+	// 业务方法调用了 SetFailed：与本地调用一致，调用方（以及合并的等待者）收到错误文本，不序列化未填完的响应，也不缓存
+	if (call->controller.Failed()) {
+		auto result = RequestCoalescer::makeResult(call->controller, *call->response);
+		if (!call->coalesce_key.empty()) {
+			coalescer.Finish(call->coalesce_key, result);
+		}
+		metrics->onError();
+		SendErrorResponse(session, call->call_id, result.error_code, result.error_text);
+		FinishSpan(call, result.error_code);
+		return;
+	}
+
+	if (!call->response->IsInitialized()) {
+		LOG_ERROR("response missing required fields: {}", call->response->InitializationErrorString());
+		if (!call->coalesce_key.empty()) {
+			coalescer.Finish(call->coalesce_key, CoalescedResult{RPC_ERR_INTERNAL, "response serialize error", {}, {}});
+		}
+		metrics->onError();
+		SendErrorResponse(session, call->call_id, RPC_ERR_INTERNAL, "response serialize error");
+		FinishSpan(call, RPC_ERR_INTERNAL);
+		return;
+	}
+
+	auto &frame = frameBuffer();
+	if (!call->coalesce_key.empty() || !call->cache_key.empty()) {
+		// 序列化一次，等待者按各自的 call_id 与编码打包；成功且不带附件的响应写入缓存
+		auto result = RequestCoalescer::makeResult(call->controller, *call->response);
+		if (!call->cache_key.empty()) {
+			response_cache.Store(call->cache_key, result, call->cache_ttl_ms);
+		}
+		if (!call->coalesce_key.empty()) {
+			coalescer.Finish(call->coalesce_key, result);
+		}
+		packSerializedResponse(frame, call->call_id, result.body, call->compress, call->accept, result.attachment);
+	} else {
+		packResponse(frame, call->call_id, RPC_OK, "", call->response, call->compress, call->accept,
+					 call->controller.Attachment());
+	}
+	metrics->recordSerializeTime(nowNs() - serialize_start_ns);
+	WriteResponse(session, call, frame);
+}
+
+void RpcProvider::SendCoalescedResponse(const RpcSessionPtr &session, RpcCall *call, const CoalescedResult &result) {
+	if (result.error_code != RPC_OK) {
+		std::unique_ptr<RpcCall> call_guard(call);
+		call->phases.mark(PHASE_HANDLER);
+		inflight_num.fetch_sub(1, std::memory_order_relaxed);
+		call->metrics->onError();
+		SendErrorResponse(session, call->call_id, result.error_code, result.error_text);
+		FinishSpan(call, result.error_code);
+		return;
+	}
+	SendSerializedResponse(session, call, result.body, result.attachment);
+}
+
+void RpcProvider::SendSerializedResponse(const RpcSessionPtr &session, RpcCall *call, const std::string &body,
+										 std::string_view attachment) {
+	std::unique_ptr<RpcCall> call_guard(call);
+	call->phases.mark(PHASE_HANDLER);
+	inflight_num.fetch_sub(1, std::memory_order_relaxed);
+	auto &frame = frameBuffer();
+	packSerializedResponse(frame, call->call_id, body, call->compress, call->accept, attachment);
+	WriteResponse(session, call, frame);
+}
+
+void RpcProvider::WriteResponse(const RpcSessionPtr &session, RpcCall *call, const std::string &frame) {
+	auto metrics = call->metrics;
+	// 客户端能重组时大响应分片发送，否则不能超过单帧上限
+	bool chunked = call->peer_chunk && frame.size() > chunkSize() && frame.size() <= maxMessageSize();
+	if (!chunked && frame.size() > std::min<size_t>(session->MaxFrameSize(), DEFAULT_PACKAGE_MAX_LENGTH)) {
+		LOG_ERROR("response too large for transport: {} bytes", frame.size());
+		metrics->onError();
+		SendErrorResponse(session, call->call_id, RPC_ERR_INTERNAL, "response too large for transport");
+		FinishSpan(call, RPC_ERR_INTERNAL);
+		return;
+	}
+	metrics->onResponse(frame.size());
+	call->phases.mark(PHASE_SERIALIZE);
+
+	// 连接保持，客户端在同一连接上继续发送请求
+	if (!chunked) {
+		session->Write(frame);
+	} else if (!session->WriteChunked(frame)) {
+		LOG_ERROR("response too large for transport: {} bytes", frame.size());
+		metrics->onError();
+		SendErrorResponse(session, call->call_id, RPC_ERR_INTERNAL, "response too large for transport");
+		FinishSpan(call, RPC_ERR_INTERNAL);
+		return;
+	}
+	call->phases.mark(PHASE_WRITE);
+	FinishSpan(call, RPC_OK);
+	CheckSlow(session, call);
+}
+
+/**
+ * @brief 总耗时超过 slow_request_ms 的请求，按阶段输出耗时到慢请求日志
+ */
+void RpcProvider::CheckSlow(const RpcSessionPtr &session, const RpcCall *call) {
+	const auto &phases = call->phases;
+	auto slow_ticks = slow_threshold_ticks.load(std::memory_order_relaxed);
+	if (slow_ticks == 0 || phases.marks[PHASE_WRITE] - phases.start < slow_ticks) {
+		return;
+	}
+
+	static const char *kPhaseNames[PHASE_COUNT] = {
+		"unpack", "header", "dispatch", "request", "handler", "serialize", "write"
+	};
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	auto prev = phases.start;
+	for (int i = 0; i < PHASE_COUNT; i++) {
+		oss << " " << kPhaseNames[i] << "=" << static_cast<double>(ticksToNs(phases.marks[i] - prev)) / 1000 << "us";
+		prev = phases.marks[i];
+	}
+	auto total_us = static_cast<double>(ticksToNs(phases.marks[PHASE_WRITE] - phases.start)) / 1000;
+	char trace_id[17];
+	snprintf(trace_id, sizeof(trace_id), "%016" PRIx64, call->trace.trace_id);
+	LOG_SLOW("{} call_id={} peer={} trace_id={} total={}us{}", call->method->full_name(), call->call_id,
+			 session->PeerAddr(), trace_id, total_us, oss.str());
+}
+
+/**
+ * @brief 采样的请求提交服务端 span，未采样时直接返回
+ */
+void RpcProvider::FinishSpan(const RpcCall *call, int status) {
+	if (!call->trace.sampled()) {
+		return;
+	}
+	SpanRecord span;
+	span.trace_id = call->trace.trace_id;
+	span.span_id = call->trace.span_id;
+	span.parent_span_id = call->parent_span_id;
+	span.start_us = call->start_us;
+	span.duration_ns = nowNs() - call->recv_ns;
+	span.status = status;
+	span.kind = SpanKind::SERVER;
+	span.setName(call->method->full_name());
+	Tracer::getInstance()->submit(span);
+}
 
+void RpcProvider::SendErrorResponse(const RpcSessionPtr &session, uint64_t call_id, int error_code,
+									const std::string &error_text) {
+	auto &frame = frameBuffer();
+	packResponse(frame, call_id, error_code, error_text, nullptr);
+	session->Write(frame);
+}
+
+/**
+ * @brief 汇总各方法的统计数据
+ * @return "服务名.方法名" -> 统计快照
+ */
+MethodMetricsList RpcProvider::CollectMetrics() const {
+	MethodMetricsList result;
+	for (const auto &service : service_dic) {
+		for (const auto &method : service.second.method_dic) {
+			result.emplace_back(service.first + "." + method.first, method.second.metrics->snapshot());
+		}
+	}
+	return result;
 }
 
-void RpcProvider::SendRpcResponse(const hv::SocketChannelPtr &conn, google::protobuf::Message *response) {
-	std::string response_str;
-	std::cout << "response: " << response->DebugString() << std::endl;
-	if (!response->SerializeToString(&response_str)) {
-		LOG_ERROR("SerializeToString failed");
+std::map<std::string, std::vector<std::string>> RpcProvider::ServiceList() const {
+	std::map<std::string, std::vector<std::string>> result;
+	for (const auto &service : service_dic) {
+		auto &methods = result[service.first];
+		for (const auto &method : service.second.method_dic) {
+			methods.push_back(method.first);
+		}
+	}
+	return result;
+}
+
+void TcpSession::Write(const std::string &frame) {
+	if (!coalesce || loop == nullptr) {
+		channel->write(frame);
 		return;
 	}
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		pending.append(frame);
+		if (flush_queued) {
+			return;
+		}
+		flush_queued = true;
+	}
+	// 排在本轮已就绪的事件之后执行，期间其他请求的响应都会追加到 pending
+	loop->queueInLoop([self = shared_from_this()]() { self->Flush(); });
+}
 
-	conn->write(HvProtocol::packMessageAsString(response_str));
-	conn->close();
+void TcpSession::Flush() {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		flushing.swap(pending);
+		flush_queued = false;
+	}
+	if (!flushing.empty()) {
+		channel->write(flushing);
+		flushing.clear();
+	}
+}
+
+bool TcpSession::WriteChunked(const std::string &frame) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		chunk_writer.add(frame);
+	}
+	chunk_pending.store(true, std::memory_order_release);
+	loop->runInLoop([self = shared_from_this()]() { self->Pump(); });
+	return true;
+}
+
+void TcpSession::OnWriteComplete() {
+	if (chunk_pending.load(std::memory_order_acquire)) {
+		Pump();
+	}
+}
+
+/**
+ * @brief 写缓冲中积压不到一个分片时才写入下一片，其余帧可以插在分片之间发出；写完成回调中继续
+ */
+void TcpSession::Pump() {
+	if (pumping) {
+		return;    // 写入时同步触发的写完成回调
+	}
+	pumping = true;
+	Flush();
+	std::string chunk;
+	auto limit = chunkSize();
+	while (channel->isConnected() && channel->writeBufsize() < limit) {
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			if (!chunk_writer.next(chunk)) {
+				chunk_pending.store(false, std::memory_order_release);
+				break;
+			}
+		}
+		channel->write(chunk);
+	}
+	pumping = false;
+}
+
+void TcpSession::Close() {
+	if (!coalesce || loop == nullptr) {
+		channel->close();
+		return;
+	}
+	// 先发出已合并的响应再关闭
+	loop->runInLoop([self = shared_from_this()]() {
+	  self->Flush();
+	  self->channel->close();
+	});
 }
 
 void RpcProvider::OnConnection(const hv::SocketChannelPtr &conn) {
 	std::string peerAddr = conn->peeraddr();
 	if (conn->isConnected()) {
+		auto session = conn->newContextPtr<TcpSession>();
+		session->channel = conn;
+		session->loop = currentThreadEventLoop;    // 回调在连接所在的 IO 线程中执行
+		session->coalesce = write_coalesce;
+		if (idle_timeout_ms > 0) {
+			conn->setKeepaliveTimeout(idle_timeout_ms);    // 超过该时间没有读写（含心跳）即由事件循环关闭
+		}
+		connection_num.fetch_add(1, std::memory_order_relaxed);
 		printf("%s connected! conn_fd=%d\n", peerAddr.c_str(), conn->fd());
 	} else {
+		auto session = conn->getContextPtr<TcpSession>();
+		if (session) {
+			session->NotifyClosed();
+		}
+		conn->deleteContextPtr();    // TcpSession 持有 channel，断开时释放以解除循环引用
+		connection_num.fetch_sub(1, std::memory_order_relaxed);
 		printf("%s disconnected! conn_fd=%d\n", peerAddr.c_str(), conn->fd());
 	}
 }
\ No newline at end of file
@@ -11,27 +11,200 @@
 #ifndef TINYRPC_SRC_RPC_RPCPROVIDER_H_
 #define TINYRPC_SRC_RPC_RPCPROVIDER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <google/protobuf/service.h>
 #include <google/protobuf/descriptor.h>
+#include <vector>
 #include <hv/TcpServer.h>
+#include "RpcMetrics.h"
+#include "RpcAdmin.h"
+#include "RpcController.h"
+#include "RpcSession.h"
+#include "RpcSkeleton.h"
+#include "RpcStream.h"
+#include "RequestCoalescer.h"
+#include "ResponseCache.h"
+#include "ShmTransport.h"
+#include "utils/Trace.h"
+#include "utils/Clock.h"
+#include "utils/Compress.h"
+
+// 服务端处理一个请求的各个阶段，用于慢请求日志
+enum RpcPhase {
+  PHASE_UNPACK,       // 拆包
+  PHASE_HEADER,       // 解析 RpcHeader
+  PHASE_DISPATCH,     // 查找服务与方法
+  PHASE_REQUEST,      // 解析请求参数
+  PHASE_HANDLER,      // 执行业务方法
+  PHASE_SERIALIZE,    // 序列化并打包响应
+  PHASE_WRITE,        // 写入连接
+  PHASE_COUNT
+};
+
+// 记录各阶段结束时刻（fastTicks），只在判定为慢请求时才换算成时间
+struct PhaseTimer {
+  uint64_t start = 0;
+  uint64_t marks[PHASE_COUNT] = {0};
+
+  void begin() { start = fastTicks(); }
+  void mark(RpcPhase phase) { marks[phase] = fastTicks(); }
+};
+
+// libhv 连接（TCP/UDS）的会话，保存在 Channel 的 context 中，断开时释放；
+// coalesce 为 true 时，同一轮事件循环中写入的响应先追加到 pending，在循环末尾合并为一次 write
+class TcpSession : public RpcSession, public std::enable_shared_from_this<TcpSession> {
+ public:
+  void Write(const std::string &frame) override;
+  void Close() override;
+  std::string PeerAddr() override { return channel->peeraddr(); }
+  // 分片在事件循环中按写缓冲的余量逐片写入
+  bool WriteChunked(const std::string &frame) override;
+  void OnWriteComplete();
+ private:
+  void Flush();
+  void Pump();
+ public:
+  hv::SocketChannelPtr channel;
+  hv::EventLoop *loop = nullptr;    // 连接所在的事件循环
+  bool coalesce = false;
+ private:
+  std::mutex mtx;
+  std::string pending;
+  bool flush_queued = false;
+  std::string flushing;    // 只在事件循环线程中使用，与 pending 交换以复用两者的容量
+  ChunkWriter chunk_writer{chunkSize()};
+  std::atomic<bool> chunk_pending = false;
+  bool pumping = false;    // 只在事件循环线程中使用
+};
+
+// 一次 RPC 调用在服务端的上下文，由 OnMessage 创建，SendRpcResponse 回收
+struct RpcCall {
+  const google::protobuf::MethodDescriptor *method = nullptr;
+  google::protobuf::Message *request = nullptr;
+  google::protobuf::Message *response = nullptr;
+  MethodMetrics *metrics = nullptr;
+  uint64_t call_id = 0;
+  CompressType compress = COMPRESS_NONE;    // 该方法配置的响应编码
+  uint8_t accept = 0;                       // 客户端可解码的编码集合
+  bool peer_chunk = false;                  // 客户端能重组分片帧
+  uint64_t recv_ns = 0;             // 收到完整数据包的时间
+  uint64_t handler_start_ns = 0;    // 开始执行业务方法的时间
+  TraceContext trace;               // 服务端 span 的上下文
+  uint64_t parent_span_id = 0;
+  uint64_t start_us = 0;            // 仅采样时记录
+  PhaseTimer phases;
+  RpcController controller;         // 交给业务方法，携带请求/响应附件
+  std::string coalesce_key;         // 非空表示该请求是合并请求的 leader，完成时把结果交给等待者
+  std::string cache_key;            // 非空表示缓存未命中，完成时把响应写入缓存
+  uint32_t cache_ttl_ms = 0;
+};
 
 class RpcProvider {
  public:
+  ~RpcProvider();
   void NotifyService(google::protobuf::Service *service);
+  // 注册 protoc-gen-tinyrpc 生成的服务骨架，请求按其分发表直接调用，不经过反射
+  bool NotifyService(RpcSkeleton *service);
+  // 把已注册服务中的一个方法改为流式方法，须在 NotifyService 之后调用；方法的参数/返回类型即流中两个方向的消息类型
+  bool NotifyStream(const std::string &service_name, const std::string &method_name, StreamHandler handler);
+  // 启动服务并阻塞，直到 Stop()、SIGTERM/SIGINT、标准输入回车，或监听套接字移交给新进程；
+  // 之后排空：从注册中心摘除 → 停止 accept → 等待进行中的调用与流结束（最长 drain_timeout_ms） → 关闭
   void Run();
+  // 线程安全，只通知 Run 开始排空，不等待
+  void Stop();
   void OnConnection(const hv::SocketChannelPtr &conn);
   void OnMessage(const hv::SocketChannelPtr &conn, hv::Buffer *buf);
-  void SendRpcResponse(const hv::SocketChannelPtr &conn, google::protobuf::Message *response);
+  // 处理一个完整的请求帧，TCP/UDS 与共享内存传输共用
+  void Dispatch(const RpcSessionPtr &session, const char *data, size_t size);
+  // 批量请求帧：逐个分发内层请求，响应合并为一个批量响应帧
+  void DispatchBatch(const RpcSessionPtr &session, const std::string &body);
+  // 流帧：STREAM_OPEN 创建流并在独立线程中执行处理函数，其余帧转交给对应的流
+  void DispatchStream(const RpcSessionPtr &session, const std::string &body);
+  void SendRpcResponse(const RpcSessionPtr &session, RpcCall *call);
+  // 合并到进行中请求的等待者：按自己的 call_id 与编码打包 leader 的结果，call 在此释放
+  void SendCoalescedResponse(const RpcSessionPtr &session, RpcCall *call, const CoalescedResult &result);
+  // 发送已序列化的响应（合并结果或缓存），call 在此释放
+  void SendSerializedResponse(const RpcSessionPtr &session, RpcCall *call, const std::string &body,
+							  std::string_view attachment);
+  void FinishSpan(const RpcCall *call, int status);
+  void CheckSlow(const RpcSessionPtr &session, const RpcCall *call);
+  void SendErrorResponse(const RpcSessionPtr &session, uint64_t call_id, int error_code,
+						 const std::string &error_text);
+  // 打包响应帧到 frame（复用其容量），消息体直接序列化到帧中；达到阈值且客户端支持时按 compress 压缩，附件原样追加在消息体之后
+  static void packResponse(std::string &frame, uint64_t call_id, int error_code, const std::string &error_text,
+						   const google::protobuf::Message *body, CompressType compress = COMPRESS_NONE,
+						   uint8_t accept = 0, std::string_view attachment = {});
+  // 同上，消息体已经序列化
+  static void packSerializedResponse(std::string &frame, uint64_t call_id, const std::string &body,
+									 CompressType compress, uint8_t accept, std::string_view attachment);
+  // 读取时合并各线程分片，key 为 "服务名.方法名"
+  MethodMetricsList CollectMetrics() const;
+  // 以下供管理端口查询运行状态
+  size_t ConnectionNum() const {
+	  return connection_num.load(std::memory_order_relaxed) + (shm_listener ? shm_listener->SessionNum() : 0);
+  }
+  size_t InflightNum() const { return inflight_num.load(std::memory_order_relaxed); }
+  bool Draining() const { return draining.load(std::memory_order_relaxed); }
+  size_t ResponseCacheSize() const { return response_cache.Size(); }
+  size_t ResponseCacheBytes() const { return response_cache.Bytes(); }
+  const std::string &Address() const { return ip_port; }
+  std::map<std::string, std::vector<std::string>> ServiceList() const;
  private:
-  unpack_setting_t *server_unpack_setting;
+  unpack_setting_t server_unpack_setting;
+  std::string ip_port;
+  std::atomic<size_t> connection_num = 0;
+  std::atomic<size_t> inflight_num = 0;    // 已收到请求但尚未发送响应
+  std::unique_ptr<RpcAdmin> admin;
+  std::unique_ptr<ShmListener> shm_listener;
+  std::atomic<uint64_t> slow_threshold_ticks = 0;    // 0 表示不记录慢请求，配置项 slow_request_ms 可热更新
+  uint64_t slow_watch_id = 0;
+  uint64_t cache_watch_id = 0;
+  std::atomic<bool> draining = false;
+  bool stop_requested = false;
+  std::mutex stop_mtx;
+  std::condition_variable stop_cv;
+  void WaitStop();
+  // 等待进行中的调用与流结束，超时返回 false
+  bool WaitIdle(int64_t timeout_ms);
+  bool write_coalesce = true;
+  int idle_timeout_ms = 0;    // 配置项 server_idle_timeout_ms，0 表示不回收，只作用于 libhv 的 TCP/UDS 连接
+  struct MethodInfo {
+	const google::protobuf::MethodDescriptor *descriptor;
+	std::unique_ptr<MethodMetrics> metrics;
+	CompressType compress;    // 配置项 compress.<服务名>.<方法名>
+	StreamHandler stream_handler;    // 非空表示流式方法
+	const RpcMethodEntry *entry;     // 生成的骨架中该方法的分发入口，非骨架服务为 nullptr
+	bool coalesce;                   // 方法选项 (tinyrpc.coalesce)
+	uint32_t cache_ttl_ms;           // 方法选项 (tinyrpc.cache_ttl_ms)，0 表示不缓存
+  };
   struct ServiceInfo {
-	google::protobuf::Service *service_ptr;
-	std::unordered_map<std::string, const google::protobuf::MethodDescriptor *> method_dic;
+	google::protobuf::Service *service_ptr = nullptr;
+	RpcSkeleton *skeleton = nullptr;
+	std::unordered_map<std::string, MethodInfo> method_dic;
   };
   std::unordered_map<std::string, ServiceInfo> service_dic;    // 存储所有注册的 RPC 服务，方便后续根据服务名找到对应的方法
+  RequestCoalescer coalescer;
+  ResponseCache response_cache;    // 配置项 response_cache_bytes
+  // 打包好的响应检查大小后写入连接，并记录统计、span 与慢请求
+  void WriteResponse(const RpcSessionPtr &session, RpcCall *call, const std::string &frame);
+  void UnregisterStream(RpcSession *session, const ServerStreamPtr &stream);
+  void AbortStreams(RpcSession *session);
+  // 终止全部进行中的流并等待处理线程退出，Run 返回前调用
+  void CancelStreams();
+  std::mutex stream_mtx;
+  std::map<std::pair<RpcSession *, uint64_t>, ServerStreamPtr> streams;    // 进行中的流，按 (会话, stream_id) 索引
+  // 流处理线程，以下成员受 stream_mtx 保护；线程结束时把自己移入 exited_stream_threads，下一次打开流时 join
+  bool streams_closed = false;    // CancelStreams 之后不再打开新的流
+  uint64_t next_stream_thread = 0;
+  std::unordered_map<uint64_t, std::thread> stream_threads;
+  std::vector<std::thread> exited_stream_threads;
 };
 
 #endif //TINYRPC_SRC_RPC_RPCPROVIDER_H_
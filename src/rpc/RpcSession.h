@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : RpcSession.h
+  * @author         : xy
+  * @brief          : 服务端的一条客户端会话，RpcProvider 通过它回复响应，与具体传输方式无关
+  * @attention      : 各传输方式分别实现：TcpSession（libhv，见 RpcProvider.h）、ShmSession、UringSession
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCSESSION_H_
+#define TINYRPC_SRC_RPC_RPCSESSION_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "utils/Chunk.h"
+
+class RpcSession {
+ public:
+  virtual ~RpcSession() = default;
+  // 线程安全
+  virtual void Write(const std::string &frame) = 0;
+  virtual void Close() = 0;
+  virtual std::string PeerAddr() = 0;
+  // 单帧的最大长度，超过时应改为回复错误
+  virtual size_t MaxFrameSize() const { return SIZE_MAX; }
+  // 发送超过 chunkSize() 的帧：拆成分片帧依次写入；返回 false 表示该传输方式不支持分片
+  virtual bool WriteChunked(const std::string &frame) {
+	  ChunkWriter writer(chunkSize());
+	  writer.add(frame);
+	  std::string chunk;
+	  while (writer.next(chunk)) {
+		  Write(chunk);
+	  }
+	  return true;
+  }
+  // 接收方向的分片重组状态，只在分发该会话请求的线程中使用
+  ChunkAssembler &Chunks() {
+	  if (!chunks) {
+		  chunks = std::make_unique<ChunkAssembler>(maxMessageSize(), 2 * maxMessageSize());
+	  }
+	  return *chunks;
+  }
+  // 会话断开时调用一次（用于终止其上的流）；已断开时立即调用
+  void SetCloseHook(std::function<void()> hook) {
+	  {
+		  std::lock_guard<std::mutex> lock(hook_mtx);
+		  if (!closed) {
+			  close_hook = std::move(hook);
+			  return;
+		  }
+	  }
+	  hook();
+  }
+  // 由各传输方式在连接断开时调用
+  void NotifyClosed() {
+	  std::function<void()> hook;
+	  {
+		  std::lock_guard<std::mutex> lock(hook_mtx);
+		  closed = true;
+		  hook.swap(close_hook);
+	  }
+	  if (hook) {
+		  hook();
+	  }
+  }
+ private:
+  std::mutex hook_mtx;
+  bool closed = false;
+  std::function<void()> close_hook;
+  std::unique_ptr<ChunkAssembler> chunks;
+};
+
+using RpcSessionPtr = std::shared_ptr<RpcSession>;
+
+#endif //TINYRPC_SRC_RPC_RPCSESSION_H_
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file           : RpcSkeleton.h
+  * @author         : xy
+  * @brief          : protoc-gen-tinyrpc 生成的服务端骨架的基类与分发表
+  * @attention      : 生成代码为每个服务编译期构建一张方法表，RpcProvider 按表直接创建参数/响应并调用类型化的方法，
+  *                   请求路径上不再经过 GetRequestPrototype / CallMethod 的反射与 down_cast
+  * @date           : 2025/4/7
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCSKELETON_H_
+#define TINYRPC_SRC_RPC_RPCSKELETON_H_
+
+#include <cstddef>
+#include <google/protobuf/message.h>
+#include <google/protobuf/service.h>
+#include "RpcController.h"
+
+class RpcSkeleton;
+
+// 分发表中的一个方法
+struct RpcMethodEntry {
+  const char *name;
+  google::protobuf::Message *(*new_request)();
+  google::protobuf::Message *(*new_response)();
+  void (*invoke)(RpcSkeleton *service, RpcController *controller, const google::protobuf::Message *request,
+				 google::protobuf::Message *response, google::protobuf::Closure *done);
+};
+
+struct RpcServiceTable {
+  const char *full_name;    // 含 package 的服务名，注册时用于查找描述信息
+  const RpcMethodEntry *methods;
+  size_t method_count;
+};
+
+class RpcSkeleton {
+ public:
+  virtual ~RpcSkeleton() = default;
+  virtual const RpcServiceTable &DispatchTable() const = 0;
+};
+
+#endif //TINYRPC_SRC_RPC_RPCSKELETON_H_
@@ -0,0 +1,245 @@
+/**
+  ******************************************************************************
+  * @file           : RpcStream.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/4
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <cstring>
+#include "RpcStream.h"
+#include "RpcErrorCode.h"
+#include "utils/Compress.h"
+#include "utils/Config.h"
+#include "utils/HvProtocol.h"
+#include "utils/Log.h"
+
+constexpr size_t kDefaultStreamWindow = 256 * 1024;
+
+std::string packStreamFrame(uint64_t stream_id, StreamKind kind, const std::string &payload) {
+	std::string frame(FRAME_HEAD_LENGTH + STREAM_HEAD_LENGTH, '\0');
+	for (int i = 0; i < 8; i++) {
+		frame[FRAME_HEAD_LENGTH + i] = static_cast<char>(stream_id >> (56 - 8 * i));
+	}
+	frame[FRAME_HEAD_LENGTH + 8] = static_cast<char>(kind);
+	frame.append(payload);
+
+	FrameHead head;
+	head.type = FRAME_STREAM;
+	head.flags = HvProtocol::defaultFlags();
+	head.accept = kSupportedCompress;
+	HvProtocol::finishFrame(head, frame);
+	return frame;
+}
+
+bool parseStreamFrame(const std::string &body, uint64_t &stream_id, StreamKind &kind, std::string &payload) {
+	if (body.size() < STREAM_HEAD_LENGTH) {
+		return false;
+	}
+	stream_id = 0;
+	for (int i = 0; i < 8; i++) {
+		stream_id = stream_id << 8 | static_cast<uint8_t>(body[i]);
+	}
+	kind = static_cast<StreamKind>(body[8]);
+	payload.assign(body, STREAM_HEAD_LENGTH, std::string::npos);
+	return true;
+}
+
+std::string packStreamStatus(int error_code, const std::string &error_text) {
+	std::string payload(4, '\0');
+	auto code = htonl(static_cast<uint32_t>(error_code));
+	memcpy(payload.data(), &code, sizeof(code));
+	return payload + error_text;
+}
+
+static uint32_t readU32(const std::string &payload) {
+	uint32_t value = 0;
+	if (payload.size() >= 4) {
+		memcpy(&value, payload.data(), sizeof(value));
+	}
+	return ntohl(value);
+}
+
+std::string packStreamOpen(uint32_t window, const std::string &header) {
+	std::string payload(4, '\0');
+	auto value = htonl(window);
+	memcpy(payload.data(), &value, sizeof(value));
+	return payload + header;
+}
+
+bool parseStreamOpen(const std::string &payload, uint32_t &window, std::string &header) {
+	if (payload.size() < 4) {
+		return false;
+	}
+	window = readU32(payload);
+	header.assign(payload, 4, std::string::npos);
+	return true;
+}
+
+size_t streamWindow() {
+	static size_t window = [] {
+	  auto value = Config::getInstance()->get("stream_window_kb");
+	  return value == std::nullopt ? kDefaultStreamWindow : std::stoul(value.value()) * 1024;
+	}();
+	return window;
+}
+
+RpcStream::RpcStream(uint64_t id, Sender sender, size_t recv_window, size_t send_window)
+	: id(id), sender(std::move(sender)), recv_window(recv_window), send_window(static_cast<int64_t>(send_window)) {}
+
+bool RpcStream::Read(google::protobuf::Message *message) {
+	std::string data;
+	size_t ack = 0;
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv.wait(lock, [this]() { return !inbox.empty() || remote_done || reset; });
+		if (reset || inbox.empty()) {
+			return false;
+		}
+		data.swap(inbox.front());
+		inbox.pop_front();
+		consumed += data.size();
+		// 消费过半窗口后再回送，避免每条消息都产生一个窗口帧
+		if (consumed >= recv_window / 2 && !remote_done) {
+			ack = consumed;
+			consumed = 0;
+		}
+	}
+	if (ack > 0) {
+		sender(packStreamFrame(id, STREAM_WINDOW, packStreamStatus(static_cast<int>(ack), "")));
+	}
+	return message->ParseFromString(data);
+}
+
+bool RpcStream::Write(const google::protobuf::Message &message) {
+	auto data = message.SerializeAsString();
+	if (data.size() > kMaxStreamMessage) {
+		LOG_ERROR("stream message too large: {} bytes", data.size());
+		return false;
+	}
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv.wait(lock, [this]() { return send_window > 0 || reset || local_done; });
+		if (reset || local_done) {
+			return false;
+		}
+		// 窗口只要为正就允许发送，单条消息可以超出剩余窗口
+		send_window -= static_cast<int64_t>(data.size());
+	}
+	sender(packStreamFrame(id, STREAM_MESSAGE, data));
+	return true;
+}
+
+void RpcStream::Cancel(const std::string &reason) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (reset || (local_done && remote_done)) {
+			return;
+		}
+		reset = true;
+		error_code = RPC_ERR_CANCELLED;
+		error_text = reason;
+	}
+	cv.notify_all();
+	sender(packStreamFrame(id, STREAM_RESET, packStreamStatus(RPC_ERR_CANCELLED, reason)));
+}
+
+void RpcStream::OnFrame(StreamKind kind, const std::string &payload) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (reset) {
+			return;
+		}
+		switch (kind) {
+			case STREAM_MESSAGE:
+				if (!remote_done) {
+					inbox.push_back(payload);
+				}
+				break;
+			case STREAM_END:
+				remote_done = true;
+				if (payload.size() >= 4) {
+					error_code = static_cast<int>(readU32(payload));
+					error_text = payload.substr(4);
+				}
+				break;
+			case STREAM_WINDOW:
+				send_window += readU32(payload);
+				break;
+			case STREAM_RESET:
+				reset = true;
+				error_code = payload.size() >= 4 ? static_cast<int>(readU32(payload)) : RPC_ERR_CANCELLED;
+				error_text = payload.size() > 4 ? payload.substr(4) : "stream reset by peer";
+				break;
+			default:
+				break;
+		}
+	}
+	cv.notify_all();
+}
+
+void RpcStream::Abort(int code, const std::string &text) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (reset || (local_done && remote_done)) {
+			return;
+		}
+		reset = true;
+		error_code = code;
+		error_text = text;
+	}
+	cv.notify_all();
+}
+
+void RpcStream::SendEnd(const std::string &payload) {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		if (reset || local_done) {
+			return;
+		}
+		local_done = true;
+	}
+	cv.notify_all();
+	sender(packStreamFrame(id, STREAM_END, payload));
+}
+
+void ServerStream::Finish(int code, const std::string &text) {
+	SendEnd(packStreamStatus(code, text));
+}
+
+bool ServerStream::Finished() {
+	std::lock_guard<std::mutex> lock(mtx);
+	return local_done || reset;
+}
+
+ClientStream::~ClientStream() {
+	bool finished;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		finished = remote_done || reset;
+	}
+	if (!finished) {
+		Cancel("client stream destroyed");
+	}
+	if (on_close) {
+		on_close();
+	}
+}
+
+void ClientStream::WritesDone() {
+	SendEnd("");
+}
+
+int ClientStream::Finish(std::string *text) {
+	std::unique_lock<std::mutex> lock(mtx);
+	// 服务端的最终状态在 STREAM_END 中，此前未读取的消息直接丢弃
+	cv.wait(lock, [this]() { return remote_done || reset; });
+	inbox.clear();
+	if (text != nullptr) {
+		*text = error_text;
+	}
+	return error_code;
+}
@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file           : RpcStream.h
+  * @author         : xy
+  * @brief          : 流式调用（客户端流 / 服务端流 / 双向流），与普通请求复用同一条连接
+  * @attention      : 流帧的帧体 = stream_id(8字节, 大端) + 类型(1) + 内容，stream_id 取打开流时的 call_id
+  *                   STREAM_OPEN    客户端 -> 服务端，内容 = 客户端接收窗口(4字节) + RpcHeader
+  *                   STREAM_MESSAGE 一条消息
+  *                   STREAM_END     结束发送；服务端发出时内容为最终状态 = 错误码(4字节) + 错误信息
+  *                   STREAM_WINDOW  接收方已处理的字节数(4字节)，发送方据此增加窗口
+  *                   STREAM_RESET   终止流，内容同最终状态
+  *                   流量控制按字节计：发送方窗口用完时 Write 阻塞，接收方 Read 消费过半窗口后回送 STREAM_WINDOW，
+  *                   因此每个流在接收端缓存的数据不超过一个窗口（外加一条消息）
+  * @date           : 2025/4/4
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_RPCSTREAM_H_
+#define TINYRPC_SRC_RPC_RPCSTREAM_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <google/protobuf/message.h>
+
+enum StreamKind : uint8_t {
+  STREAM_OPEN = 0,
+  STREAM_MESSAGE = 1,
+  STREAM_END = 2,
+  STREAM_WINDOW = 3,
+  STREAM_RESET = 4,
+};
+
+constexpr size_t STREAM_HEAD_LENGTH = 9;
+constexpr size_t kMaxStreamMessage = 2 * 1024 * 1024 - 64;    // 单条消息须能放进一个帧
+
+// 打包一个完整的流帧（含帧头）
+std::string packStreamFrame(uint64_t stream_id, StreamKind kind, const std::string &payload);
+// 解析流帧的帧体，长度不足时返回 false
+bool parseStreamFrame(const std::string &body, uint64_t &stream_id, StreamKind &kind, std::string &payload);
+std::string packStreamStatus(int error_code, const std::string &error_text);
+// STREAM_OPEN 的内容 = 客户端接收窗口(4字节) + 序列化的 RpcHeader
+std::string packStreamOpen(uint32_t window, const std::string &header);
+bool parseStreamOpen(const std::string &payload, uint32_t &window, std::string &header);
+// 配置项 stream_window_kb，默认 256KB
+size_t streamWindow();
+
+class RpcStream {
+ public:
+  // 线程安全，发送一个完整的帧
+  using Sender = std::function<void(const std::string &frame)>;
+
+  RpcStream(uint64_t id, Sender sender, size_t recv_window, size_t send_window);
+  virtual ~RpcStream() = default;
+  uint64_t Id() const { return id; }
+  // 读取下一条消息；对端已结束发送或流被终止时返回 false
+  bool Read(google::protobuf::Message *message);
+  // 发送一条消息，对端窗口用完时阻塞；本端已结束发送或流被终止时返回 false
+  bool Write(const google::protobuf::Message &message);
+  // 终止流并通知对端
+  void Cancel(const std::string &reason = "cancelled");
+  // 传输层收到该流的帧时调用
+  void OnFrame(StreamKind kind, const std::string &payload);
+  // 连接断开等本地原因终止，不再通知对端
+  void Abort(int error_code, const std::string &error_text);
+ protected:
+  void SendEnd(const std::string &payload);
+ protected:
+  uint64_t id;
+  Sender sender;
+  size_t recv_window;
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::string> inbox;
+  size_t consumed = 0;           // 已读取但尚未回送窗口的字节数
+  int64_t send_window;
+  bool remote_done = false;      // 对端已结束发送
+  bool local_done = false;       // 本端已结束发送
+  bool reset = false;
+  int error_code = 0;
+  std::string error_text;
+};
+
+// 服务端的流，处理函数返回前未调用 Finish 时按成功结束
+class ServerStream : public RpcStream {
+ public:
+  using RpcStream::RpcStream;
+  // 结束流并把最终状态发给客户端
+  void Finish(int code = 0, const std::string &text = "");
+  bool Finished();
+};
+
+class ClientStream : public RpcStream {
+ public:
+  ClientStream(uint64_t id, Sender sender, size_t recv_window) : RpcStream(id, std::move(sender), recv_window, 0) {}
+  ~ClientStream() override;
+  // 客户端流：请求发送完毕
+  void WritesDone();
+  // 等待服务端结束流，返回最终错误码（RPC_OK 为成功）
+  int Finish(std::string *text = nullptr);
+  // 流结束时调用一次，用于从连接中注销
+  std::function<void()> on_close;
+};
+
+using ServerStreamPtr = std::shared_ptr<ServerStream>;
+using ClientStreamPtr = std::shared_ptr<ClientStream>;
+// 服务端流式方法的处理函数，在独立线程中执行
+using StreamHandler = std::function<void(ServerStream &stream)>;
+
+#endif //TINYRPC_SRC_RPC_RPCSTREAM_H_
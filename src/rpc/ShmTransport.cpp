@@ -0,0 +1,471 @@
+/**
+  ******************************************************************************
+  * @file           : ShmTransport.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 共享内存由客户端创建并封印大小（F_SEAL_SHRINK），避免服务端访问时被截断触发 SIGBUS
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ShmTransport.h"
+#include "RpcErrorCode.h"
+#include "utils/FdPassing.h"
+#include "utils/Log.h"
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x54525348;    // "TRSH"
+constexpr uint32_t kShmVersion = 1;
+constexpr int kHandshakeTimeoutMs = 1000;
+constexpr int kServerWriteWaitMs = 1000;      // 响应环满时最多等待客户端读取的时间
+
+// 握手消息，随 memfd、请求 eventfd、响应 eventfd 一起发送
+struct ShmHello {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+};
+
+bool validCapacity(uint64_t capacity) {
+	return capacity >= kMinShmRingSize && capacity <= kMaxShmRingSize && (capacity & (capacity - 1)) == 0;
+}
+
+void setRecvTimeout(int sock, int timeout_ms) {
+	struct timeval tv;
+	tv.tv_sec = timeout_ms / 1000;
+	tv.tv_usec = (timeout_ms % 1000) * 1000;
+	setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+bool fillAddress(const std::string &path, struct sockaddr_un &addr) {
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path)) {
+		return false;
+	}
+	memcpy(addr.sun_path, path.data(), path.size());
+	return true;
+}
+
+// 环满时让出 CPU 等待消费者读取，直到写入成功、超时或连接关闭
+bool writeRing(ShmRing &ring, int event_fd, const std::string &frame, int wait_ms, const std::atomic<bool> &closed) {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+	while (!ring.tryWrite(frame.data(), frame.size())) {
+		if (closed.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() > deadline) {
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	ring.notify(event_fd);
+	return true;
+}
+
+}
+
+std::unique_ptr<ShmRegion> ShmRegion::Create(size_t capacity) {
+	if (!validCapacity(capacity)) {
+		return nullptr;
+	}
+	std::unique_ptr<ShmRegion> region(new ShmRegion());
+	region->mem_fd = memfd_create("tinyrpc_shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	region->request_event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	region->response_event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (region->mem_fd < 0 || region->request_event < 0 || region->response_event < 0) {
+		LOG_ERROR("create shm region failed: {}", strerror(errno));
+		return nullptr;
+	}
+	auto size = 2 * ShmRing::regionSize(capacity);
+	if (ftruncate(region->mem_fd, static_cast<off_t>(size)) < 0
+		|| fcntl(region->mem_fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+		LOG_ERROR("resize shm region failed: {}", strerror(errno));
+		return nullptr;
+	}
+	if (!region->Map(capacity, true)) {
+		return nullptr;
+	}
+	return region;
+}
+
+std::unique_ptr<ShmRegion> ShmRegion::Attach(int mem_fd, int request_event, int response_event, size_t capacity) {
+	std::unique_ptr<ShmRegion> region(new ShmRegion());
+	region->mem_fd = mem_fd;
+	region->request_event = request_event;
+	region->response_event = response_event;
+
+	struct stat st;
+	auto seals = fcntl(mem_fd, F_GET_SEALS);
+	if (!validCapacity(capacity) || fstat(mem_fd, &st) < 0
+		|| static_cast<size_t>(st.st_size) != 2 * ShmRing::regionSize(capacity)
+		|| seals < 0 || !(seals & F_SEAL_SHRINK)) {
+		LOG_ERROR("attach shm region failed: bad size or seals");
+		return nullptr;
+	}
+	if (!region->Map(capacity, false)) {
+		return nullptr;
+	}
+	return region;
+}
+
+bool ShmRegion::Map(size_t capacity, bool init) {
+	size = 2 * ShmRing::regionSize(capacity);
+	auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, 0);
+	if (addr == MAP_FAILED) {
+		LOG_ERROR("mmap shm region failed: {}", strerror(errno));
+		return false;
+	}
+	memory = addr;
+	request_ring = std::make_unique<ShmRing>(memory, capacity, init);
+	response_ring = std::make_unique<ShmRing>(static_cast<char *>(memory) + ShmRing::regionSize(capacity), capacity, init);
+	return true;
+}
+
+ShmRegion::~ShmRegion() {
+	if (memory != nullptr) {
+		munmap(memory, size);
+	}
+	for (auto fd : {mem_fd, request_event, response_event}) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+}
+
+/**
+ * @brief 连接服务端的握手套接字，传递共享内存与 eventfd
+ * @param path 服务端的 rpc_shm_path
+ * @param capacity 每个环的大小
+ */
+std::unique_ptr<ShmConnection> ShmConnection::Connect(const hv::EventLoopPtr &loop, const std::string &path,
+													  size_t capacity) {
+	struct sockaddr_un addr;
+	if (!fillAddress(path, addr)) {
+		return nullptr;
+	}
+	int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock < 0) {
+		return nullptr;
+	}
+	if (connect(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		LOG_ERROR("connect shm listener {} failed: {}", path, strerror(errno));
+		close(sock);
+		return nullptr;
+	}
+
+	auto region = ShmRegion::Create(capacity);
+	if (!region) {
+		close(sock);
+		return nullptr;
+	}
+	ShmHello hello{kShmMagic, kShmVersion, capacity};
+	int fds[3] = {region->MemFd(), region->RequestEvent(), region->ResponseEvent()};
+	uint8_t ack = 0;
+	setRecvTimeout(sock, kHandshakeTimeoutMs);
+	if (sendFds(sock, &hello, sizeof(hello), fds, 3) < 0 || recv(sock, &ack, 1, 0) != 1 || ack != 1) {
+		LOG_ERROR("shm handshake with {} failed", path);
+		close(sock);
+		return nullptr;
+	}
+	setRecvTimeout(sock, 0);
+	return std::unique_ptr<ShmConnection>(new ShmConnection(loop, sock, std::move(region)));
+}
+
+ShmConnection::ShmConnection(const hv::EventLoopPtr &loop, int sock, std::unique_ptr<ShmRegion> region)
+	: loop(loop), sock(sock), region(std::move(region)) {
+	max_frame = this->region->RequestRing().maxRecord();
+	reader = std::thread([this]() { ReadLoop(); });
+}
+
+ShmConnection::~ShmConnection() {
+	closed.store(true, std::memory_order_release);
+	shutdown(sock, SHUT_RDWR);    // 唤醒阻塞在 poll 上的读线程
+	if (reader.joinable()) {
+		reader.join();
+	}
+	close(sock);
+}
+
+void ShmConnection::Send(uint64_t call_id, std::string frame, int timeout_ms, Callback callback) {
+	if (!Alive()) {
+		callback(RPC_ERR_CLOSED, "shm connection closed", "", {});
+		return;
+	}
+	if (frame.size() > max_frame) {
+		callback(RPC_ERR_BAD_REQUEST, "frame too large for shm ring", "", {});
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		pending[call_id] = PendingCall{std::move(callback), 0};
+	}
+	// 定时器只能在 loop 线程中设置；响应可能先到，此时直接取消
+	loop->runInLoop([this, call_id, timeout_ms]() {
+	  auto timer = loop->setTimeout(timeout_ms, [this, call_id](hv::TimerID) {
+		Complete(call_id, RPC_ERR_TIMEOUT, "rpc timeout", "");
+	  });
+	  std::lock_guard<std::mutex> lock(mtx);
+	  auto iter = pending.find(call_id);
+	  if (iter != pending.end()) {
+		  iter->second.timer = timer;
+	  } else {
+		  loop->killTimer(timer);
+	  }
+	});
+
+	bool written;
+	{
+		std::lock_guard<std::mutex> lock(send_mtx);
+		written = writeRing(region->RequestRing(), region->RequestEvent(), frame, timeout_ms, closed);
+	}
+	if (!written) {
+		Complete(call_id, Alive() ? RPC_ERR_TIMEOUT : RPC_ERR_CLOSED, "shm request ring full", "");
+	}
+}
+
+void ShmConnection::ReadLoop() {
+	ShmWaiter waiter;
+	auto &ring = region->ResponseRing();
+	const char *data;
+	size_t size;
+	while (!closed.load(std::memory_order_acquire)) {
+		bool broken = false;
+		while (ring.peek(data, size)) {
+			ResponseFrame frame;
+			broken = !decodeResponse(data, size, frame);
+			ring.consume();
+			if (broken) {
+				break;
+			}
+			peer_accept.store(frame.accept, std::memory_order_relaxed);
+			Complete(frame.call_id, frame.error_code, frame.error_text, frame.body, std::move(frame.attachment));
+		}
+		if (broken || ring.corrupted() || !waiter.wait(ring, region->ResponseEvent(), sock)) {
+			break;
+		}
+	}
+	closed.store(true, std::memory_order_release);
+	FailAll(RPC_ERR_CLOSED, "shm connection closed");
+}
+
+void ShmConnection::Complete(uint64_t call_id, int error_code, const std::string &error_text,
+							 const std::string &body, ResponseAttachment attachment) {
+	PendingCall call;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		auto iter = pending.find(call_id);
+		if (iter == pending.end()) {
+			return;    // 已超时的请求，响应直接丢弃
+		}
+		call = std::move(iter->second);
+		pending.erase(iter);
+	}
+	if (call.timer != 0 && error_code != RPC_ERR_TIMEOUT) {
+		auto timer = call.timer;
+		loop->runInLoop([loop = loop, timer]() { loop->killTimer(timer); });
+	}
+	call.callback(error_code, error_text, body, std::move(attachment));
+}
+
+void ShmConnection::FailAll(int error_code, const std::string &error_text) {
+	std::unordered_map<uint64_t, PendingCall> failed;
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		failed.swap(pending);
+	}
+	for (auto &item : failed) {
+		if (item.second.timer != 0) {
+			auto timer = item.second.timer;
+			loop->runInLoop([loop = loop, timer]() { loop->killTimer(timer); });
+		}
+		item.second.callback(error_code, error_text, "", {});
+	}
+}
+
+ShmSession::ShmSession(int sock, std::unique_ptr<ShmRegion> region)
+	: sock(sock), region(std::move(region)) {
+	max_frame = this->region->ResponseRing().maxRecord();
+	struct ucred cred;
+	socklen_t len = sizeof(cred);
+	if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0) {
+		peer = "shm:pid=" + std::to_string(cred.pid);
+	} else {
+		peer = "shm:fd=" + std::to_string(sock);
+	}
+}
+
+ShmSession::~ShmSession() {
+	close(sock);
+}
+
+void ShmSession::Start(Handler handler) {
+	// 线程持有会话的引用，客户端退出后线程结束并释放会话
+	std::thread([self = shared_from_this(), handler = std::move(handler)]() {
+	  self->Run(handler);
+	}).detach();
+}
+
+void ShmSession::Run(const Handler &handler) {
+	RpcSessionPtr session = shared_from_this();
+	ShmWaiter waiter;
+	auto &ring = region->RequestRing();
+	const char *data;
+	size_t size;
+	while (!closed.load(std::memory_order_acquire)) {
+		// 请求直接在共享内存中解析，处理完再释放空间
+		while (ring.peek(data, size)) {
+			handler(session, data, size);
+			ring.consume();
+		}
+		if (ring.corrupted()) {
+			LOG_ERROR("{} request ring corrupted", peer);
+			break;
+		}
+		if (!waiter.wait(ring, region->RequestEvent(), sock)) {
+			break;
+		}
+	}
+	Close();
+	NotifyClosed();
+}
+
+void ShmSession::Write(const std::string &frame) {
+	if (closed.load(std::memory_order_acquire)) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(send_mtx);
+	if (!writeRing(region->ResponseRing(), region->ResponseEvent(), frame, kServerWriteWaitMs, closed)) {
+		LOG_ERROR("{} response ring full, response dropped", peer);
+	}
+}
+
+void ShmSession::Close() {
+	closed.store(true, std::memory_order_release);
+	shutdown(sock, SHUT_RDWR);    // 客户端读线程随之退出，其等待中的请求失败
+}
+
+ShmListener::~ShmListener() {
+	Stop();
+}
+
+bool ShmListener::Start(const std::string &path, ShmSession::Handler handler) {
+	struct sockaddr_un addr;
+	if (!fillAddress(path, addr)) {
+		LOG_ERROR("shm path too long: {}", path);
+		return false;
+	}
+	listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listen_fd < 0) {
+		return false;
+	}
+	unlink(path.c_str());    // 清理上次异常退出留下的套接字文件
+	if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd, 64) < 0) {
+		LOG_ERROR("shm listener bind {} failed: {}", path, strerror(errno));
+		close(listen_fd);
+		listen_fd = -1;
+		return false;
+	}
+	struct stat path_stat;
+	path_ino = stat(path.c_str(), &path_stat) == 0 ? path_stat.st_ino : 0;
+	this->path = path;
+	this->handler = std::move(handler);
+	thread = std::thread([this]() { AcceptLoop(); });
+	return true;
+}
+
+void ShmListener::StopAccept() {
+	if (listen_fd < 0) {
+		return;
+	}
+	shutdown(listen_fd, SHUT_RDWR);    // 让阻塞的 accept 返回
+	if (thread.joinable()) {
+		thread.join();
+	}
+	close(listen_fd);
+	listen_fd = -1;
+	struct stat path_stat;
+	if (stat(path.c_str(), &path_stat) == 0 && path_stat.st_ino == path_ino) {
+		unlink(path.c_str());
+	}
+}
+
+void ShmListener::Stop() {
+	StopAccept();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	for (auto &weak : sessions) {
+		if (auto session = weak.lock()) {
+			session->Close();
+		}
+	}
+	sessions.clear();
+}
+
+size_t ShmListener::SessionNum() {
+	std::lock_guard<std::mutex> lock(mtx);
+	size_t num = 0;
+	for (const auto &weak : sessions) {
+		num += weak.expired() ? 0 : 1;
+	}
+	return num;
+}
+
+void ShmListener::AcceptLoop() {
+	while (true) {
+		int sock = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (sock < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			break;
+		}
+		Handshake(sock);
+	}
+}
+
+void ShmListener::Handshake(int sock) {
+	ShmHello hello{};
+	int fds[3];
+	setRecvTimeout(sock, kHandshakeTimeoutMs);
+	auto n = recvFds(sock, &hello, sizeof(hello), fds, 3);
+
+	std::unique_ptr<ShmRegion> region;
+	if (n == 3 && hello.magic == kShmMagic && hello.version == kShmVersion) {
+		region = ShmRegion::Attach(fds[0], fds[1], fds[2], hello.capacity);    // 失败时由 region 关闭描述符
+	} else {
+		for (int i = 0; i < n; i++) {
+			close(fds[i]);
+		}
+	}
+
+	uint8_t ack = region ? 1 : 0;
+	if (send(sock, &ack, 1, MSG_NOSIGNAL) != 1 || !region) {
+		close(sock);
+		return;
+	}
+	setRecvTimeout(sock, 0);
+
+	auto session = std::make_shared<ShmSession>(sock, std::move(region));
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		std::vector<std::weak_ptr<ShmSession>> alive;
+		for (auto &weak : sessions) {
+			if (!weak.expired()) {
+				alive.push_back(std::move(weak));
+			}
+		}
+		alive.push_back(session);
+		sessions.swap(alive);
+	}
+	session->Start(handler);
+}
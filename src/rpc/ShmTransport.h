@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file           : ShmTransport.h
+  * @author         : xy
+  * @brief          : 同机调用方的共享内存传输
+  * @attention      : 客户端创建 memfd（请求环 + 响应环）和两个 eventfd，连接服务端的握手套接字并通过 SCM_RIGHTS 传递；
+  *                   握手后该套接字只用于感知对端退出。请求与响应帧格式与 TCP 相同，环中的请求原地交给 RpcProvider 分发；
+  *                   请求环有多个调用线程写入、响应环有多个业务线程写入，生产者一侧各用一把锁串行化
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_SHMTRANSPORT_H_
+#define TINYRPC_SRC_RPC_SHMTRANSPORT_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+#include <hv/EventLoop.h>
+#include "ClientTransport.h"
+#include "RpcSession.h"
+#include "utils/ShmRing.h"
+
+constexpr size_t kDefaultShmRingSize = 4 * 1024 * 1024;
+constexpr size_t kMinShmRingSize = 64 * 1024;
+constexpr size_t kMaxShmRingSize = 256 * 1024 * 1024;
+
+// 一对环形缓冲区所在的共享内存，以及两个方向的 eventfd
+class ShmRegion {
+ public:
+  // 客户端创建，capacity 为每个环的大小（2 的幂）
+  static std::unique_ptr<ShmRegion> Create(size_t capacity);
+  // 服务端映射收到的描述符，描述符归 ShmRegion 所有
+  static std::unique_ptr<ShmRegion> Attach(int mem_fd, int request_event, int response_event, size_t capacity);
+  ~ShmRegion();
+  ShmRing &RequestRing() { return *request_ring; }
+  ShmRing &ResponseRing() { return *response_ring; }
+  int MemFd() const { return mem_fd; }
+  int RequestEvent() const { return request_event; }
+  int ResponseEvent() const { return response_event; }
+ private:
+  ShmRegion() = default;
+  bool Map(size_t capacity, bool init);
+ private:
+  int mem_fd = -1;
+  int request_event = -1;     // 请求环的消费者（服务端）在此等待
+  int response_event = -1;    // 响应环的消费者（客户端）在此等待
+  void *memory = nullptr;
+  size_t size = 0;
+  std::unique_ptr<ShmRing> request_ring;
+  std::unique_ptr<ShmRing> response_ring;
+};
+
+// 客户端：回调在读线程中执行，超时定时器使用 loop
+class ShmConnection : public ClientTransport {
+ public:
+  // 握手失败返回 nullptr
+  static std::unique_ptr<ShmConnection> Connect(const hv::EventLoopPtr &loop, const std::string &path, size_t capacity);
+  ~ShmConnection() override;
+  using ClientTransport::Send;
+  void Send(uint64_t call_id, std::string frame, int timeout_ms, Callback callback) override;
+  uint8_t PeerAccept() const override { return peer_accept.load(std::memory_order_relaxed); }
+  size_t MaxFrameSize() const override { return max_frame; }
+  // 服务端退出后为 false，调用方应改用其他传输方式
+  bool Alive() const { return !closed.load(std::memory_order_acquire); }
+ private:
+  ShmConnection(const hv::EventLoopPtr &loop, int sock, std::unique_ptr<ShmRegion> region);
+  void ReadLoop();
+  void Complete(uint64_t call_id, int error_code, const std::string &error_text, const std::string &body,
+				ResponseAttachment attachment = {});
+  void FailAll(int error_code, const std::string &error_text);
+ private:
+  struct PendingCall {
+	Callback callback;
+	hv::TimerID timer = 0;
+  };
+  hv::EventLoopPtr loop;
+  int sock;
+  std::unique_ptr<ShmRegion> region;
+  size_t max_frame;
+  std::atomic<bool> closed = false;
+  std::atomic<uint8_t> peer_accept = 0;
+  std::mutex send_mtx;
+  std::mutex mtx;
+  std::unordered_map<uint64_t, PendingCall> pending;
+  std::thread reader;
+};
+
+// 服务端：每个会话一个线程，从请求环读取并调用 handler，业务方法也在该线程中执行
+class ShmSession : public RpcSession, public std::enable_shared_from_this<ShmSession> {
+ public:
+  using Handler = std::function<void(const RpcSessionPtr &session, const char *data, size_t size)>;
+
+  ShmSession(int sock, std::unique_ptr<ShmRegion> region);
+  ~ShmSession() override;
+  void Start(Handler handler);
+  void Write(const std::string &frame) override;
+  void Close() override;
+  std::string PeerAddr() override { return peer; }
+  size_t MaxFrameSize() const override { return max_frame; }
+  // 共享内存客户端不重组分片，超过环容量的响应改为回复错误
+  bool WriteChunked(const std::string &frame) override { return false; }
+ private:
+  void Run(const Handler &handler);
+ private:
+  int sock;
+  std::unique_ptr<ShmRegion> region;
+  size_t max_frame;
+  std::string peer;    // shm:pid=<客户端进程号>
+  std::atomic<bool> closed = false;
+  std::mutex send_mtx;
+};
+
+class ShmListener {
+ public:
+  ~ShmListener();
+  bool Start(const std::string &path, ShmSession::Handler handler);
+  // 停止接受新的握手，已建立的会话继续服务；套接字文件仍是本进程创建的才删除（新进程可能已在同一路径上监听）
+  void StopAccept();
+  void Stop();
+  size_t SessionNum();
+ private:
+  void AcceptLoop();
+  void Handshake(int sock);
+ private:
+  int listen_fd = -1;
+  std::string path;
+  ino_t path_ino = 0;    // bind 后套接字文件的 inode
+  ShmSession::Handler handler;
+  std::thread thread;
+  std::mutex mtx;
+  std::vector<std::weak_ptr<ShmSession>> sessions;
+};
+
+#endif //TINYRPC_SRC_RPC_SHMTRANSPORT_H_
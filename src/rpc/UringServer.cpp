@@ -0,0 +1,559 @@
+/**
+  ******************************************************************************
+  * @file           : UringServer.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 连接关闭流程：shutdown 使 multishot recv 以 0 结束、在途的 send 失败，
+  *                   两者都结束后才 close 描述符并释放连接，避免内核仍引用已释放的缓冲区
+  * @date           : 2025/4/2
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include "UringServer.h"
+#include "utils/HvProtocol.h"
+#include "utils/IoUring.h"
+#include "utils/Listener.h"
+#include "utils/Log.h"
+
+namespace {
+
+constexpr unsigned kRingEntries = 4096;
+constexpr uint16_t kBufferGroup = 0;
+constexpr unsigned kBufferCount = 1024;
+constexpr unsigned kBufferSize = 8192;
+constexpr uint32_t kMaxFrameLength = 2 * 1024 * 1024;    // 与 libhv 的 DEFAULT_PACKAGE_MAX_LENGTH 一致
+
+enum UringOp : uint64_t {
+  OP_ACCEPT = 1,
+  OP_RECV = 2,
+  OP_SEND = 3,
+  OP_WAKE = 4,
+};
+
+inline uint64_t userData(uint64_t conn_id, UringOp op) { return conn_id << 8 | op; }
+
+}
+
+class UringSession;
+
+struct UringConn {
+  uint64_t id = 0;
+  int fd = -1;
+  std::string input;            // 未凑成完整帧的数据
+  std::string sending;          // 在途 send 引用的数据，完成前不能修改
+  size_t send_offset = 0;
+  std::string pending;          // 等待下一次 send 的数据
+  bool recv_armed = false;
+  bool send_inflight = false;
+  bool dirty = false;
+  bool closing = false;
+  std::shared_ptr<UringSession> session;
+};
+
+class UringEngine {
+ public:
+  UringEngine(UringServer::Handler handler, UringServer::ConnectionCallback on_connection)
+	  : handler(std::move(handler)), on_connection(std::move(on_connection)) {}
+  ~UringEngine();
+  // ring 在 IO 线程中创建（IORING_SETUP_SINGLE_ISSUER 要求创建与提交在同一线程）
+  bool Start(int fd);
+  void Stop();
+  // 线程安全
+  void Write(uint64_t id, const std::string &frame);
+  void Close(uint64_t id);
+  void CollectStats(UringStats &stats) const;
+ private:
+  bool Init();
+  void Loop();
+  io_uring_sqe *Sqe();
+  void ArmAccept();
+  void ArmRecv(UringConn &conn);
+  void ArmWake();
+  void SubmitSend(UringConn &conn);
+  void Handle(const io_uring_cqe &cqe);
+  void OnAccept(const io_uring_cqe &cqe);
+  void OnRecv(uint64_t id, const io_uring_cqe &cqe);
+  void OnSend(uint64_t id, const io_uring_cqe &cqe);
+  void OnWake();
+  void Process(UringConn &conn, const char *data, size_t size);
+  size_t DispatchFrames(UringConn &conn, const char *data, size_t size);
+  void WriteInLoop(uint64_t id, const std::string &frame);
+  void StartClose(UringConn &conn);
+  void TryFinishClose(UringConn &conn);
+  void FlushDirty();
+  bool InLoop() const { return std::this_thread::get_id() == loop_tid; }
+ private:
+  UringServer::Handler handler;
+  UringServer::ConnectionCallback on_connection;
+  IoUring ring;
+  int listen_fd = -1;
+  int wake_fd = -1;
+  uint64_t wake_value = 0;
+  bool accept_armed = false;
+  size_t inflight = 0;    // 尚未结束的 SQE（multishot 以不带 F_MORE 的完成事件结束）
+  uint64_t next_id = 1;
+  std::unordered_map<uint64_t, std::unique_ptr<UringConn>> conns;
+  std::vector<uint64_t> dirty;
+  std::thread thread;
+  std::thread::id loop_tid;
+  std::atomic<bool> stopping = false;
+  std::mutex queue_mtx;
+  std::vector<std::pair<uint64_t, std::string>> write_queue;
+  std::vector<uint64_t> close_queue;
+  std::atomic<uint64_t> requests = 0;
+  std::atomic<uint64_t> enter_calls = 0;
+  std::atomic<uint64_t> other_syscalls = 0;
+  std::atomic<size_t> conn_num = 0;
+};
+
+class UringSession : public RpcSession {
+ public:
+  UringSession(UringEngine *engine, uint64_t id, std::string peer) : engine(engine), id(id), peer(std::move(peer)) {}
+  void Write(const std::string &frame) override { engine->Write(id, frame); }
+  void Close() override { engine->Close(id); }
+  std::string PeerAddr() override { return peer; }
+ private:
+  UringEngine *engine;
+  uint64_t id;
+  std::string peer;
+};
+
+UringEngine::~UringEngine() {
+	Stop();
+	if (wake_fd >= 0) {
+		close(wake_fd);
+	}
+	if (listen_fd >= 0) {
+		close(listen_fd);
+	}
+}
+
+bool UringEngine::Start(int fd) {
+	listen_fd = fd;
+	std::promise<bool> ready;
+	auto result = ready.get_future();
+	thread = std::thread([this, &ready]() {
+	  loop_tid = std::this_thread::get_id();
+	  bool ok = Init();
+	  ready.set_value(ok);
+	  if (ok) {
+		  Loop();
+	  }
+	});
+	if (!result.get()) {
+		thread.join();
+		return false;
+	}
+	return true;
+}
+
+bool UringEngine::Init() {
+	if (!ring.init(kRingEntries)) {
+		LOG_ERROR("io_uring_setup failed: {}", strerror(errno));
+		return false;
+	}
+	if (!ring.setupBufferRing(kBufferGroup, kBufferCount, kBufferSize)) {
+		LOG_ERROR("io_uring register buffer ring failed: {}", strerror(errno));
+		return false;
+	}
+	wake_fd = eventfd(0, EFD_CLOEXEC);
+	return wake_fd >= 0;
+}
+
+void UringEngine::Stop() {
+	if (!thread.joinable()) {
+		return;
+	}
+	stopping.store(true);
+	eventfd_write(wake_fd, 1);
+	thread.join();
+}
+
+void UringEngine::Write(uint64_t id, const std::string &frame) {
+	if (InLoop()) {
+		WriteInLoop(id, frame);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(queue_mtx);
+		write_queue.emplace_back(id, frame);
+	}
+	other_syscalls.fetch_add(1, std::memory_order_relaxed);
+	eventfd_write(wake_fd, 1);
+}
+
+void UringEngine::Close(uint64_t id) {
+	if (InLoop()) {
+		auto iter = conns.find(id);
+		if (iter != conns.end()) {
+			StartClose(*iter->second);
+		}
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(queue_mtx);
+		close_queue.push_back(id);
+	}
+	eventfd_write(wake_fd, 1);
+}
+
+void UringEngine::CollectStats(UringStats &stats) const {
+	stats.requests += requests.load(std::memory_order_relaxed);
+	stats.enter_calls += enter_calls.load(std::memory_order_relaxed);
+	stats.other_syscalls += other_syscalls.load(std::memory_order_relaxed);
+	stats.connections += conn_num.load(std::memory_order_relaxed);
+}
+
+void UringEngine::Loop() {
+	ArmAccept();
+	ArmWake();
+	while (!stopping.load(std::memory_order_relaxed)) {
+		FlushDirty();
+		ring.submit(1);
+		ring.forEachCqe([this](const io_uring_cqe &cqe) { Handle(cqe); });
+		enter_calls.store(ring.enterCount(), std::memory_order_relaxed);
+	}
+
+	// 关闭所有连接与监听套接字，等待在途的请求全部结束
+	shutdown(listen_fd, SHUT_RDWR);
+	for (auto &item : conns) {
+		StartClose(*item.second);
+	}
+	eventfd_write(wake_fd, 1);    // 结束在途的 eventfd 读
+	while (inflight > 0) {
+		ring.submit(1);
+		ring.forEachCqe([this](const io_uring_cqe &cqe) { Handle(cqe); });
+	}
+}
+
+io_uring_sqe *UringEngine::Sqe() {
+	auto sqe = ring.getSqe();
+	if (sqe == nullptr) {
+		ring.submit();    // SQ 满时先提交已有的
+		sqe = ring.getSqe();
+	}
+	inflight++;
+	return sqe;
+}
+
+void UringEngine::ArmAccept() {
+	auto sqe = Sqe();
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = listen_fd;
+	sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+	sqe->accept_flags = SOCK_CLOEXEC;
+	sqe->user_data = userData(0, OP_ACCEPT);
+	accept_armed = true;
+}
+
+void UringEngine::ArmRecv(UringConn &conn) {
+	auto sqe = Sqe();
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = conn.fd;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = kBufferGroup;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->user_data = userData(conn.id, OP_RECV);
+	conn.recv_armed = true;
+}
+
+void UringEngine::ArmWake() {
+	auto sqe = Sqe();
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = wake_fd;
+	sqe->addr = reinterpret_cast<uint64_t>(&wake_value);
+	sqe->len = sizeof(wake_value);
+	sqe->user_data = userData(0, OP_WAKE);
+}
+
+void UringEngine::SubmitSend(UringConn &conn) {
+	auto sqe = Sqe();
+	sqe->opcode = IORING_OP_SEND;
+	sqe->fd = conn.fd;
+	sqe->addr = reinterpret_cast<uint64_t>(conn.sending.data() + conn.send_offset);
+	sqe->len = static_cast<uint32_t>(conn.sending.size() - conn.send_offset);
+	sqe->msg_flags = MSG_NOSIGNAL;
+	sqe->user_data = userData(conn.id, OP_SEND);
+	conn.send_inflight = true;
+}
+
+void UringEngine::Handle(const io_uring_cqe &cqe) {
+	bool more = cqe.flags & IORING_CQE_F_MORE;
+	if (!more) {
+		inflight--;
+	}
+	auto id = cqe.user_data >> 8;
+	switch (cqe.user_data & 0xFF) {
+		case OP_ACCEPT: OnAccept(cqe); break;
+		case OP_RECV: OnRecv(id, cqe); break;
+		case OP_SEND: OnSend(id, cqe); break;
+		case OP_WAKE: OnWake(); break;
+		default: break;
+	}
+}
+
+void UringEngine::OnAccept(const io_uring_cqe &cqe) {
+	if (!(cqe.flags & IORING_CQE_F_MORE)) {
+		accept_armed = false;
+		if (!stopping.load(std::memory_order_relaxed)) {
+			ArmAccept();
+		}
+	}
+	if (cqe.res < 0) {
+		return;
+	}
+
+	auto conn = std::make_unique<UringConn>();
+	conn->id = next_id++;
+	conn->fd = cqe.res;
+	if (stopping.load(std::memory_order_relaxed)) {
+		close(conn->fd);
+		return;
+	}
+	int one = 1;
+	setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	std::string peer;
+	if (getpeername(conn->fd, reinterpret_cast<struct sockaddr *>(&addr), &len) == 0) {
+		char ip[INET_ADDRSTRLEN];
+		inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
+		peer = std::string(ip) + ":" + std::to_string(ntohs(addr.sin_port));
+	}
+	other_syscalls.fetch_add(2, std::memory_order_relaxed);
+	conn->session = std::make_shared<UringSession>(this, conn->id, peer);
+
+	ArmRecv(*conn);
+	conns[conn->id] = std::move(conn);
+	conn_num.fetch_add(1, std::memory_order_relaxed);
+	if (on_connection) {
+		on_connection(true);
+	}
+}
+
+void UringEngine::OnRecv(uint64_t id, const io_uring_cqe &cqe) {
+	bool has_buffer = cqe.flags & IORING_CQE_F_BUFFER;
+	auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+	auto iter = conns.find(id);
+	if (iter == conns.end()) {
+		if (has_buffer) {
+			ring.recycleBuffer(bid);
+		}
+		return;
+	}
+	auto &conn = *iter->second;
+	if (!(cqe.flags & IORING_CQE_F_MORE)) {
+		conn.recv_armed = false;
+	}
+
+	if (cqe.res > 0 && has_buffer) {
+		if (!conn.closing) {
+			Process(conn, ring.buffer(bid), cqe.res);
+		}
+		ring.recycleBuffer(bid);
+	} else if (cqe.res != -ENOBUFS) {
+		StartClose(conn);    // 对端关闭（0）或出错
+	}
+	// 缓冲区暂时用完或 multishot 被内核结束时重新提交
+	if (!conn.recv_armed && !conn.closing) {
+		ArmRecv(conn);
+	}
+	TryFinishClose(conn);
+}
+
+void UringEngine::OnSend(uint64_t id, const io_uring_cqe &cqe) {
+	auto iter = conns.find(id);
+	if (iter == conns.end()) {
+		return;
+	}
+	auto &conn = *iter->second;
+	conn.send_inflight = false;
+	if (cqe.res < 0) {
+		StartClose(conn);
+	} else if (!conn.closing) {
+		conn.send_offset += cqe.res;
+		if (conn.send_offset < conn.sending.size()) {
+			SubmitSend(conn);
+		} else {
+			conn.sending.clear();
+			conn.send_offset = 0;
+			if (!conn.pending.empty() && !conn.dirty) {
+				conn.dirty = true;
+				dirty.push_back(conn.id);
+			}
+		}
+	}
+	TryFinishClose(conn);
+}
+
+void UringEngine::OnWake() {
+	std::vector<std::pair<uint64_t, std::string>> writes;
+	std::vector<uint64_t> closes;
+	{
+		std::lock_guard<std::mutex> lock(queue_mtx);
+		writes.swap(write_queue);
+		closes.swap(close_queue);
+	}
+	for (const auto &item : writes) {
+		WriteInLoop(item.first, item.second);
+	}
+	for (auto id : closes) {
+		auto iter = conns.find(id);
+		if (iter != conns.end()) {
+			StartClose(*iter->second);
+			TryFinishClose(*iter->second);
+		}
+	}
+	if (!stopping.load(std::memory_order_relaxed)) {
+		ArmWake();
+	}
+}
+
+void UringEngine::Process(UringConn &conn, const char *data, size_t size) {
+	if (conn.input.empty()) {
+		// 快速路径：直接在接收缓冲区中分发完整的帧，只把剩余部分拷贝出来
+		auto used = DispatchFrames(conn, data, size);
+		if (!conn.closing && used < size) {
+			conn.input.assign(data + used, size - used);
+		}
+		return;
+	}
+	conn.input.append(data, size);
+	auto used = DispatchFrames(conn, conn.input.data(), conn.input.size());
+	conn.input.erase(0, used);
+}
+
+size_t UringEngine::DispatchFrames(UringConn &conn, const char *data, size_t size) {
+	size_t offset = 0;
+	while (!conn.closing && size - offset >= FRAME_HEAD_LENGTH) {
+		uint32_t length;
+		memcpy(&length, data + offset, sizeof(length));
+		length = ntohl(length);
+		if (length > kMaxFrameLength) {
+			LOG_ERROR("frame too large from {}: {}", conn.session->PeerAddr(), length);
+			StartClose(conn);
+			break;
+		}
+		auto total = FRAME_HEAD_LENGTH + length;
+		if (size - offset < total) {
+			break;
+		}
+		requests.fetch_add(1, std::memory_order_relaxed);
+		RpcSessionPtr session = conn.session;
+		handler(session, data + offset, total);
+		offset += total;
+	}
+	return offset;
+}
+
+void UringEngine::WriteInLoop(uint64_t id, const std::string &frame) {
+	auto iter = conns.find(id);
+	if (iter == conns.end() || iter->second->closing) {
+		return;
+	}
+	auto &conn = *iter->second;
+	conn.pending.append(frame);
+	if (!conn.dirty) {
+		conn.dirty = true;
+		dirty.push_back(id);
+	}
+}
+
+/**
+ * @brief 把各连接积累的响应合并成一次 send，在下一次 io_uring_enter 时一起提交
+ */
+void UringEngine::FlushDirty() {
+	for (auto id : dirty) {
+		auto iter = conns.find(id);
+		if (iter == conns.end()) {
+			continue;
+		}
+		auto &conn = *iter->second;
+		conn.dirty = false;
+		if (conn.closing || conn.send_inflight || conn.pending.empty()) {
+			continue;    // 在途的 send 完成后会再次标记
+		}
+		conn.sending.swap(conn.pending);
+		conn.pending.clear();
+		conn.send_offset = 0;
+		SubmitSend(conn);
+	}
+	dirty.clear();
+}
+
+void UringEngine::StartClose(UringConn &conn) {
+	if (conn.closing) {
+		return;
+	}
+	conn.closing = true;
+	other_syscalls.fetch_add(1, std::memory_order_relaxed);
+	shutdown(conn.fd, SHUT_RDWR);
+}
+
+void UringEngine::TryFinishClose(UringConn &conn) {
+	if (!conn.closing || conn.recv_armed || conn.send_inflight) {
+		return;
+	}
+	other_syscalls.fetch_add(1, std::memory_order_relaxed);
+	close(conn.fd);
+	conn_num.fetch_sub(1, std::memory_order_relaxed);
+	if (on_connection) {
+		on_connection(false);
+	}
+	conn.session->NotifyClosed();
+	conns.erase(conn.id);
+}
+
+UringServer::UringServer() = default;
+
+UringServer::~UringServer() {
+	Stop();
+}
+
+bool UringServer::Start(const std::string &ip, int port, int thread_num, Handler handler,
+						ConnectionCallback on_connection) {
+	this->port = port;
+	for (int i = 0; i < thread_num; i++) {
+		// 端口为 0 时，其余线程绑定到第一个套接字分到的端口
+		int fd = listenTcp(ip, this->port, true, &this->port);
+		if (fd < 0) {
+			engines.clear();
+			return false;
+		}
+		auto engine = std::make_unique<UringEngine>(handler, on_connection);
+		if (!engine->Start(fd)) {
+			engines.clear();
+			return false;
+		}
+		engines.push_back(std::move(engine));
+	}
+	return true;
+}
+
+void UringServer::Stop() {
+	for (auto &engine : engines) {
+		engine->Stop();
+	}
+	engines.clear();
+}
+
+UringStats UringServer::Stats() const {
+	UringStats stats;
+	for (const auto &engine : engines) {
+		engine->CollectStats(stats);
+	}
+	return stats;
+}
@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file           : UringServer.h
+  * @author         : xy
+  * @brief          : 基于 io_uring 的服务端 IO 引擎，可替代 libhv 的 epoll 循环
+  * @attention      : 每个线程一个 io_uring 和一个 SO_REUSEPORT 监听套接字；multishot accept/recv，
+  *                   recv 从注册的缓冲区环中取缓冲区；一轮事件处理产生的响应在下一次 io_uring_enter 时一并提交；
+  *                   帧格式与 libhv 拆包规则一致（帧头 8 字节，前 4 字节为帧体长度）
+  * @date           : 2025/4/2
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_RPC_URINGSERVER_H_
+#define TINYRPC_SRC_RPC_URINGSERVER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "RpcSession.h"
+
+class UringEngine;
+
+struct UringStats {
+  uint64_t requests = 0;          // 已分发的请求帧
+  uint64_t enter_calls = 0;       // io_uring_enter 次数
+  uint64_t other_syscalls = 0;    // 建立/关闭连接、跨线程唤醒等
+  size_t connections = 0;
+};
+
+class UringServer {
+ public:
+  // 请求在 IO 线程中分发；session 可在其他线程中 Write，响应会转回 IO 线程发送
+  using Handler = std::function<void(const RpcSessionPtr &session, const char *data, size_t size)>;
+  using ConnectionCallback = std::function<void(bool connected)>;
+
+  UringServer();
+  ~UringServer();
+  // port 为 0 时由系统分配，之后可通过 Port() 获取；内核不支持所需特性时返回 false
+  bool Start(const std::string &ip, int port, int thread_num, Handler handler,
+			 ConnectionCallback on_connection = nullptr);
+  void Stop();
+  int Port() const { return port; }
+  UringStats Stats() const;
+ private:
+  int port = 0;
+  std::vector<std::unique_ptr<UringEngine>> engines;
+};
+
+#endif //TINYRPC_SRC_RPC_URINGSERVER_H_
@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file           : Chunk.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/5
+  ******************************************************************************
+  */
+
+#include <atomic>
+#include "Chunk.h"
+#include "Compress.h"
+#include "Config.h"
+#include "HvProtocol.h"
+#include "Log.h"
+
+constexpr size_t kDefaultChunkSize = 256 * 1024;
+constexpr size_t kDefaultMaxMessage = 64 * 1024 * 1024;
+
+size_t chunkSize() {
+	static size_t size = [] {
+	  auto value = Config::getInstance()->get("chunk_kb");
+	  return value == std::nullopt ? kDefaultChunkSize : std::stoul(value.value()) * 1024;
+	}();
+	return size;
+}
+
+size_t maxMessageSize() {
+	static size_t size = [] {
+	  auto value = Config::getInstance()->get("max_message_mb");
+	  return value == std::nullopt ? kDefaultMaxMessage : std::stoul(value.value()) * 1024 * 1024;
+	}();
+	return size;
+}
+
+static void putU64(char *out, uint64_t value) {
+	for (int i = 0; i < 8; i++) {
+		out[i] = static_cast<char>(value >> (56 - 8 * i));
+	}
+}
+
+static uint64_t getU64(const char *data) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value = value << 8 | static_cast<uint8_t>(data[i]);
+	}
+	return value;
+}
+
+void ChunkWriter::add(FrameParts frame) {
+	static std::atomic<uint64_t> next_id = 0;
+	queue.push_back(Message{next_id.fetch_add(1, std::memory_order_relaxed) + 1, std::move(frame), 0});
+}
+
+/**
+ * @brief 从队首的消息取一片，未发完的消息移到队尾，多个大帧轮流发送
+ */
+bool ChunkWriter::next(std::string &chunk) {
+	if (queue.empty()) {
+		return false;
+	}
+	auto message = std::move(queue.front());
+	queue.pop_front();
+	auto size = std::min(chunk_size, message.frame.size() - message.offset);
+
+	chunk.resize(FRAME_HEAD_LENGTH + CHUNK_HEAD_LENGTH);
+	auto head_ptr = chunk.data() + FRAME_HEAD_LENGTH;
+	putU64(head_ptr, message.id);
+	uint32_t total = htonl(static_cast<uint32_t>(message.frame.size()));
+	uint32_t offset = htonl(static_cast<uint32_t>(message.offset));
+	memcpy(head_ptr + 8, &total, sizeof(total));
+	memcpy(head_ptr + 12, &offset, sizeof(offset));
+	// 依次从 prefix、附件、校验尾中取出 [offset, offset + size) 的部分
+	size_t begin = message.offset;
+	size_t end = message.offset + size;
+	size_t base = 0;
+	for (const std::string *part : {&message.frame.prefix, &message.frame.attachment, &message.frame.suffix}) {
+		if (begin < base + part->size() && end > base) {
+			auto from = std::max(begin, base) - base;
+			auto to = std::min(end, base + part->size()) - base;
+			chunk.append(*part, from, to - from);
+		}
+		base += part->size();
+	}
+
+	FrameHead head;
+	head.type = FRAME_CHUNK;
+	head.flags = HvProtocol::defaultFlags();
+	head.accept = kSupportedCompress;
+	HvProtocol::finishFrame(head, chunk);
+
+	message.offset += size;
+	if (message.offset < message.frame.size()) {
+		queue.push_back(std::move(message));
+	}
+	return true;
+}
+
+ChunkAssembler::Result ChunkAssembler::feed(const std::string &body, std::string &frame) {
+	if (body.size() < CHUNK_HEAD_LENGTH) {
+		LOG_ERROR("chunk too short: {} bytes", body.size());
+		return CHUNK_ERROR;
+	}
+	auto id = getU64(body.data());
+	uint32_t total, offset;
+	memcpy(&total, body.data() + 8, sizeof(total));
+	memcpy(&offset, body.data() + 12, sizeof(offset));
+	total = ntohl(total);
+	offset = ntohl(offset);
+	size_t size = body.size() - CHUNK_HEAD_LENGTH;
+
+	auto iter = partials.find(id);
+	if (iter == partials.end()) {
+		if (offset != 0 || total < FRAME_HEAD_LENGTH || total > max_message) {
+			LOG_ERROR("bad first chunk: total={} offset={}", total, offset);
+			return CHUNK_ERROR;
+		}
+		if (pending_bytes + total > max_pending) {
+			LOG_ERROR("too many pending chunked bytes: {} + {}", pending_bytes, total);
+			return CHUNK_ERROR;
+		}
+		// 按原帧总长一次分配，之后的分片直接拷贝到对应位置
+		iter = partials.emplace(id, Partial()).first;
+		iter->second.data.resize(total);
+		pending_bytes += total;
+	}
+	auto &partial = iter->second;
+	if (total != partial.data.size() || offset != partial.received || size > total - offset || size == 0) {
+		LOG_ERROR("chunk out of order: id={} total={} offset={} received={}", id, total, offset, partial.received);
+		return CHUNK_ERROR;
+	}
+	memcpy(partial.data.data() + offset, body.data() + CHUNK_HEAD_LENGTH, size);
+	partial.received += size;
+	if (partial.received < total) {
+		return CHUNK_PARTIAL;
+	}
+	frame.swap(partial.data);
+	pending_bytes -= total;
+	partials.erase(iter);
+	return CHUNK_COMPLETE;
+}
+
+void ChunkAssembler::clear() {
+	partials.clear();
+	pending_bytes = 0;
+}
@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file           : Chunk.h
+  * @author         : xy
+  * @brief          : 大帧的分片发送与重组
+  * @attention      : 超过 chunkSize() 的帧（含帧头的完整请求/响应帧）拆成若干 FRAME_CHUNK 帧，
+  *                   分片帧体 = message_id(8字节, 大端) + 原帧总长(4字节) + 偏移(4字节) + 数据；
+  *                   同一消息的分片按顺序到达，不同消息的分片可以与其他帧交错，
+  *                   接收端收到首个分片时按原帧总长一次分配缓冲区，收齐后把原帧交给正常的处理流程
+  * @date           : 2025/4/5
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_CHUNK_H_
+#define TINYRPC_SRC_UTILS_CHUNK_H_
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include "HvProtocol.h"
+
+constexpr size_t CHUNK_HEAD_LENGTH = 16;
+
+// 配置项 chunk_kb：单个分片的数据长度，默认 256KB
+size_t chunkSize();
+// 配置项 max_message_mb：重组后单个帧的最大长度，默认 64MB
+size_t maxMessageSize();
+
+// 发送端：多个大帧轮流各取一片，不线程安全
+class ChunkWriter {
+ public:
+  explicit ChunkWriter(size_t chunk_size) : chunk_size(chunk_size) {}
+  // 加入一个待分片发送的帧，message_id 在进程内唯一
+  void add(std::string frame) { add(FrameParts{std::move(frame), "", ""}); }
+  // 分段的帧直接从各段切片，附件不必先拼接
+  void add(FrameParts frame);
+  // 取出下一个分片帧（已完成封包），没有待发送数据时返回 false
+  bool next(std::string &chunk);
+  bool empty() const { return queue.empty(); }
+  void clear() { queue.clear(); }
+ private:
+  struct Message {
+	uint64_t id;
+	FrameParts frame;
+	size_t offset;
+  };
+  size_t chunk_size;
+  std::deque<Message> queue;
+};
+
+// 接收端：按连接维护未收齐的消息，不线程安全
+class ChunkAssembler {
+ public:
+  enum Result {
+	CHUNK_PARTIAL,     // 已接收，消息尚未收齐
+	CHUNK_COMPLETE,    // 消息收齐，frame 为重组后的原帧
+	CHUNK_ERROR,       // 格式错误或超出限制，应断开连接
+  };
+  // max_pending 为所有未收齐消息占用内存的上限
+  ChunkAssembler(size_t max_message, size_t max_pending) : max_message(max_message), max_pending(max_pending) {}
+  // body 为 FRAME_CHUNK 的帧体
+  Result feed(const std::string &body, std::string &frame);
+  size_t pendingBytes() const { return pending_bytes; }
+  void clear();
+ private:
+  struct Partial {
+	std::string data;
+	size_t received = 0;
+  };
+  size_t max_message;
+  size_t max_pending;
+  size_t pending_bytes = 0;
+  std::unordered_map<uint64_t, Partial> partials;
+};
+
+#endif //TINYRPC_SRC_UTILS_CHUNK_H_
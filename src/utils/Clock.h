@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file           : Clock.h
+  * @author         : xy
+  * @brief          : 单调时钟，供耗时统计使用
+  * @attention      : steady_clock 在 Linux 上走 vDSO，单次调用约 20ns；
+  *                   fastTicks 在 x86_64 上直接读 TSC（约 7ns），只用于差值计算，换算系数首次使用时校准
+  * @date           : 2025/3/25
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_CLOCK_H_
+#define TINYRPC_SRC_UTILS_CLOCK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+inline uint64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint64_t fastTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return nowNs();
+#endif
+}
+
+// 每个 tick 对应的纳秒数；首次调用阻塞约 10ms 完成校准
+inline double nsPerTick() {
+	static const double ns_per_tick = [] {
+#if defined(__x86_64__) || defined(__i386__)
+	  auto start_ns = nowNs();
+	  auto start_ticks = fastTicks();
+	  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	  auto ticks = fastTicks() - start_ticks;
+	  auto ns = nowNs() - start_ns;
+	  return ticks == 0 ? 1.0 : static_cast<double>(ns) / static_cast<double>(ticks);
+#else
+	  return 1.0;
+#endif
+	}();
+	return ns_per_tick;
+}
+
+inline uint64_t ticksToNs(uint64_t ticks) {
+	return static_cast<uint64_t>(static_cast<double>(ticks) * nsPerTick());
+}
+
+inline uint64_t nsToTicks(uint64_t ns) {
+	return static_cast<uint64_t>(static_cast<double>(ns) / nsPerTick());
+}
+
+#endif //TINYRPC_SRC_UTILS_CLOCK_H_
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file           : Compress.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/29
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <cstring>
+#include "Compress.h"
+#include "Config.h"
+#include "Lz4.h"
+
+constexpr size_t kRawLengthBytes = 4;
+constexpr uint32_t kMaxRawLength = 64 * 1024 * 1024;    // 防止恶意数据申请过大内存
+
+bool Compress::compress(CompressType type, const std::string &input, std::string &output) {
+	if (type != COMPRESS_LZ4) {
+		return false;
+	}
+	output.resize(kRawLengthBytes + Lz4::compressBound(input.size()));
+	auto raw_len = htonl(static_cast<uint32_t>(input.size()));
+	std::memcpy(output.data(), &raw_len, kRawLengthBytes);
+	auto len = Lz4::compress(input.data(), input.size(), output.data() + kRawLengthBytes);
+	output.resize(kRawLengthBytes + len);
+	return true;
+}
+
+bool Compress::decompress(CompressType type, const std::string &input, std::string &output) {
+	if (type != COMPRESS_LZ4 || input.size() < kRawLengthBytes) {
+		return false;
+	}
+	uint32_t raw_len;
+	std::memcpy(&raw_len, input.data(), kRawLengthBytes);
+	raw_len = ntohl(raw_len);
+	if (raw_len > kMaxRawLength) {
+		return false;
+	}
+	output.resize(raw_len);
+	auto len = Lz4::decompress(input.data() + kRawLengthBytes, input.size() - kRawLengthBytes,
+							   output.data(), output.size());
+	return len == static_cast<long>(raw_len);
+}
+
+CompressType Compress::parse(const std::string &name) {
+	if (name == "lz4") {
+		return COMPRESS_LZ4;
+	}
+	return COMPRESS_NONE;
+}
+
+CompressType Compress::methodType(const std::string &method_name) {
+	auto config = Config::getInstance();
+	auto value = config->get("compress." + method_name);
+	if (value == std::nullopt) {
+		value = config->get("compress_default");
+	}
+	return value == std::nullopt ? COMPRESS_NONE : parse(value.value());
+}
+
+size_t Compress::threshold() {
+	static const auto &threshold = Config::getInstance()->bindInt("compress_threshold", kDefaultCompressThreshold);
+	return static_cast<size_t>(threshold.get());
+}
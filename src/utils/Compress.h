@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file           : Compress.h
+  * @author         : xy
+  * @brief          : 消息体压缩：编码选择与压缩/解压
+  * @attention      : 压缩结果格式为 原始长度(4字节, 大端) + 编码数据；
+  *                   按方法选择编码：配置项 compress.<服务名>.<方法名>=lz4，未配置时取 compress_default
+  * @date           : 2025/3/29
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_COMPRESS_H_
+#define TINYRPC_SRC_UTILS_COMPRESS_H_
+
+#include <cstdint>
+#include <string>
+
+enum CompressType : uint8_t {
+  COMPRESS_NONE = 0,
+  COMPRESS_LZ4 = 1,
+};
+
+// 本端能解码的编码集合，第 i 位表示 CompressType i
+constexpr uint8_t kSupportedCompress = 1 << COMPRESS_LZ4;
+
+constexpr size_t kDefaultCompressThreshold = 4096;
+
+class Compress {
+ public:
+  static bool compress(CompressType type, const std::string &input, std::string &output);
+  static bool decompress(CompressType type, const std::string &input, std::string &output);
+  static CompressType parse(const std::string &name);
+  // 方法对应的编码（服务名.方法名）
+  static CompressType methodType(const std::string &method_name);
+  // 消息体达到该大小才压缩，配置项 compress_threshold
+  static size_t threshold();
+  // 对端是否能解码 type
+  static bool accepted(uint8_t accept, CompressType type) { return type != COMPRESS_NONE && (accept >> type) & 1; }
+};
+
+#endif //TINYRPC_SRC_UTILS_COMPRESS_H_
@@ -12,10 +12,53 @@
 #include <cstdlib>
 #include <fstream>
 #include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 #include "Config.h"
 
 Config *Config::instance_ = nullptr;
 
+static std::atomic<int> signal_fd{-1};    // SIGHUP 处理函数写入的管道
+
+static std::optional<int64_t> parseInt(const std::optional<std::string> &value) {
+	if (value == std::nullopt || value->empty()) {
+		return std::nullopt;
+	}
+	char *end = nullptr;
+	errno = 0;
+	auto result = std::strtoll(value->c_str(), &end, 10);
+	if (errno != 0 || *end != '\0') {
+		return std::nullopt;
+	}
+	return result;
+}
+
+static std::optional<double> parseDouble(const std::optional<std::string> &value) {
+	if (value == std::nullopt || value->empty()) {
+		return std::nullopt;
+	}
+	char *end = nullptr;
+	auto result = std::strtod(value->c_str(), &end);
+	if (*end != '\0') {
+		return std::nullopt;
+	}
+	return result;
+}
+
+static std::optional<bool> parseBool(const std::optional<std::string> &value) {
+	if (value == "1" || value == "true" || value == "on") {
+		return true;
+	}
+	if (value == "0" || value == "false" || value == "off") {
+		return false;
+	}
+	return std::nullopt;
+}
+
 /**
  * @brief 获取单例对象
  * @return Config实例化对象
@@ -29,17 +72,40 @@ Config *Config::getInstance() {
 	return instance_;
 }
 
-Config::Config(const std::string &config_path) {
-	parse(config_path);
+Config::Config(const std::string &config_path) : path_(config_path) {
+	auto config_map = std::make_shared<ConfigSnapshot>();
+	bool loaded = parse(config_path, *config_map);
+	assert(loaded == true);
+	(void) loaded;
+	snapshot_ = std::move(config_map);
+}
+
+Config::~Config() {
+	if (watcher_.joinable()) {
+		int fd = wake_pipe_[1];
+		signal_fd.compare_exchange_strong(fd, -1);
+		char quit = 'q';
+		(void) !write(wake_pipe_[1], &quit, 1);
+		watcher_.join();
+	}
+	for (int fd : {inotify_fd_, wake_pipe_[0], wake_pipe_[1]}) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
 }
 
 /**
- * @brief 解析配置文件并加载到内存中
+ * @brief 解析配置文件
  * @param path
+ * @param config_map 解析结果
+ * @return 文件无法打开时返回 false
  */
-void Config::parse(const std::string &path) {
+bool Config::parse(const std::string &path, ConfigSnapshot &config_map) {
 	std::ifstream ifs(path);
-	assert(ifs.is_open() == true);
+	if (!ifs.is_open()) {
+		return false;
+	}
 
 	std::string line;
 	while (std::getline(ifs, line)) {
@@ -54,8 +120,9 @@ void Config::parse(const std::string &path) {
 		trim(key);
 		std::string value = line.substr(pos + 1);
 		trim(value);
-		config_map_[key] = value;
+		config_map[key] = value;
 	}
+	return true;
 }
 
 /**
@@ -64,13 +131,165 @@ void Config::parse(const std::string &path) {
  * @return std::optional<std::string>
  */
 std::optional<std::string> Config::get(const std::string &key) const {
-	auto it = config_map_.find(key);
-	if (it == config_map_.end()) {
+	auto config_map = snapshot();
+	auto it = config_map->find(key);
+	if (it == config_map->end()) {
 		return std::nullopt;
 	}
 	return it->second;
 }
 
+const ConfigValue<int64_t> &Config::bindInt(const std::string &key, int64_t default_value) {
+	auto value = new ConfigValue<int64_t>(default_value);
+	watch(key, [value, default_value](const std::optional<std::string> &text) {
+	  value->value_.store(parseInt(text).value_or(default_value), std::memory_order_relaxed);
+	});
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	int_values_.emplace_back(value);
+	return *value;
+}
+
+const ConfigValue<double> &Config::bindDouble(const std::string &key, double default_value) {
+	auto value = new ConfigValue<double>(default_value);
+	watch(key, [value, default_value](const std::optional<std::string> &text) {
+	  value->value_.store(parseDouble(text).value_or(default_value), std::memory_order_relaxed);
+	});
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	double_values_.emplace_back(value);
+	return *value;
+}
+
+const ConfigValue<bool> &Config::bindBool(const std::string &key, bool default_value) {
+	auto value = new ConfigValue<bool>(default_value);
+	watch(key, [value, default_value](const std::optional<std::string> &text) {
+	  value->value_.store(parseBool(text).value_or(default_value), std::memory_order_relaxed);
+	});
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	bool_values_.emplace_back(value);
+	return *value;
+}
+
+uint64_t Config::watch(const std::string &key, ConfigCallback callback) {
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	callback(get(key));
+	auto id = next_watch_id_++;
+	watchers_.push_back(Watcher{id, key, std::move(callback)});
+	return id;
+}
+
+void Config::unwatch(uint64_t id) {
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	for (auto iter = watchers_.begin(); iter != watchers_.end(); ++iter) {
+		if (iter->id == id) {
+			watchers_.erase(iter);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief 重新读取配置文件，替换快照后通知值发生变化的配置项
+ */
+bool Config::reload() {
+	auto config_map = std::make_shared<ConfigSnapshot>();
+	if (!parse(path_, *config_map)) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(watch_mtx_);
+	auto old_map = snapshot();
+	std::atomic_store(&snapshot_, std::shared_ptr<const ConfigSnapshot>(config_map));
+	version_.fetch_add(1, std::memory_order_relaxed);
+
+	auto lookup = [](const ConfigSnapshot &snapshot, const std::string &key) -> std::optional<std::string> {
+	  auto it = snapshot.find(key);
+	  return it == snapshot.end() ? std::nullopt : std::optional<std::string>(it->second);
+	};
+	for (auto &watcher : watchers_) {
+		auto value = lookup(*config_map, watcher.key);
+		if (value != lookup(*old_map, watcher.key)) {
+			watcher.callback(value);
+		}
+	}
+	return true;
+}
+
+void Config::onSignal(int) {
+	int saved_errno = errno;
+	int fd = signal_fd.load(std::memory_order_relaxed);
+	if (fd >= 0) {
+		char reload = 'r';
+		(void) !write(fd, &reload, 1);
+	}
+	errno = saved_errno;
+}
+
+/**
+ * @brief 监视配置文件所在的目录，编辑器“写临时文件再改名”的保存方式同样能感知
+ */
+void Config::startWatcher() {
+	std::call_once(watcher_flag_, [this]() {
+	  if (pipe2(wake_pipe_, O_CLOEXEC | O_NONBLOCK) != 0) {
+		  return;
+	  }
+	  auto slash = path_.rfind('/');
+	  auto dir = slash == std::string::npos ? std::string(".") : path_.substr(0, slash);
+	  inotify_fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+	  if (inotify_fd_ >= 0 && inotify_add_watch(inotify_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		  close(inotify_fd_);
+		  inotify_fd_ = -1;
+	  }
+
+	  signal_fd.store(wake_pipe_[1]);
+	  struct sigaction action{};
+	  action.sa_handler = &Config::onSignal;
+	  sigemptyset(&action.sa_mask);
+	  action.sa_flags = SA_RESTART;
+	  sigaction(SIGHUP, &action, nullptr);
+
+	  watcher_ = std::thread(&Config::watchLoop, this);
+	});
+}
+
+void Config::watchLoop() {
+	auto slash = path_.rfind('/');
+	auto file_name = slash == std::string::npos ? path_ : path_.substr(slash + 1);
+	alignas(inotify_event) char buffer[4096];
+	pollfd fds[2] = {{wake_pipe_[0], POLLIN, 0}, {inotify_fd_, POLLIN, 0}};
+	while (true) {
+		if (poll(fds, inotify_fd_ >= 0 ? 2 : 1, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		bool changed = false;
+		if (fds[0].revents & POLLIN) {
+			char command;
+			while (read(wake_pipe_[0], &command, 1) == 1) {
+				if (command == 'q') {
+					return;
+				}
+				changed = true;
+			}
+		}
+		if (inotify_fd_ >= 0 && (fds[1].revents & POLLIN)) {
+			ssize_t len;
+			while ((len = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+				for (char *ptr = buffer; ptr < buffer + len;) {
+					auto event = reinterpret_cast<inotify_event *>(ptr);
+					if (event->len > 0 && file_name == event->name) {
+						changed = true;
+					}
+					ptr += sizeof(inotify_event) + event->len;
+				}
+			}
+		}
+		if (changed) {
+			reload();
+		}
+	}
+}
+
 /**
  * @brief 回收单例资源
  */
@@ -95,6 +314,3 @@ void Config::trim(std::string &content) {
 	// 找到 最后一个 不是空格、制表符、回车或换行符的字符位置
 	content.erase(content.find_last_not_of(" \t\r\n") + 1);
 }
-
-
-
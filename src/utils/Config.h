@@ -3,7 +3,9 @@
   * @file           : Config.h
   * @author         : xy
   * @brief          : 解析 .ini 配置文件
-  * @attention      : 只用于查询，不涉及增加，线程安全
+  * @attention      : 线程安全；配置保存在不可变的快照中，重新加载时整体替换（读取方持有的旧快照不受影响）；
+  *                   热路径上的配置项用 bindInt/bindDouble/bindBool 绑定为缓存的原子值，重新加载后自动更新，
+  *                   需要在变化时做额外处理的用 watch；startWatcher 后修改配置文件或发送 SIGHUP 即重新加载
   * @date           : 2025/3/18
   ******************************************************************************
   */
@@ -11,25 +13,88 @@
 #ifndef TINYRPC_UTILS_CONFIG_H_
 #define TINYRPC_UTILS_CONFIG_H_
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <gtest/gtest.h>
 
 const std::string kConfigPath = "config/config.ini";
 
+using ConfigSnapshot = std::unordered_map<std::string, std::string>;
+using ConfigCallback = std::function<void(const std::optional<std::string> &)>;
+
+// 绑定到一个配置项的缓存值，读取只是一次原子 load
+template <typename T>
+class ConfigValue {
+ public:
+  T get() const { return value_.load(std::memory_order_relaxed); }
+  operator T() const { return get(); }
+ private:
+  friend class Config;
+  explicit ConfigValue(T value) : value_(value) {}
+  std::atomic<T> value_;
+};
+
 class Config {
  public:
   static Config *getInstance();
+  ~Config();
   std::optional<std::string> get(const std::string &key) const;
+  std::shared_ptr<const ConfigSnapshot> snapshot() const { return std::atomic_load(&snapshot_); }
+  // 每次成功重新加载加 1
+  uint64_t version() const { return version_.load(std::memory_order_relaxed); }
+
+  // 配置项缺失或无法解析时取 default_value；返回的引用在 Config 存续期间一直有效，调用方通常保存在函数内的静态变量中
+  const ConfigValue<int64_t> &bindInt(const std::string &key, int64_t default_value);
+  const ConfigValue<double> &bindDouble(const std::string &key, double default_value);
+  const ConfigValue<bool> &bindBool(const std::string &key, bool default_value);
+  // 注册时以当前值调用一次，之后配置项变化（含新增、删除）时在重新加载的线程中调用；回调中不要再调用 watch/unwatch
+  uint64_t watch(const std::string &key, ConfigCallback callback);
+  void unwatch(uint64_t id);
+
+  // 重新读取配置文件，文件无法打开时保留原配置并返回 false
+  bool reload();
+  // 启动后台线程：配置文件被改写（inotify）或进程收到 SIGHUP 时重新加载
+  void startWatcher();
  private:
   explicit Config(const std::string &config_path);
-  void parse(const std::string &path);
+  static bool parse(const std::string &path, ConfigSnapshot &config_map);
   static void destroy();
   static void trim(std::string& content);
+  static void onSignal(int signo);
+  void watchLoop();
  private:
+  struct Watcher {
+	uint64_t id;
+	std::string key;
+	ConfigCallback callback;
+  };
   static Config *instance_;
-  std::unordered_map<std::string, std::string> config_map_;
+  std::string path_;
+  std::shared_ptr<const ConfigSnapshot> snapshot_;    // 以 std::atomic_load/atomic_store 访问
+  std::atomic<uint64_t> version_ = 0;
+  std::mutex watch_mtx_;    // 保护 watchers_ 与各缓存值，并串行化重新加载
+  std::vector<Watcher> watchers_;
+  uint64_t next_watch_id_ = 1;
+  std::vector<std::unique_ptr<ConfigValue<int64_t>>> int_values_;
+  std::vector<std::unique_ptr<ConfigValue<double>>> double_values_;
+  std::vector<std::unique_ptr<ConfigValue<bool>>> bool_values_;
+  std::once_flag watcher_flag_;
+  std::thread watcher_;
+  int inotify_fd_ = -1;
+  int wake_pipe_[2] = {-1, -1};    // SIGHUP 处理函数与析构函数通过它唤醒后台线程
  public:
   FRIEND_TEST(ConfigTest, ConfigBase);
+  FRIEND_TEST(ConfigTest, ReloadSwapsSnapshot);
+  FRIEND_TEST(ConfigTest, TypedBindings);
+  FRIEND_TEST(ConfigTest, WatcherReloadsOnFileChange);
+  FRIEND_TEST(LoggerTest, LevelFollowsConfig);
 };
 
 #endif //TINYRPC_UTILS_CONFIG_H_
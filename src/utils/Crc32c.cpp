@@ -0,0 +1,153 @@
+/**
+  ******************************************************************************
+  * @file           : Crc32c.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 查表实现为 slicing-by-8，每次处理 8 字节
+  * @date           : 2025/3/30
+  ******************************************************************************
+  */
+
+#include <array>
+#include <cstring>
+#include "Crc32c.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define TINYRPC_CRC32C_X86
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define TINYRPC_CRC32C_ARM
+#endif
+
+namespace {
+
+constexpr uint32_t kPoly = 0x82F63B78;    // 反射形式的 Castagnoli 多项式
+
+using Table = std::array<std::array<uint32_t, 256>, 8>;
+
+Table makeTable() {
+	Table table{};
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ (kPoly & (0u - (crc & 1)));
+		}
+		table[0][i] = crc;
+	}
+	for (uint32_t i = 0; i < 256; i++) {
+		for (int k = 1; k < 8; k++) {
+			table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+		}
+	}
+	return table;
+}
+
+const Table &table() {
+	static const Table table = makeTable();
+	return table;
+}
+
+// 以下函数的 crc 为取反后的中间状态
+uint32_t extendTable(uint32_t crc, const uint8_t *p, size_t size) {
+	const auto &t = table();
+	while (size >= 8) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));    // 按小端处理
+		word ^= crc;
+		crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^ t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF]
+			^ t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^ t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+		p += 8;
+		size -= 8;
+	}
+	while (size-- > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+	}
+	return crc;
+}
+
+#if defined(TINYRPC_CRC32C_X86)
+
+__attribute__((target("sse4.2")))
+uint32_t extendHardware(uint32_t crc, const uint8_t *p, size_t size) {
+#if defined(__x86_64__)
+	uint64_t crc64 = crc;
+	while (size >= 8) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+		p += 8;
+		size -= 8;
+	}
+	crc = static_cast<uint32_t>(crc64);
+#endif
+	while (size >= 4) {
+		uint32_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+		p += 4;
+		size -= 4;
+	}
+	while (size-- > 0) {
+		crc = _mm_crc32_u8(crc, *p++);
+	}
+	return crc;
+}
+
+bool detectHardware() {
+	return __builtin_cpu_supports("sse4.2");
+}
+
+#elif defined(TINYRPC_CRC32C_ARM)
+
+__attribute__((target("+crc")))
+uint32_t extendHardware(uint32_t crc, const uint8_t *p, size_t size) {
+	while (size >= 8) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc = __crc32cd(crc, word);
+		p += 8;
+		size -= 8;
+	}
+	while (size-- > 0) {
+		crc = __crc32cb(crc, *p++);
+	}
+	return crc;
+}
+
+bool detectHardware() {
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+#else
+
+uint32_t extendHardware(uint32_t crc, const uint8_t *p, size_t size) {
+	return extendTable(crc, p, size);
+}
+
+bool detectHardware() {
+	return false;
+}
+
+#endif
+
+}
+
+bool Crc32c::hardwareAvailable() {
+	static const bool available = detectHardware();
+	return available;
+}
+
+uint32_t Crc32c::extend(uint32_t crc, const void *data, size_t size) {
+	auto p = static_cast<const uint8_t *>(data);
+	if (hardwareAvailable()) {
+		return ~extendHardware(~crc, p, size);
+	}
+	return ~extendTable(~crc, p, size);
+}
+
+uint32_t Crc32c::extendPortable(uint32_t crc, const void *data, size_t size) {
+	return ~extendTable(~crc, static_cast<const uint8_t *>(data), size);
+}
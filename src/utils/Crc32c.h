@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file           : Crc32c.h
+  * @author         : xy
+  * @brief          : CRC32C（Castagnoli）校验
+  * @attention      : x86 使用 SSE4.2、ARMv8 使用 CRC 指令，运行时检测 CPU 支持，不支持时使用查表实现
+  * @date           : 2025/3/30
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_CRC32C_H_
+#define TINYRPC_SRC_UTILS_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+
+class Crc32c {
+ public:
+  // 在 crc 的基础上继续计算，crc 为 0 表示从头开始
+  static uint32_t extend(uint32_t crc, const void *data, size_t size);
+  static uint32_t value(const void *data, size_t size) { return extend(0, data, size); }
+  // 查表实现，供测试与基准对比
+  static uint32_t extendPortable(uint32_t crc, const void *data, size_t size);
+  static bool hardwareAvailable();
+};
+
+#endif //TINYRPC_SRC_UTILS_CRC32C_H_
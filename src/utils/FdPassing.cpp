@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file           : FdPassing.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "FdPassing.h"
+
+int sendFds(int sock, const void *data, size_t size, const int *fds, int fd_count) {
+	if (fd_count < 0 || fd_count > kMaxPassFds) {
+		return -1;
+	}
+	struct iovec iov;
+	iov.iov_base = const_cast<void *>(data);
+	iov.iov_len = size;
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxPassFds)];
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	if (fd_count > 0) {
+		msg.msg_control = control;
+		msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+		auto cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+		memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_count);
+	}
+
+	ssize_t ret;
+	do {
+		ret = sendmsg(sock, &msg, MSG_NOSIGNAL);
+	} while (ret < 0 && errno == EINTR);
+	return ret == static_cast<ssize_t>(size) ? 0 : -1;
+}
+
+int recvFds(int sock, void *data, size_t size, int *fds, int max_fds) {
+	struct iovec iov;
+	iov.iov_base = data;
+	iov.iov_len = size;
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxPassFds)];
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	ssize_t ret;
+	do {
+		ret = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+	} while (ret < 0 && errno == EINTR);
+	if (ret != static_cast<ssize_t>(size)) {
+		return -1;
+	}
+
+	int count = 0;
+	for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+			continue;
+		}
+		int n = static_cast<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+		auto received = reinterpret_cast<int *>(CMSG_DATA(cmsg));
+		for (int i = 0; i < n; i++) {
+			if (count < max_fds) {
+				fds[count++] = received[i];
+			} else {
+				close(received[i]);    // 多余的描述符不能泄漏
+			}
+		}
+	}
+	if (msg.msg_flags & MSG_CTRUNC) {
+		for (int i = 0; i < count; i++) {
+			close(fds[i]);
+		}
+		return -1;
+	}
+	return count;
+}
@@ -0,0 +1,23 @@
+/**
+  ******************************************************************************
+  * @file           : FdPassing.h
+  * @author         : xy
+  * @brief          : 通过 Unix 域套接字传递文件描述符（SCM_RIGHTS）
+  * @attention      : 每次携带少量数据，接收方按同样的长度读取；失败返回 -1
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_FDPASSING_H_
+#define TINYRPC_SRC_UTILS_FDPASSING_H_
+
+#include <cstddef>
+
+constexpr int kMaxPassFds = 8;
+
+// 发送 data 与 fds，fd_count 不超过 kMaxPassFds
+int sendFds(int sock, const void *data, size_t size, const int *fds, int fd_count);
+// 接收 data 与最多 max_fds 个描述符，返回收到的描述符个数
+int recvFds(int sock, void *data, size_t size, int *fds, int max_fds);
+
+#endif //TINYRPC_SRC_UTILS_FDPASSING_H_
@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file           : Histogram.h
+  * @author         : xy
+  * @brief          : HDR 风格的对数-线性直方图
+  * @attention      : record 无锁（relaxed 原子加），读取时生成快照再做合并/分位数计算
+  * @date           : 2025/3/25
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_HISTOGRAM_H_
+#define TINYRPC_SRC_UTILS_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// 每个 2 的幂区间再等分为 2^kSubBucketBits 个桶，相对误差约 1/2^kSubBucketBits
+constexpr int kSubBucketBits = 3;
+constexpr int kSubBucketCount = 1 << kSubBucketBits;
+constexpr int kMaxValueBits = 36;    // 以 ns 计约 68s，更大的值落入最后一个桶
+constexpr int kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+inline size_t histogramBucketIndex(uint64_t value) {
+	if (value < kSubBucketCount) {
+		return value;
+	}
+	int msb = 63 - __builtin_clzll(value);
+	if (msb >= kMaxValueBits) {
+		return kBucketCount - 1;
+	}
+	int shift = msb - kSubBucketBits;
+	return (shift + 1) * kSubBucketCount + ((value >> shift) & (kSubBucketCount - 1));
+}
+
+// 桶的上界（不含），用于分位数估计
+inline uint64_t histogramBucketUpper(size_t index) {
+	if (index < kSubBucketCount) {
+		return index + 1;
+	}
+	int shift = static_cast<int>(index / kSubBucketCount) - 1;
+	uint64_t sub = index % kSubBucketCount;
+	return (static_cast<uint64_t>(kSubBucketCount + sub + 1)) << shift;
+}
+
+struct HistogramSnapshot {
+  std::array<uint64_t, kBucketCount> buckets{};
+  uint64_t count = 0;
+  uint64_t sum = 0;
+
+  void merge(const HistogramSnapshot &other) {
+	  for (size_t i = 0; i < buckets.size(); i++) {
+		  buckets[i] += other.buckets[i];
+	  }
+	  count += other.count;
+	  sum += other.sum;
+  }
+
+  // q 取值 [0, 1]，返回所在桶的上界
+  uint64_t percentile(double q) const {
+	  if (count == 0) {
+		  return 0;
+	  }
+	  auto target = static_cast<uint64_t>(q * static_cast<double>(count));
+	  if (target == 0) {
+		  target = 1;
+	  }
+	  uint64_t seen = 0;
+	  for (size_t i = 0; i < buckets.size(); i++) {
+		  seen += buckets[i];
+		  if (seen >= target) {
+			  return histogramBucketUpper(i);
+		  }
+	  }
+	  return histogramBucketUpper(buckets.size() - 1);
+  }
+
+  uint64_t mean() const { return count == 0 ? 0 : sum / count; }
+};
+
+class Histogram {
+ public:
+  void record(uint64_t value) {
+	  buckets_[histogramBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	  sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void snapshotInto(HistogramSnapshot &snapshot) const {
+	  for (size_t i = 0; i < buckets_.size(); i++) {
+		  auto n = buckets_[i].load(std::memory_order_relaxed);
+		  snapshot.buckets[i] += n;
+		  snapshot.count += n;
+	  }
+	  snapshot.sum += sum_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> sum_ = 0;
+};
+
+#endif //TINYRPC_SRC_UTILS_HISTOGRAM_H_
@@ -9,6 +9,8 @@
   */
 
 #include "HvProtocol.h"
+#include "Config.h"
+#include "Crc32c.h"
 
 /**
  * @brief 封包
@@ -35,11 +37,123 @@ u_int32_t HvProtocol::unpackMessage(const std::string &receivedData, std::string
 	uint32_t len = 0;
 	std::memcpy(&len, receivedData.data(), sizeof(uint32_t));
 
-	std::string unpackedMessage;
-	auto length = receivedData.size() - SERVER_HEAD_LENGTH;
-	unpackedMessage.resize(length);
-	std::memcpy(unpackedMessage.data(), receivedData.data() + SERVER_HEAD_LENGTH, length);
+	returnData.assign(receivedData, SERVER_HEAD_LENGTH, std::string::npos);
+	return ntohl(len);
+}
+
+u_int32_t HvProtocol::unpackMessage(std::string_view receivedData, std::string_view &returnData) {
+	uint32_t len = 0;
+	std::memcpy(&len, receivedData.data(), sizeof(uint32_t));
 
-	returnData = unpackedMessage;
+	returnData = receivedData.substr(SERVER_HEAD_LENGTH);
 	return ntohl(len);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 帧封包
+ * @param head 帧头，length 字段按 body 长度填写
+ * @param body
+ * @return 帧头(8字节) + body
+ */
+std::string HvProtocol::packFrame(FrameHead head, const std::string &body) {
+	std::string frame;
+	frame.reserve(FRAME_HEAD_LENGTH + body.size() + FRAME_CHECKSUM_LENGTH);
+	frame.resize(FRAME_HEAD_LENGTH);
+	frame.append(body);
+	finishFrame(head, frame);
+	return frame;
+}
+
+void HvProtocol::finishFrame(FrameHead head, std::string &frame) {
+	bool checksum = head.flags & FRAME_FLAG_CRC32C;
+	auto body_len = frame.size() - FRAME_HEAD_LENGTH + (checksum ? FRAME_CHECKSUM_LENGTH : 0);
+	auto length = htonl(static_cast<uint32_t>(body_len));
+	std::memcpy(frame.data(), &length, sizeof(length));
+	frame[4] = static_cast<char>(head.type);
+	frame[5] = static_cast<char>(head.flags);
+	frame[6] = static_cast<char>(head.compress);
+	frame[7] = static_cast<char>(head.accept);
+	if (checksum) {
+		auto crc = htonl(Crc32c::value(frame.data(), frame.size()));
+		frame.append(reinterpret_cast<const char *>(&crc), sizeof(crc));
+	}
+}
+
+void HvProtocol::finishFrame(FrameHead head, FrameParts &parts) {
+	bool checksum = head.flags & FRAME_FLAG_CRC32C;
+	auto &frame = parts.prefix;
+	auto body_len = frame.size() - FRAME_HEAD_LENGTH + parts.attachment.size() + (checksum ? FRAME_CHECKSUM_LENGTH : 0);
+	auto length = htonl(static_cast<uint32_t>(body_len));
+	std::memcpy(frame.data(), &length, sizeof(length));
+	frame[4] = static_cast<char>(head.type);
+	frame[5] = static_cast<char>(head.flags);
+	frame[6] = static_cast<char>(head.compress);
+	frame[7] = static_cast<char>(head.accept);
+	parts.suffix.clear();
+	if (checksum) {
+		auto crc = Crc32c::extend(Crc32c::value(frame.data(), frame.size()), parts.attachment.data(), parts.attachment.size());
+		crc = htonl(crc);
+		parts.suffix.assign(reinterpret_cast<const char *>(&crc), sizeof(crc));
+	}
+}
+
+/**
+ * @brief 帧拆包
+ * @return 长度字段与实际数据不符时返回 false
+ */
+bool HvProtocol::unpackFrame(const char *data, size_t size, FrameHead &head, std::string &body) {
+	if (size < FRAME_HEAD_LENGTH) {
+		return false;
+	}
+	uint32_t length;
+	std::memcpy(&length, data, sizeof(length));
+	head.length = ntohl(length);
+	if (head.length != size - FRAME_HEAD_LENGTH) {
+		return false;
+	}
+	head.type = static_cast<uint8_t>(data[4]);
+	head.flags = static_cast<uint8_t>(data[5]);
+	head.compress = static_cast<uint8_t>(data[6]);
+	head.accept = static_cast<uint8_t>(data[7]);
+
+	size_t body_len = head.length;
+	if (head.flags & FRAME_FLAG_CRC32C) {
+		if (body_len < FRAME_CHECKSUM_LENGTH) {
+			return false;
+		}
+		body_len -= FRAME_CHECKSUM_LENGTH;
+		uint32_t crc;
+		std::memcpy(&crc, data + FRAME_HEAD_LENGTH + body_len, sizeof(crc));
+		if (ntohl(crc) != Crc32c::value(data, FRAME_HEAD_LENGTH + body_len)) {
+			return false;
+		}
+	}
+	body.assign(data + FRAME_HEAD_LENGTH, body_len);
+	return true;
+}
+
+bool HvProtocol::splitBatch(const char *data, size_t size, std::vector<std::pair<const char *, size_t>> &frames) {
+	size_t offset = 0;
+	while (offset < size) {
+		if (size - offset < FRAME_HEAD_LENGTH) {
+			return false;
+		}
+		uint32_t length;
+		std::memcpy(&length, data + offset, sizeof(length));
+		auto total = FRAME_HEAD_LENGTH + ntohl(length);
+		if (size - offset < total) {
+			return false;
+		}
+		frames.emplace_back(data + offset, total);
+		offset += total;
+	}
+	return true;
+}
+
+uint8_t HvProtocol::defaultFlags() {
+	static uint8_t flags = [] {
+	  auto value = Config::getInstance()->get("frame_checksum");
+	  return static_cast<uint8_t>(value != std::nullopt && value.value() == "1" ? FRAME_FLAG_CRC32C : 0);
+	}();
+	return flags;
+}
@@ -3,7 +3,13 @@
   * @file           : HvProtocol.h
   * @author         : xy
   * @brief          : None
-  * @attention      : None
+  * @attention      : 帧格式：帧头(8字节) + 帧体
+  *                   帧头 = 帧体长度(4字节, 大端) + 类型(1) + 标志位(1) + 帧体压缩编码(1) + 本端可解码的编码集合(1)
+  *                   帧体 = RpcHeader/RpcResponseHeader 长度(4字节) + 头部 + 消息体（压缩只作用于消息体）+ 附件（长度见头部 attachment_size）
+  *                   标志位含 FRAME_FLAG_CRC32C 时帧体后追加 4 字节 CRC32C（大端，覆盖帧头与帧体），计入帧体长度
+  *                   批量帧（FRAME_BATCH）的帧体由若干个完整的请求/响应帧首尾相接组成，对端在响应中带 FRAME_FLAG_BATCH 表示支持
+  *                   超过 chunk_kb 的帧拆成分片帧（FRAME_CHUNK）发送，见 Chunk.h，双方在帧头中带 FRAME_FLAG_CHUNK 表示能够重组
+  *                   心跳帧（FRAME_PING）的帧体为 8 字节序号，对端以 FRAME_PONG 原样带回；服务端在帧头中带 FRAME_FLAG_PING 表示能够应答
   * @date           : 2025/3/20
   ******************************************************************************
   */
@@ -11,18 +17,73 @@
 #ifndef TINYRPC_SRC_UTILS_HVPROTOCOL_H_
 #define TINYRPC_SRC_UTILS_HVPROTOCOL_H_
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <iostream>
 #include <cstring>
 #include <arpa/inet.h>
 constexpr size_t SERVER_HEAD_LENGTH = 4;
 constexpr size_t SERVER_HEAD_LENGTH_FIELD_OFFSET = 0;
 constexpr size_t SERVER_HEAD_LENGTH_FIELD_BYTES = 4;
+constexpr size_t FRAME_HEAD_LENGTH = 8;
+constexpr size_t FRAME_CHECKSUM_LENGTH = 4;
+
+enum FrameFlag : uint8_t {
+  FRAME_FLAG_CRC32C = 1 << 0,
+  FRAME_FLAG_BATCH = 1 << 1,    // 发送方能处理批量帧
+  FRAME_FLAG_CHUNK = 1 << 2,    // 发送方能重组分片帧
+  FRAME_FLAG_PING = 1 << 3,     // 发送方能应答心跳帧
+};
+
+enum FrameType : uint8_t {
+  FRAME_REQUEST = 0,
+  FRAME_RESPONSE = 1,
+  FRAME_BATCH = 2,
+  FRAME_STREAM = 3,    // 流式调用的帧，帧体格式见 rpc/RpcStream.h
+  FRAME_CHUNK = 4,     // 大帧的一个分片，帧体格式见 Chunk.h
+  FRAME_PING = 5,
+  FRAME_PONG = 6,
+};
+
+struct FrameHead {
+  uint32_t length = 0;    // 帧体长度（含校验尾），封包时自动填写
+  uint8_t type = FRAME_REQUEST;
+  uint8_t flags = 0;
+  uint8_t compress = 0;   // CompressType
+  uint8_t accept = 0;     // 第 i 位表示能解码 CompressType i
+};
+
+// 分段的帧：prefix（帧头 + 附件之前的帧体）、附件、校验尾依次发送即为完整的帧，附件不必拷贝进帧
+struct FrameParts {
+  std::string prefix;
+  std::string attachment;
+  std::string suffix;
+
+  size_t size() const { return prefix.size() + attachment.size() + suffix.size(); }
+  std::string join() const { return prefix + attachment + suffix; }
+};
+
 class HvProtocol {
  public:
   // 封包函数，将字符串封装成自定义协议格式（头部+数据）
   static std::string packMessageAsString(const std::string &message);
   // 拆包函数，从接收到的数据中提取消息
   static u_int32_t unpackMessage(const std::string &receivedData, std::string &returnData);
+  // 同上，returnData 为 receivedData 中的视图，不拷贝
+  static u_int32_t unpackMessage(std::string_view receivedData, std::string_view &returnData);
+  // 帧封包：帧头 + body
+  static std::string packFrame(FrameHead head, const std::string &body);
+  // 原地封包：frame 为 FRAME_HEAD_LENGTH 字节占位 + 帧体，填写帧头并按标志位追加校验尾，调用方可复用 frame 的容量
+  static void finishFrame(FrameHead head, std::string &frame);
+  // 分段封包：prefix 同 finishFrame，帧长计入附件，校验尾写入 suffix
+  static void finishFrame(FrameHead head, FrameParts &parts);
+  // 帧拆包：data 为一个完整的帧（由 libhv 按长度字段切分），长度不符或校验失败返回 false
+  static bool unpackFrame(const char *data, size_t size, FrameHead &head, std::string &body);
+  // 把批量帧的帧体切分为各个内层帧（只检查长度），格式不符返回 false
+  static bool splitBatch(const char *data, size_t size, std::vector<std::pair<const char *, size_t>> &frames);
+  // 发送端的默认标志位，配置项 frame_checksum=1 时附加 CRC32C
+  static uint8_t defaultFlags();
 };
 
 #endif //TINYRPC_SRC_UTILS_HVPROTOCOL_H_
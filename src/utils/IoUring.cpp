@@ -0,0 +1,184 @@
+/**
+  ******************************************************************************
+  * @file           : IoUring.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 内存布局与系统调用用法参照内核文档 io_uring_setup(2)、io_uring_register(2)
+  * @date           : 2025/4/2
+  ******************************************************************************
+  */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "IoUring.h"
+
+static int ioUringSetup(unsigned entries, io_uring_params *params) {
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+	return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int ioUringRegister(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+	return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// 内核头文件中的 bufs 用 __DECLARE_FLEX_ARRAY 声明，按 C++ 编译时空结构体占 1 字节，bufs 的偏移会错位，
+// 这里直接按 io_uring_buf 数组访问（tail 与 bufs[0].resv 重叠）
+static io_uring_buf &ringBuf(io_uring_buf_ring *ring, unsigned index) {
+	return reinterpret_cast<io_uring_buf *>(ring)[index];
+}
+
+IoUring::~IoUring() {
+	if (buf_ring != nullptr) {
+		munmap(buf_ring, buf_ring_size);
+		delete[] buffers;
+	}
+	if (sqes != nullptr) {
+		munmap(sqes, sqes_size);
+	}
+	if (cq_ptr != nullptr && cq_ptr != sq_ptr) {
+		munmap(cq_ptr, cq_size);
+	}
+	if (sq_ptr != nullptr) {
+		munmap(sq_ptr, sq_size);
+	}
+	if (ring_fd >= 0) {
+		close(ring_fd);
+	}
+}
+
+bool IoUring::init(unsigned entries) {
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	// 只有一个线程提交；完成事件的 task work 推迟到下次 io_uring_enter 时执行，减少中断
+	params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+	ring_fd = ioUringSetup(entries, &params);
+	if (ring_fd < 0 && errno == EINVAL) {
+		memset(&params, 0, sizeof(params));    // 旧内核不支持上述标志
+		ring_fd = ioUringSetup(entries, &params);
+	}
+	if (ring_fd < 0) {
+		return false;
+	}
+
+	sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		sq_size = cq_size = std::max(sq_size, cq_size);
+	}
+	sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if (sq_ptr == MAP_FAILED) {
+		sq_ptr = nullptr;
+		return false;
+	}
+	if (single_mmap) {
+		cq_ptr = sq_ptr;
+	} else {
+		cq_ptr = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (cq_ptr == MAP_FAILED) {
+			cq_ptr = nullptr;
+			return false;
+		}
+	}
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	auto sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if (sqes_ptr == MAP_FAILED) {
+		return false;
+	}
+	sqes = static_cast<io_uring_sqe *>(sqes_ptr);
+
+	auto sq = static_cast<char *>(sq_ptr);
+	sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+	sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+	sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+	sq_entries = params.sq_entries;
+	auto sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+	for (unsigned i = 0; i < sq_entries; i++) {
+		sq_array[i] = i;    // SQE 下标与位置一一对应
+	}
+	sqe_tail = sqe_submitted = *sq_tail;
+
+	auto cq = static_cast<char *>(cq_ptr);
+	cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+	cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+	cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+	return true;
+}
+
+io_uring_sqe *IoUring::getSqe() {
+	auto head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+	if (sqe_tail - head >= sq_entries) {
+		return nullptr;
+	}
+	auto sqe = &sqes[sqe_tail & sq_mask];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe_tail++;
+	return sqe;
+}
+
+int IoUring::submit(unsigned wait_nr) {
+	auto to_submit = sqe_tail - sqe_submitted;
+	__atomic_store_n(sq_tail, sqe_tail, __ATOMIC_RELEASE);
+	sqe_submitted = sqe_tail;
+	if (to_submit == 0 && wait_nr == 0) {
+		return 0;
+	}
+	// 内核只会消费 SQ 中 head 到 tail 之间的 SQE，被信号打断后按原参数重试即可
+	int ret;
+	do {
+		enter_count++;
+		ret = ioUringEnter(ring_fd, to_submit, wait_nr, wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+	} while (ret < 0 && errno == EINTR);
+	return ret;
+}
+
+bool IoUring::setupBufferRing(uint16_t group, unsigned count, unsigned size) {
+	buf_ring_size = count * sizeof(io_uring_buf);
+	auto ptr = mmap(nullptr, buf_ring_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+	if (ptr == MAP_FAILED) {
+		return false;
+	}
+	buf_ring = static_cast<io_uring_buf_ring *>(ptr);
+
+	io_uring_buf_reg reg;
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring);
+	reg.ring_entries = count;
+	reg.bgid = group;
+	if (ioUringRegister(ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+		munmap(buf_ring, buf_ring_size);
+		buf_ring = nullptr;
+		return false;
+	}
+
+	buffer_count = count;
+	buffer_size = size;
+	buffers = new char[static_cast<size_t>(count) * size];
+	buf_tail = 0;
+	for (unsigned i = 0; i < count; i++) {
+		auto &buf = ringBuf(buf_ring, (buf_tail + i) & (count - 1));
+		buf.addr = reinterpret_cast<uint64_t>(buffer(static_cast<uint16_t>(i)));
+		buf.len = size;
+		buf.bid = static_cast<uint16_t>(i);
+	}
+	buf_tail = static_cast<uint16_t>(buf_tail + count);
+	__atomic_store_n(&buf_ring->tail, buf_tail, __ATOMIC_RELEASE);
+	return true;
+}
+
+void IoUring::recycleBuffer(uint16_t bid) {
+	auto &buf = ringBuf(buf_ring, buf_tail & (buffer_count - 1));
+	buf.addr = reinterpret_cast<uint64_t>(buffer(bid));
+	buf.len = buffer_size;
+	buf.bid = bid;
+	buf_tail++;
+	__atomic_store_n(&buf_ring->tail, buf_tail, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file           : IoUring.h
+  * @author         : xy
+  * @brief          : io_uring 的最小封装（直接使用系统调用，不依赖 liburing）
+  * @attention      : 只在一个线程中使用；提供缓冲区环（IORING_REGISTER_PBUF_RING）供 multishot recv 选择缓冲区
+  * @date           : 2025/4/2
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_IOURING_H_
+#define TINYRPC_SRC_UTILS_IOURING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+
+class IoUring {
+ public:
+  IoUring() = default;
+  ~IoUring();
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+
+  // 失败返回 false（内核不支持或被禁用）
+  bool init(unsigned entries);
+  // SQ 已满时返回 nullptr，调用方应先 submit
+  io_uring_sqe *getSqe();
+  // 提交已准备的 SQE，wait_nr > 0 时同时等待至少 wait_nr 个完成事件
+  int submit(unsigned wait_nr = 0);
+
+  // 依次处理已完成的事件，返回处理个数
+  template<typename F>
+  unsigned forEachCqe(F &&f) {
+	  unsigned head = *cq_head;
+	  unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+	  unsigned count = 0;
+	  for (; head != tail; head++, count++) {
+		  f(cqes[head & cq_mask]);
+	  }
+	  __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+	  return count;
+  }
+
+  // 注册缓冲区环：count 个（2 的幂）大小为 size 的缓冲区，组号 group
+  bool setupBufferRing(uint16_t group, unsigned count, unsigned size);
+  char *buffer(uint16_t bid) const { return buffers + static_cast<size_t>(bid) * buffer_size; }
+  // 缓冲区中的数据处理完后归还给内核
+  void recycleBuffer(uint16_t bid);
+
+  // io_uring_enter 调用次数，用于统计每个请求的系统调用数
+  uint64_t enterCount() const { return enter_count; }
+ private:
+  int ring_fd = -1;
+  void *sq_ptr = nullptr;
+  size_t sq_size = 0;
+  void *cq_ptr = nullptr;
+  size_t cq_size = 0;
+  io_uring_sqe *sqes = nullptr;
+  size_t sqes_size = 0;
+  unsigned *sq_head = nullptr;
+  unsigned *sq_tail = nullptr;
+  unsigned sq_mask = 0;
+  unsigned sq_entries = 0;
+  unsigned sqe_tail = 0;        // 已准备但可能尚未提交的 SQE 位置
+  unsigned sqe_submitted = 0;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned cq_mask = 0;
+  io_uring_cqe *cqes = nullptr;
+  uint64_t enter_count = 0;
+
+  io_uring_buf_ring *buf_ring = nullptr;
+  size_t buf_ring_size = 0;
+  char *buffers = nullptr;
+  unsigned buffer_count = 0;
+  unsigned buffer_size = 0;
+  uint16_t buf_tail = 0;
+};
+
+#endif //TINYRPC_SRC_UTILS_IOURING_H_
@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file           : Listener.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/4/3
+  ******************************************************************************
+  */
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Listener.h"
+#include "Log.h"
+
+int listenTcp(const std::string &ip, int port, bool reuse_port, int *bound_port) {
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	if (inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
+		LOG_ERROR("bad listen ip: {}", ip);
+		return -1;
+	}
+
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		return -1;
+	}
+	int one = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	if (reuse_port) {
+		setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+	}
+	if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+		LOG_ERROR("listen {}:{} failed: {}", ip, port, strerror(errno));
+		close(fd);
+		return -1;
+	}
+	if (bound_port != nullptr) {
+		socklen_t len = sizeof(addr);
+		getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len);
+		*bound_port = ntohs(addr.sin_port);
+	}
+	return fd;
+}
@@ -0,0 +1,20 @@
+/**
+  ******************************************************************************
+  * @file           : Listener.h
+  * @author         : xy
+  * @brief          : 创建 TCP 监听套接字
+  * @attention      : reuse_port 为 true 时设置 SO_REUSEPORT，多个套接字可绑定同一端口，由内核按连接四元组分配新连接；
+  *                   返回阻塞套接字（io_uring 对非阻塞套接字会直接返回 EAGAIN，libhv 接管时自行设为非阻塞）
+  * @date           : 2025/4/3
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_LISTENER_H_
+#define TINYRPC_SRC_UTILS_LISTENER_H_
+
+#include <string>
+
+// 失败返回 -1；port 为 0 时由系统分配，实际端口写入 bound_port
+int listenTcp(const std::string &ip, int port, bool reuse_port, int *bound_port = nullptr);
+
+#endif //TINYRPC_SRC_UTILS_LISTENER_H_
@@ -53,8 +53,8 @@ std::string formatMessage(const std::string &format, Args &&... args) {
 
 
 template<typename... Args>
-void log(LOGLEVEL level, const char* func, const std::string &format, Args &&... args) {
-	auto cur_level = Logger::getInstance()->level();
+void logTo(Logger *logger, LOGLEVEL level, const char* func, const std::string &format, Args &&... args) {
+	auto cur_level = logger->level();
 	if (level < cur_level) {
 		return;
 	}
@@ -92,7 +92,12 @@ void log(LOGLEVEL level, const char* func, const std::string &format, Args &&...
 	log_stream << "[" << time_stream.str() << "] [" << thread_id << "] [" << level_str << "] "
 			   << "[" << func << "] " << message;
 
-	Logger::getInstance()->Log(log_stream.str());
+	logger->Log(log_stream.str(), level);
+}
+
+template<typename... Args>
+void log(LOGLEVEL level, const char* func, const std::string &format, Args &&... args) {
+	logTo(Logger::getInstance(), level, func, format, std::forward<Args>(args)...);
 }
 
 
@@ -100,6 +105,8 @@ void log(LOGLEVEL level, const char* func, const std::string &format, Args &&...
 #define LOG_DEBUG(format, ...) log(LOGLEVEL::DEBUG, __PRETTY_FUNCTION__, format, ##__VA_ARGS__)
 #define LOG_ERROR(format, ...) log(LOGLEVEL::ERROR, __PRETTY_FUNCTION__, format, ##__VA_ARGS__)
 #define LOG_FATAL(format, ...) log(LOGLEVEL::FATAL, __PRETTY_FUNCTION__, format, ##__VA_ARGS__)
+// 慢请求单独写入 slow_ 前缀的日志文件
+#define LOG_SLOW(format, ...) logTo(Logger::getInstance("slow"), LOGLEVEL::INFO, __PRETTY_FUNCTION__, format, ##__VA_ARGS__)
 
 
 
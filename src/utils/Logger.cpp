@@ -13,6 +13,19 @@
 #include "Config.h"
 
 Logger *Logger::instance_ = nullptr;
+std::map<std::string, Logger *> Logger::named_instances_;
+static std::mutex named_mtx;
+
+/**
+ * @brief 读取数值型配置项，不存在时返回默认值
+ */
+static size_t getConfigNumber(const std::string &key, size_t default_value) {
+	auto value = Config::getInstance()->get(key);
+	if (value == std::nullopt || value->empty()) {
+		return default_value;
+	}
+	return std::stoul(value.value());
+}
 
 Logger *Logger::getInstance() {
 	static std::once_flag flag;
@@ -23,16 +36,57 @@ Logger *Logger::getInstance() {
 	return instance_;
 }
 
-Logger::Logger() {
-	auto logPath = Config::getInstance()->get("log_path");
-	assert(logPath != std::nullopt);
-	auto new_path = logPath.value() + getCurTime() + ".log";
-	log_file_.open(new_path, std::ios::app);
+Logger *Logger::getInstance(const std::string &name) {
+	static std::once_flag flag;
+	std::call_once(flag, [&] {
+	  atexit([] {
+		std::lock_guard<std::mutex> lock(named_mtx);
+		for (auto &item : named_instances_) {
+			delete item.second;
+		}
+		named_instances_.clear();
+	  });
+	});
+	std::lock_guard<std::mutex> lock(named_mtx);
+	auto &logger = named_instances_[name];
+	if (logger == nullptr) {
+		logger = new Logger(name);
+	}
+	return logger;
+}
+
+Logger::Logger(const std::string &name, const std::string &dir)
+	: queue_(getConfigNumber("log_queue_capacity", kDefaultLogQueueCapacity)), name_(name) {
+	if (dir.empty()) {
+		auto logPath = Config::getInstance()->get("log_path");
+		assert(logPath != std::nullopt);
+		log_dir_ = logPath.value();
+	} else {
+		log_dir_ = dir;
+	}
+
+	auto policy = Config::getInstance()->get("log_overflow_policy");
+	if (policy != std::nullopt) {
+		policy_ = parsePolicy(policy.value());
+	}
+	max_file_size_ = getConfigNumber("log_max_size_mb", 0) * 1024 * 1024;
+	roll_seconds_ = static_cast<time_t>(getConfigNumber("log_roll_seconds", 0));
+	// 具名实例（如慢请求日志）不受 log_level 影响，否则 log_level=ERROR 时慢请求日志也被关闭
+	if (name_.empty()) {
+		level_watch_id_ = Config::getInstance()->watch("log_level", [this](const std::optional<std::string> &level) {
+		  setLevel(level == std::nullopt ? LOGLEVEL::INFO : parseLevel(level.value()));
+		});
+	}
+
+	openFile();
 
 	work_thread_ = std::thread(&Logger::writeLog, this);
 }
 
 Logger::~Logger() {
+	if (level_watch_id_ != 0) {
+		Config::getInstance()->unwatch(level_watch_id_);
+	}
 	queue_.stop();
 	if (work_thread_.joinable()) {
 		work_thread_.join();
@@ -42,17 +96,112 @@ Logger::~Logger() {
 	}
 }
 
-void Logger::Log(const std::string &log) {
-	queue_.push(log);
+/**
+ * @brief 投递一条日志，队列满时按溢出策略处理
+ * @param log
+ * @param level
+ */
+void Logger::Log(const std::string &log, LOGLEVEL level) {
+	switch (policy_) {
+		case OverflowPolicy::BLOCK:
+			queue_.push(log);
+			return;
+		case OverflowPolicy::DROP_BY_LEVEL:
+			if (level >= LOGLEVEL::ERROR) {
+				queue_.push(log);
+				return;
+			}
+			break;
+		case OverflowPolicy::DROP_NEWEST:
+			break;
+	}
+	if (!queue_.tryPush(log)) {
+		dropped_count_.fetch_add(1, std::memory_order_relaxed);
+	}
 }
 
 void Logger::writeLog() {
 	std::string message;
 	while (queue_.pop(message)) {
-		 std::cout << message << std::endl;
+		if (needRoll()) {
+			openFile();
+		}
+
+		// 有日志被丢弃时，在文件中留下记录
+		auto dropped = dropped_count_.load(std::memory_order_relaxed);
+		if (dropped != reported_dropped_) {
+			std::string note = "[logger] dropped " + std::to_string(dropped - reported_dropped_) + " messages";
+			log_file_ << note << "\n";
+			cur_file_size_ += note.size() + 1;
+			reported_dropped_ = dropped;
+		}
+
+		std::cout << message << std::endl;
 		log_file_ << message << "\n";
 		log_file_.flush();
+		cur_file_size_ += message.size() + 1;
+	}
+}
+
+/**
+ * @brief 判断当前文件是否需要滚动
+ */
+bool Logger::needRoll() const {
+	if (max_file_size_ != 0 && cur_file_size_ >= max_file_size_) {
+		return true;
+	}
+	if (roll_seconds_ != 0 && time(nullptr) - file_open_time_ >= roll_seconds_) {
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief 打开新的日志文件，同一秒内多次滚动时追加序号区分
+ */
+void Logger::openFile() {
+	if (log_file_.is_open()) {
+		log_file_.close();
+	}
+
+	auto name = getCurTime();
+	if (name == file_name_) {
+		roll_index_++;
+	} else {
+		file_name_ = name;
+		roll_index_ = 0;
+	}
+	auto new_path = log_dir_ + (name_.empty() ? "" : name_ + "_") + file_name_;
+	if (roll_index_ != 0) {
+		new_path += "." + std::to_string(roll_index_);
+	}
+	log_file_.open(new_path + ".log", std::ios::app);
+
+	cur_file_size_ = 0;
+	file_open_time_ = time(nullptr);
+}
+
+OverflowPolicy Logger::parsePolicy(const std::string &policy) {
+	if (policy == "drop_newest") {
+		return OverflowPolicy::DROP_NEWEST;
+	}
+	if (policy == "drop_by_level") {
+		return OverflowPolicy::DROP_BY_LEVEL;
+	}
+	return OverflowPolicy::BLOCK;
+}
+
+LOGLEVEL Logger::parseLevel(const std::string &level) {
+	if (level == "DEBUG") {
+		return LOGLEVEL::DEBUG;
+	}
+	if (level == "ERROR") {
+		return LOGLEVEL::ERROR;
+	}
+	if (level == "FATAL") {
+		return LOGLEVEL::FATAL;
 	}
+	return LOGLEVEL::INFO;
 }
 
 std::string Logger::getCurTime() {
@@ -3,7 +3,7 @@
   * @file           : Logger.h
   * @author         : xy
   * @brief          : 异步日志
-  * @attention      : None
+  * @attention      : 有界队列 + 溢出策略；按大小/时间滚动日志文件（在写线程完成）
   * @date           : 2025/3/18
   ******************************************************************************
   */
@@ -12,42 +12,77 @@
 #define TINYRPC_SRC_UTILS_LOGGER_H_
 
 #include <atomic>
+#include <map>
 #include <thread>
 #include <fstream>
 #include <gtest/gtest.h>
 #include "SafeQueue.h"
 
+// 按严重程度递增排列，低于当前级别的日志被丢弃
 enum class LOGLEVEL {
-  INFO,
   DEBUG,
+  INFO,
   ERROR,
   FATAL
 };
 
+// 日志队列满时的处理策略
+enum class OverflowPolicy {
+  BLOCK,            // 阻塞调用方，直到写线程腾出空间
+  DROP_NEWEST,      // 丢弃当前这条日志
+  DROP_BY_LEVEL     // ERROR 及以上阻塞，其余丢弃
+};
+
+constexpr size_t kDefaultLogQueueCapacity = 65536;
+
 class Logger {
  public:
   static Logger *getInstance();
-  Logger();
+  // 写入独立文件的日志实例（如慢请求日志），文件名以 name 为前缀
+  static Logger *getInstance(const std::string &name);
+  // dir 为空时写入配置项 log_path 指定的目录，否则写入 dir（以 / 结尾）
+  explicit Logger(const std::string &name = "", const std::string &dir = "");
   ~Logger();
-  void Log(const std::string &log);
+  void Log(const std::string &log, LOGLEVEL level = LOGLEVEL::INFO);
  public:
-  void setLevel(LOGLEVEL level) { log_level_ = level; };
-  LOGLEVEL level() { return log_level_; };
+  void setLevel(LOGLEVEL level) { log_level_.store(level, std::memory_order_relaxed); };
+  LOGLEVEL level() { return log_level_.load(std::memory_order_relaxed); };
+  uint64_t droppedCount() const { return dropped_count_.load(std::memory_order_relaxed); }
+  size_t queueSize() { return queue_.size(); }
  private:
   static std::string getCurTime();
+  static OverflowPolicy parsePolicy(const std::string &policy);
+  static LOGLEVEL parseLevel(const std::string &level);
   void writeLog();
+  void openFile();
+  bool needRoll() const;
   static void destroy();
  private:
   static Logger *instance_;
+  static std::map<std::string, Logger *> named_instances_;
   SafeQueue<std::string> queue_;
   std::thread work_thread_;
   std::ofstream log_file_;
   std::atomic<bool> is_exit_ = false;
-  LOGLEVEL log_level_ = LOGLEVEL::INFO;
+  std::atomic<LOGLEVEL> log_level_ = LOGLEVEL::INFO;    // 默认实例跟随配置项 log_level（可热更新），具名实例固定为 INFO
+  uint64_t level_watch_id_ = 0;
+  OverflowPolicy policy_ = OverflowPolicy::BLOCK;
+  std::atomic<uint64_t> dropped_count_ = 0;
  private:
-
+  // 以下成员只在写线程中访问
+  std::string log_dir_;
+  std::string name_;
+  std::string file_name_;
+  int roll_index_ = 0;
+  size_t max_file_size_ = 0;        // 单个文件最大字节数，0 表示不按大小滚动
+  time_t roll_seconds_ = 0;         // 单个文件最长写入时间，0 表示不按时间滚动
+  size_t cur_file_size_ = 0;
+  time_t file_open_time_ = 0;
+  uint64_t reported_dropped_ = 0;
  public:
   FRIEND_TEST(LoggerTest, LoggerBase);
+  FRIEND_TEST(LoggerTest, RollBySize);
+  FRIEND_TEST(LoggerTest, LevelFollowsConfig);
 };
 
 #endif //TINYRPC_SRC_UTILS_LOGGER_H_
@@ -0,0 +1,164 @@
+/**
+  ******************************************************************************
+  * @file           : Lz4.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 贪心匹配 + 4 字节哈希表，窗口 64KB；格式细节见 lz4 block format 文档
+  * @date           : 2025/3/29
+  ******************************************************************************
+  */
+
+#include <cstring>
+#include <vector>
+#include "Lz4.h"
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;     // 最后 5 个字节必须是字面量
+constexpr size_t kMfLimit = 12;         // 最后一个匹配必须在末尾 12 字节之前开始
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 14;
+
+inline uint32_t read32(const char *p) {
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline uint32_t hash(uint32_t sequence) {
+	return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+// 长度 >= 15 的部分用若干个 255 加余数表示
+inline char *writeLength(char *op, size_t length) {
+	while (length >= 255) {
+		*op++ = static_cast<char>(255);
+		length -= 255;
+	}
+	*op++ = static_cast<char>(length);
+	return op;
+}
+
+inline char *writeSequence(char *op, const char *literal, size_t literal_len, size_t offset, size_t match_len) {
+	auto token = op++;
+	*token = static_cast<char>((literal_len >= 15 ? 15 : literal_len) << 4);
+	if (literal_len >= 15) {
+		op = writeLength(op, literal_len - 15);
+	}
+	std::memcpy(op, literal, literal_len);
+	op += literal_len;
+	if (match_len == 0) {
+		return op;    // 末尾的字面量序列没有匹配部分
+	}
+	*op++ = static_cast<char>(offset & 0xff);
+	*op++ = static_cast<char>(offset >> 8);
+	auto ml = match_len - kMinMatch;
+	*token = static_cast<char>(*token | (ml >= 15 ? 15 : ml));
+	if (ml >= 15) {
+		op = writeLength(op, ml - 15);
+	}
+	return op;
+}
+
+}
+
+size_t Lz4::compress(const char *src, size_t size, char *dst) {
+	char *op = dst;
+	size_t anchor = 0;
+	if (size >= kMfLimit + 1) {
+		std::vector<uint32_t> table(1 << kHashLog, 0);    // 存位置 + 1，0 表示空
+		const size_t match_start_limit = size - kMfLimit;
+		const size_t match_end_limit = size - kLastLiterals;
+		size_t ip = 0;
+		size_t misses = 0;
+		while (ip <= match_start_limit) {
+			auto sequence = read32(src + ip);
+			auto &slot = table[hash(sequence)];
+			size_t ref = slot;
+			slot = static_cast<uint32_t>(ip + 1);
+			if (ref == 0 || ip - (ref - 1) > kMaxOffset || read32(src + ref - 1) != sequence) {
+				ip += 1 + (misses++ >> 6);    // 连续未命中时加大步长，加速跳过不可压缩数据
+				continue;
+			}
+			ref -= 1;
+			misses = 0;
+
+			size_t match_len = kMinMatch;
+			while (ip + match_len < match_end_limit && src[ref + match_len] == src[ip + match_len]) {
+				match_len++;
+			}
+			op = writeSequence(op, src + anchor, ip - anchor, ip - ref, match_len);
+			ip += match_len;
+			anchor = ip;
+		}
+	}
+	op = writeSequence(op, src + anchor, size - anchor, 0, 0);
+	return op - dst;
+}
+
+long Lz4::decompress(const char *src, size_t size, char *dst, size_t capacity) {
+	const auto *ip = reinterpret_cast<const uint8_t *>(src);
+	const auto *end = ip + size;
+	size_t op = 0;
+	while (ip < end) {
+		auto token = *ip++;
+
+		size_t literal_len = token >> 4;
+		if (literal_len == 15) {
+			uint8_t b;
+			do {
+				if (ip >= end) {
+					return -1;
+				}
+				b = *ip++;
+				literal_len += b;
+			} while (b == 255);
+		}
+		if (literal_len > static_cast<size_t>(end - ip) || literal_len > capacity - op) {
+			return -1;
+		}
+		std::memcpy(dst + op, ip, literal_len);
+		ip += literal_len;
+		op += literal_len;
+		if (ip == end) {
+			break;    // 最后一个序列只有字面量
+		}
+
+		if (end - ip < 2) {
+			return -1;
+		}
+		size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > op) {
+			return -1;
+		}
+
+		size_t match_len = token & 15;
+		if (match_len == 15) {
+			uint8_t b;
+			do {
+				if (ip >= end) {
+					return -1;
+				}
+				b = *ip++;
+				match_len += b;
+			} while (b == 255);
+		}
+		match_len += kMinMatch;
+		if (match_len > capacity - op) {
+			return -1;
+		}
+		// 匹配区可能与输出重叠（offset < match_len），逐字节复制
+		auto from = op - offset;
+		if (offset >= match_len) {
+			std::memcpy(dst + op, dst + from, match_len);
+		} else {
+			for (size_t i = 0; i < match_len; i++) {
+				dst[op + i] = dst[from + i];
+			}
+		}
+		op += match_len;
+	}
+	return static_cast<long>(op);
+}
@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file           : Lz4.h
+  * @author         : xy
+  * @brief          : LZ4 block 格式的压缩/解压（自带实现，与 liblz4 的 block 格式兼容）
+  * @attention      : 只实现 block 格式，不含 frame 格式；原始长度由调用方另行保存
+  * @date           : 2025/3/29
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_LZ4_H_
+#define TINYRPC_SRC_UTILS_LZ4_H_
+
+#include <cstddef>
+#include <cstdint>
+
+class Lz4 {
+ public:
+  // 压缩结果的最大长度
+  static size_t compressBound(size_t size) { return size + size / 255 + 16; }
+  // 返回压缩后的长度，dst 至少 compressBound(size) 字节
+  static size_t compress(const char *src, size_t size, char *dst);
+  // 返回解压后的长度，数据非法或超出 capacity 时返回 -1
+  static long decompress(const char *src, size_t size, char *dst, size_t capacity);
+};
+
+#endif //TINYRPC_SRC_UTILS_LZ4_H_
@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************
+  * @file           : Profiler.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : 信号处理函数里只做 backtrace 和原子操作，聚合与符号化放在采样结束后
+  * @date           : 2025/3/26
+  ******************************************************************************
+  */
+
+#include <atomic>
+#include <csignal>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+#include "Profiler.h"
+
+namespace {
+
+constexpr int kMaxDepth = 32;
+constexpr size_t kMaxSamples = 64 * 1024;
+
+struct Sample {
+  int depth;
+  void *frames[kMaxDepth];
+};
+
+std::atomic<bool> g_running = false;
+std::atomic<size_t> g_sample_count = 0;
+std::atomic<Sample *> g_samples = nullptr;
+
+}
+
+void CpuProfiler::onSignal(int) {
+	auto samples = g_samples.load(std::memory_order_acquire);
+	if (samples == nullptr) {
+		return;
+	}
+	auto idx = g_sample_count.fetch_add(1, std::memory_order_relaxed);
+	if (idx >= kMaxSamples) {
+		return;
+	}
+	auto &sample = samples[idx];
+	sample.depth = backtrace(sample.frames, kMaxDepth);
+}
+
+std::optional<std::string> CpuProfiler::profile(int seconds, int hz) {
+	bool expected = false;
+	if (!g_running.compare_exchange_strong(expected, true)) {
+		return std::nullopt;
+	}
+
+	std::unique_ptr<Sample[]> samples(new Sample[kMaxSamples]);
+	g_sample_count = 0;
+	g_samples.store(samples.get(), std::memory_order_release);
+
+	// backtrace 首次调用会加载 libgcc，提前调用一次，避免在信号处理函数中触发
+	void *warmup[1];
+	backtrace(warmup, 1);
+
+	// 处理函数装上后不再卸载：定时器停止后仍可能有未递送的 SIGPROF，默认动作会终止进程
+	struct sigaction action{};
+	action.sa_handler = &CpuProfiler::onSignal;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGPROF, &action, nullptr);
+
+	struct itimerval timer{};
+	timer.it_interval.tv_sec = 0;
+	timer.it_interval.tv_usec = 1000000 / hz;
+	timer.it_value = timer.it_interval;
+	setitimer(ITIMER_PROF, &timer, nullptr);
+
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+	struct itimerval stop{};
+	setitimer(ITIMER_PROF, &stop, nullptr);
+	g_samples.store(nullptr, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));    // 等待正在执行的信号处理函数返回
+
+	// 聚合相同调用栈（去掉信号处理相关的前两帧），按 root;...;leaf 输出
+	auto total = std::min(g_sample_count.load(), kMaxSamples);
+	std::map<std::string, size_t> folded;
+	std::map<void *, std::string> symbols;
+	for (size_t i = 0; i < total; i++) {
+		const auto &sample = samples[i];
+		std::string stack;
+		for (int d = sample.depth - 1; d >= 2; d--) {
+			auto iter = symbols.find(sample.frames[d]);
+			if (iter == symbols.end()) {
+				iter = symbols.emplace(sample.frames[d], symbolize(sample.frames[d])).first;
+			}
+			if (!stack.empty()) {
+				stack += ';';
+			}
+			stack += iter->second;
+		}
+		folded[stack]++;
+	}
+
+	std::ostringstream oss;
+	oss << "# samples=" << total << " seconds=" << seconds << " hz=" << hz << "\n";
+	for (const auto &item : folded) {
+		oss << item.first << " " << item.second << "\n";
+	}
+
+	g_running = false;
+	return oss.str();
+}
+
+std::string CpuProfiler::symbolize(void *addr) {
+	Dl_info info{};
+	if (dladdr(addr, &info) == 0 || info.dli_sname == nullptr) {
+		std::ostringstream oss;
+		oss << addr;
+		return oss.str();
+	}
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+	std::string name = (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+	free(demangled);
+	// folded 格式用 ';' 和空格分隔，替换掉名字里的空格
+	for (auto &c : name) {
+		if (c == ' ' || c == ';') {
+			c = '_';
+		}
+	}
+	return name;
+}
@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file           : Profiler.h
+  * @author         : xy
+  * @brief          : 基于 SIGPROF 的按需 CPU 采样
+  * @attention      : 同一时刻只允许一个采样任务；输出 folded stack 格式，可直接交给 flamegraph.pl
+  *                   链接时加 -rdynamic 才能解析出非导出函数名
+  * @date           : 2025/3/26
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_PROFILER_H_
+#define TINYRPC_SRC_UTILS_PROFILER_H_
+
+#include <string>
+#include <optional>
+
+class CpuProfiler {
+ public:
+  // 阻塞 seconds 秒进行采样，hz 为每秒采样次数；已有采样在进行时返回 std::nullopt
+  static std::optional<std::string> profile(int seconds, int hz = 99);
+ private:
+  static void onSignal(int sig);
+  static std::string symbolize(void *addr);
+};
+
+#endif //TINYRPC_SRC_UTILS_PROFILER_H_
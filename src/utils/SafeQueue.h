@@ -3,7 +3,7 @@
   * @file           : SafeQueue.h
   * @author         : xy
   * @brief          : 线程安全的队列（加锁实现）
-  * @attention      : None
+  * @attention      : capacity 为 0 表示无界；有界时 push 阻塞、tryPush 失败返回；stop 后两者都不再入队
   * @date           : 2025/3/18
   ******************************************************************************
   */
@@ -20,10 +20,31 @@
 template<typename T>
 class SafeQueue {
  public:
-  void push(const T &value) {
+  explicit SafeQueue(size_t capacity = 0) : capacity_(capacity) {}
+
+  // 队列满时阻塞，直到有空位或队列停止；队列已停止时返回 false
+  bool push(const T &value) {
 	  std::unique_lock<std::mutex> lock(mtx_);
+	  not_full_.wait(lock, [this]() {
+		return !full() || !isRun_;
+	  });
+	  if (!isRun_) {
+		  return false;
+	  }
 	  queue_.push(value);
 	  cond_.notify_one();
+	  return true;
+  }
+
+  // 队列满或已停止时不等待，直接返回 false
+  bool tryPush(const T &value) {
+	  std::unique_lock<std::mutex> lock(mtx_);
+	  if (full() || !isRun_) {
+		  return false;
+	  }
+	  queue_.push(value);
+	  cond_.notify_one();
+	  return true;
   }
 
   bool pop(T &value) {
@@ -36,25 +57,42 @@ class SafeQueue {
 	  }
 	  value = queue_.front();
 	  queue_.pop();
+	  not_full_.notify_one();
 	  return true;
   }
 
+  size_t size() {
+	  std::unique_lock<std::mutex> lock(mtx_);
+	  return queue_.size();
+  }
+
+  size_t capacity() const { return capacity_; }
+
   void stop() {
 	  std::unique_lock<std::mutex> lock(mtx_);
 	  isRun_ = false;
 	  cond_.notify_all();
+	  not_full_.notify_all();
   }
 
+ private:
+  bool full() const { return capacity_ != 0 && queue_.size() >= capacity_; }
+
  private:
   std::queue<T> queue_;
   std::mutex mtx_;
   std::condition_variable cond_;
+  std::condition_variable not_full_;
+  size_t capacity_;
   bool isRun_ = true;
  public:
   FRIEND_TEST(SafeQueueTest, PushAndPopSingleThread);
   FRIEND_TEST(SafeQueueTest, PopBlocksUntilPush);
   FRIEND_TEST(SafeQueueTest, MultipleProducersAndConsumers);
   FRIEND_TEST(SafeQueueTest, StopFunctionality);
+  FRIEND_TEST(SafeQueueTest, BoundedTryPushFailsWhenFull);
+  FRIEND_TEST(SafeQueueTest, BoundedPushBlocksUntilPop);
+  FRIEND_TEST(SafeQueueTest, PushAfterStopRejected);
 };
 
 #endif //TINYRPC_SRC_UTILS_SAFEQUEUE_H_
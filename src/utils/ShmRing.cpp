@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file           : ShmRing.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : head/tail 为单调递增的字节位置，取模后得到缓冲区中的偏移
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include "ShmRing.h"
+
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield");
+#endif
+}
+
+ShmRing::ShmRing(void *memory, size_t capacity, bool init)
+	: header(static_cast<ShmRingHeader *>(memory)),
+	  buffer(static_cast<char *>(memory) + sizeof(ShmRingHeader)),
+	  capacity(capacity),
+	  mask(capacity - 1) {
+	if (init) {
+		new(header) ShmRingHeader();
+		header->head.store(0, std::memory_order_relaxed);
+		header->tail.store(0, std::memory_order_relaxed);
+		header->waiting.store(0, std::memory_order_relaxed);
+		header->capacity = capacity;
+	}
+}
+
+bool ShmRing::tryWrite(const char *data, size_t size) {
+	auto record = recordSize(size);
+	if (size > maxRecord()) {
+		return false;
+	}
+	auto head = header->head.load(std::memory_order_relaxed);
+	auto tail = header->tail.load(std::memory_order_acquire);
+	auto offset = head & mask;
+	auto to_end = capacity - offset;
+	// 末尾放不下时跳到开头，跳过的部分也算作占用
+	auto need = to_end < record ? to_end + record : record;
+	if (capacity - (head - tail) < need) {
+		return false;
+	}
+	if (to_end < record) {
+		uint32_t marker = kWrapMarker;
+		std::memcpy(buffer + offset, &marker, sizeof(marker));
+		head += to_end;
+		offset = 0;
+	}
+	auto len = static_cast<uint32_t>(size);
+	std::memcpy(buffer + offset, &len, sizeof(len));
+	std::memcpy(buffer + offset + kRecordHead, data, size);
+	header->head.store(head + record, std::memory_order_release);
+	return true;
+}
+
+void ShmRing::notify(int event_fd) {
+	// 与 prepareWait 中的 fence 配对：要么消费者看到新数据，要么生产者看到 waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (header->waiting.load(std::memory_order_relaxed)) {
+		eventfd_write(event_fd, 1);
+	}
+}
+
+bool ShmRing::peek(const char *&data, size_t &size) {
+	if (corrupt) {
+		return false;
+	}
+	auto tail = header->tail.load(std::memory_order_relaxed);
+	while (true) {
+		auto head = header->head.load(std::memory_order_acquire);
+		if (tail == head) {
+			return false;
+		}
+		auto offset = tail & mask;
+		uint32_t len = 0;
+		if (head - tail > capacity || (offset & 7) != 0) {
+			corrupt = true;
+			return false;
+		}
+		std::memcpy(&len, buffer + offset, sizeof(len));
+		if (len == kWrapMarker) {
+			tail += capacity - offset;
+			header->tail.store(tail, std::memory_order_release);
+			continue;
+		}
+		if (len > maxRecord() || offset + recordSize(len) > capacity || recordSize(len) > head - tail) {
+			corrupt = true;
+			return false;
+		}
+		data = buffer + offset + kRecordHead;
+		size = len;
+		peeked = recordSize(len);
+		return true;
+	}
+}
+
+void ShmRing::consume() {
+	auto tail = header->tail.load(std::memory_order_relaxed);
+	header->tail.store(tail + peeked, std::memory_order_release);
+	peeked = 0;
+}
+
+bool ShmRing::empty() const {
+	return header->tail.load(std::memory_order_relaxed) == header->head.load(std::memory_order_acquire);
+}
+
+bool ShmRing::prepareWait() {
+	header->waiting.store(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!empty()) {
+		header->waiting.store(0, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+void ShmRing::finishWait() {
+	header->waiting.store(0, std::memory_order_relaxed);
+}
+
+bool ShmWaiter::wait(ShmRing &ring, int event_fd, int watch_fd) {
+	for (uint32_t i = 0; i < spin_limit; i++) {
+		if (!ring.empty()) {
+			spin_limit = std::min(spin_limit * 2, kMaxSpin);
+			return true;
+		}
+		cpuRelax();
+	}
+	spin_limit = std::max(spin_limit / 2, kMinSpin);
+
+	while (ring.prepareWait()) {
+		struct pollfd fds[2];
+		fds[0] = {event_fd, POLLIN, 0};
+		fds[1] = {watch_fd, POLLIN, 0};
+		auto ret = poll(fds, watch_fd >= 0 ? 2 : 1, -1);
+		if (ret < 0 && errno != EINTR) {
+			ring.finishWait();
+			return false;
+		}
+		if (fds[0].revents & POLLIN) {
+			eventfd_t value;
+			eventfd_read(event_fd, &value);
+		}
+		if (watch_fd >= 0 && fds[1].revents != 0) {
+			ring.finishWait();
+			return false;
+		}
+	}
+	ring.finishWait();
+	return true;
+}
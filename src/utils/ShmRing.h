@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file           : ShmRing.h
+  * @author         : xy
+  * @brief          : 位于共享内存中的单生产者单消费者环形缓冲区，按记录读写
+  * @attention      : 记录格式为 长度(4字节) + 填充(4字节) + 数据，按 8 字节对齐；
+  *                   剩余空间放不下一条记录时写入跳转标记，保证每条记录在内存中连续，消费者可原地读取；
+  *                   消费者无数据时先自旋，再设置 waiting 并在 eventfd 上阻塞，生产者写入后检查 waiting 决定是否唤醒
+  * @date           : 2025/4/1
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_SHMRING_H_
+#define TINYRPC_SRC_UTILS_SHMRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 共享内存中的环形缓冲区头部，生产者与消费者的字段分处不同缓存行
+struct ShmRingHeader {
+  alignas(64) std::atomic<uint64_t> head;       // 生产者写入位置
+  alignas(64) std::atomic<uint64_t> tail;       // 消费者读取位置
+  alignas(64) std::atomic<uint32_t> waiting;    // 消费者是否阻塞在 eventfd 上
+  uint64_t capacity;
+};
+
+class ShmRing {
+ public:
+  // memory 指向 regionSize(capacity) 字节的共享内存，capacity 为 2 的幂；init 为 true 时初始化头部
+  ShmRing(void *memory, size_t capacity, bool init);
+  static size_t regionSize(size_t capacity) { return sizeof(ShmRingHeader) + capacity; }
+  // 单条记录的最大长度
+  size_t maxRecord() const { return capacity / 2 - kRecordHead; }
+
+  // 生产者：空间不足时返回 false
+  bool tryWrite(const char *data, size_t size);
+  // 生产者：写入后调用，消费者正在等待时通过 event_fd 唤醒
+  void notify(int event_fd);
+
+  // 消费者：取出下一条记录的地址（位于共享内存中），处理完后调用 consume
+  bool peek(const char *&data, size_t &size);
+  void consume();
+  bool empty() const;
+  // 对端写入了越界的位置或长度（共享内存可被对端任意修改），此后不应再读取
+  bool corrupted() const { return corrupt; }
+  // 消费者：准备阻塞，返回 false 表示期间有新数据，不需要阻塞
+  bool prepareWait();
+  void finishWait();
+ private:
+  static constexpr size_t kRecordHead = 8;
+  static constexpr uint32_t kWrapMarker = 0xFFFFFFFF;
+  static size_t recordSize(size_t size) { return (kRecordHead + size + 7) & ~size_t(7); }
+  ShmRingHeader *header;
+  char *buffer;
+  size_t capacity;
+  size_t mask;
+  size_t peeked = 0;    // 最近一次 peek 的记录长度（含头部与填充）
+  bool corrupt = false;
+};
+
+// 消费者的自适应等待：最近一次自旋等到了数据就加长自旋，否则缩短
+class ShmWaiter {
+ public:
+  // 等待 ring 中有数据；watch_fd 可读或挂断（对端退出）时返回 false
+  bool wait(ShmRing &ring, int event_fd, int watch_fd);
+  uint32_t spinLimit() const { return spin_limit; }
+ private:
+  static constexpr uint32_t kMinSpin = 64;
+  static constexpr uint32_t kMaxSpin = 1 << 16;
+  uint32_t spin_limit = kMinSpin;
+};
+
+#endif //TINYRPC_SRC_UTILS_SHMRING_H_
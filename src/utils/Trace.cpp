@@ -0,0 +1,187 @@
+/**
+  ******************************************************************************
+  * @file           : Trace.cpp
+  * @author         : xy
+  * @brief          : None
+  * @attention      : None
+  * @date           : 2025/3/28
+  ******************************************************************************
+  */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "Trace.h"
+#include "Config.h"
+
+void SpanRecord::setName(const std::string &value) {
+	auto len = std::min(value.size(), sizeof(name) - 1);
+	std::memcpy(name, value.data(), len);
+	name[len] = '\0';
+}
+
+SpanRing::SpanRing(size_t capacity) : cells_(new Cell[capacity]), mask_(capacity - 1) {
+	for (size_t i = 0; i < capacity; i++) {
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool SpanRing::push(const SpanRecord &span) {
+	auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+	for (;;) {
+		auto &cell = cells_[pos & mask_];
+		auto seq = cell.sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+		if (diff == 0) {
+			if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				cell.span = span;
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;    // 已满
+		} else {
+			pos = enqueue_pos_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool SpanRing::pop(SpanRecord &span) {
+	auto &cell = cells_[dequeue_pos_ & mask_];
+	auto seq = cell.sequence.load(std::memory_order_acquire);
+	if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos_ + 1) < 0) {
+		return false;    // 为空
+	}
+	span = cell.span;
+	cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+	dequeue_pos_++;
+	return true;
+}
+
+Tracer *Tracer::instance_ = nullptr;
+
+Tracer *Tracer::getInstance() {
+	static std::once_flag flag;
+	std::call_once(flag, [&] {
+	  auto config = Config::getInstance();
+	  auto rate = config->get("trace_sample_rate");
+	  auto path = config->get("trace_path");
+	  if (path == std::nullopt) {
+		  path = config->get("log_path").value_or("") + "trace.jsonl";
+	  }
+	  instance_ = new Tracer(path.value(), rate == std::nullopt ? 0.01 : std::stod(rate.value()));
+	  atexit(destroy);
+	});
+	return instance_;
+}
+
+Tracer::Tracer(const std::string &path, double sample_rate, size_t capacity) : ring_(capacity) {
+	if (sample_rate >= 1.0) {
+		sample_threshold_ = UINT64_MAX;
+	} else if (sample_rate <= 0.0) {
+		sample_threshold_ = 0;
+	} else {
+		sample_threshold_ = static_cast<uint64_t>(sample_rate * 18446744073709551616.0);
+	}
+	file_.open(path, std::ios::app);
+	export_thread_ = std::thread(&Tracer::exportLoop, this);
+}
+
+Tracer::~Tracer() {
+	is_exit_ = true;
+	if (export_thread_.joinable()) {
+		export_thread_.join();
+	}
+}
+
+void Tracer::destroy() {
+	if (instance_) {
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+TraceContext &Tracer::current() {
+	thread_local TraceContext context;
+	return context;
+}
+
+uint64_t Tracer::nowUs() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 线程私有的 xorshift64*，不加锁、不做系统调用
+ */
+uint64_t Tracer::randomId() {
+	thread_local uint64_t state = [] {
+	  std::random_device rd;
+	  uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+	  return seed == 0 ? 0x9E3779B97F4A7C15ull : seed;
+	}();
+	uint64_t id;
+	do {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		id = state * 0x2545F4914F6CDD1Dull;
+	} while (id == 0);
+	return id;
+}
+
+TraceContext Tracer::newRoot() {
+	TraceContext context;
+	context.trace_id = randomId();
+	context.span_id = randomId();
+	bool sampled = sample_threshold_ == UINT64_MAX || context.trace_id < sample_threshold_;
+	context.flags = sampled ? kTraceFlagSampled : 0;
+	return context;
+}
+
+TraceContext Tracer::newChild(const TraceContext &parent) {
+	TraceContext context = parent;
+	context.span_id = randomId();
+	return context;
+}
+
+void Tracer::submit(const SpanRecord &span) {
+	if (!ring_.push(span)) {
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Tracer::exportLoop() {
+	SpanRecord span;
+	for (;;) {
+		bool exiting = is_exit_.load();
+		bool wrote = false;
+		while (ring_.pop(span)) {
+			writeSpan(span);
+			wrote = true;
+		}
+		if (wrote) {
+			file_.flush();
+		}
+		if (exiting) {
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+}
+
+/**
+ * @brief 每个 span 一行 JSON
+ */
+void Tracer::writeSpan(const SpanRecord &span) {
+	char line[256];
+	snprintf(line, sizeof(line),
+			 R"({"trace_id":"%016)" PRIx64 R"(","span_id":"%016)" PRIx64 R"(","parent_id":"%016)" PRIx64
+			 R"(","name":"%s","kind":"%s","start_us":%)" PRIu64 R"(,"duration_us":%.3f,"status":%d})",
+			 span.trace_id, span.span_id, span.parent_span_id, span.name,
+			 span.kind == SpanKind::CLIENT ? "client" : "server",
+			 span.start_us, static_cast<double>(span.duration_ns) / 1000.0, span.status);
+	file_ << line << "\n";
+}
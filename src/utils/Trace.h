@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file           : Trace.h
+  * @author         : xy
+  * @brief          : 分布式追踪：追踪上下文随 RpcHeader 传递，span 经无锁环形缓冲区异步导出到文件
+  * @attention      : 未采样的请求只生成 ID、不读时钟、不写缓冲区；缓冲区满时丢弃并计数
+  * @date           : 2025/3/28
+  ******************************************************************************
+  */
+
+#ifndef TINYRPC_SRC_UTILS_TRACE_H_
+#define TINYRPC_SRC_UTILS_TRACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+
+constexpr uint32_t kTraceFlagSampled = 1;
+
+struct TraceContext {
+  uint64_t trace_id = 0;
+  uint64_t span_id = 0;
+  uint32_t flags = 0;
+
+  bool valid() const { return trace_id != 0; }
+  bool sampled() const { return (flags & kTraceFlagSampled) != 0; }
+};
+
+enum class SpanKind : uint8_t {
+  CLIENT,
+  SERVER
+};
+
+struct SpanRecord {
+  uint64_t trace_id = 0;
+  uint64_t span_id = 0;
+  uint64_t parent_span_id = 0;
+  uint64_t start_us = 0;        // 墙上时间，微秒
+  uint64_t duration_ns = 0;
+  int32_t status = 0;           // RpcErrorCode
+  SpanKind kind = SpanKind::CLIENT;
+  char name[64] = {0};
+
+  void setName(const std::string &value);
+};
+
+// 多生产者单消费者的有界环形队列（Vyukov），生产者只做一次 CAS
+class SpanRing {
+ public:
+  explicit SpanRing(size_t capacity);    // capacity 需为 2 的幂
+  bool push(const SpanRecord &span);
+  bool pop(SpanRecord &span);
+ private:
+  struct Cell {
+	std::atomic<size_t> sequence;
+	SpanRecord span;
+  };
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  alignas(64) std::atomic<size_t> enqueue_pos_ = 0;
+  alignas(64) size_t dequeue_pos_ = 0;
+};
+
+class Tracer {
+ public:
+  static Tracer *getInstance();
+  Tracer(const std::string &path, double sample_rate, size_t capacity = 8192);
+  ~Tracer();
+
+  // 新的根上下文，按采样率决定是否采样
+  TraceContext newRoot();
+  // 子 span 继承 trace_id 与采样标记
+  static TraceContext newChild(const TraceContext &parent);
+  void submit(const SpanRecord &span);
+  uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+  // 当前线程正在处理的请求的上下文，服务端分发时设置，客户端发起调用时读取
+  static TraceContext &current();
+  static uint64_t nowUs();
+ private:
+  static uint64_t randomId();
+  void exportLoop();
+  void writeSpan(const SpanRecord &span);
+  static void destroy();
+ private:
+  static Tracer *instance_;
+  SpanRing ring_;
+  uint64_t sample_threshold_;    // randomId() 小于该值即采样
+  std::atomic<uint64_t> dropped_ = 0;
+  std::ofstream file_;
+  std::atomic<bool> is_exit_ = false;
+  std::thread export_thread_;
+ public:
+  FRIEND_TEST(TraceTest, SampleRate);
+};
+
+// 在作用域内把上下文设置为当前线程的上下文，退出时恢复
+class TraceScope {
+ public:
+  explicit TraceScope(const TraceContext &context) : saved_(Tracer::current()) { Tracer::current() = context; }
+  ~TraceScope() { Tracer::current() = saved_; }
+ private:
+  TraceContext saved_;
+};
+
+#endif //TINYRPC_SRC_UTILS_TRACE_H_
@@ -18,7 +18,9 @@ void global_watcher(zhandle_t *zh, int type, int state, const char *path, void *
 		if (state == ZOO_CONNECTED_STATE) {
 
 			sem_t *sem = (sem_t *)zoo_get_context(zh);
-			sem_post(sem);
+			if (sem != nullptr) {    // 断线重连时也会收到该事件，此时 start() 已返回
+				sem_post(sem);
+			}
 		}
 	}
 }
@@ -40,6 +42,8 @@ void Zookeeper::start() {
 	sem_init(&sem, 0, 0);
 	zoo_set_context(m_handle, &sem);
 	sem_wait(&sem);
+	zoo_set_context(m_handle, nullptr);
+	sem_destroy(&sem);
 }
 
 void Zookeeper::create(const std::string &path, const std::string &data, int state) {
@@ -75,6 +79,53 @@ bool Zookeeper::exists(const std::string &path) {
 	}
 }
 
+std::vector<std::string> Zookeeper::getChildren(const std::string &path) {
+	std::vector<std::string> children;
+	struct String_vector strings;
+	int ret = zoo_get_children(m_handle, path.c_str(), 0, &strings);
+	if (ret != ZOK) {
+		std::cerr << "Failed to get children of path: " << path
+				  << ", error: " << zerror(ret) << std::endl;
+		return children;
+	}
+	for (int i = 0; i < strings.count; i++) {
+		children.emplace_back(strings.data[i]);
+	}
+	deallocate_String_vector(&strings);
+	return children;
+}
+
+bool Zookeeper::remove(const std::string &path) {
+	int flag = zoo_delete(m_handle, path.c_str(), -1);
+	return flag == ZOK || flag == ZNONODE;
+}
+
+static void data_watcher(zhandle_t *zh, int type, int state, const char *path, void *watcherCtx) {
+	if (type == ZOO_SESSION_EVENT) {
+		return;    // 会话事件不会消耗 watch
+	}
+	auto on_change = static_cast<std::function<void()> *>(watcherCtx);
+	(*on_change)();
+	delete on_change;
+}
+
+std::string Zookeeper::getData(const std::string &path, std::function<void()> on_change) {
+	char buffer[512]; // 存储数据
+	int buffer_len = sizeof(buffer);
+	struct Stat stat;
+
+	auto ctx = new std::function<void()>(std::move(on_change));
+	int ret = zoo_wget(m_handle, path.c_str(), data_watcher, ctx, buffer, &buffer_len, &stat);
+	if (ret != ZOK) {
+		delete ctx;
+		std::cerr << "Failed to get data from path: " << path
+				  << ", error: " << zerror(ret) << std::endl;
+		return "";
+	}
+
+	return std::string(buffer, buffer_len);
+}
+
 std::string Zookeeper::getData(const std::string &path) {
 	char buffer[512]; // 存储数据
 	int buffer_len = sizeof(buffer);
@@ -12,6 +12,8 @@
 #define TINYRPC_SRC_UTILS_ZOOKEEPER_H_
 
 #include <string>
+#include <functional>
+#include <vector>
 #include <zookeeper/zookeeper.h>
 
 class Zookeeper {
@@ -21,9 +23,15 @@ class Zookeeper {
   void start();
   void create(const std::string& path, const std::string& data, int state);
   std::string getData(const std::string& path);
+  // 读取数据并注册一次性 watch，节点变更或删除时回调 on_change（在 zk 事件线程中执行）
+  std::string getData(const std::string& path, std::function<void()> on_change);
   bool exists(const std::string& path);
+  // 子节点名（不含父路径），失败时返回空
+  std::vector<std::string> getChildren(const std::string& path);
+  // 删除节点（任意版本），节点不存在时也返回 true
+  bool remove(const std::string& path);
  private:
-  zhandle_t *m_handle;
+  zhandle_t *m_handle = nullptr;
 };
 
 #endif //TINYRPC_SRC_UTILS_ZOOKEEPER_H_
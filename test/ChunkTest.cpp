@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include "utils/Chunk.h"
+#include "utils/HvProtocol.h"
+
+static std::string makeFrame(size_t body_size, char fill) {
+	FrameHead head;
+	head.type = FRAME_RESPONSE;
+	return HvProtocol::packFrame(head, std::string(body_size, fill));
+}
+
+// 拆开分片帧的帧头，返回帧体
+static std::string chunkBody(const std::string &chunk) {
+	FrameHead head;
+	std::string body;
+	EXPECT_TRUE(HvProtocol::unpackFrame(chunk.data(), chunk.size(), head, body));
+	EXPECT_EQ(head.type, FRAME_CHUNK);
+	return body;
+}
+
+TEST(ChunkTest, SplitAndReassemble) {
+	auto frame = makeFrame(10000, 'a');
+	ChunkWriter writer(1024);
+	writer.add(frame);
+	ChunkAssembler assembler(1 << 20, 1 << 20);
+	std::string chunk, output;
+	int count = 0;
+	ChunkAssembler::Result result = ChunkAssembler::CHUNK_PARTIAL;
+	while (writer.next(chunk)) {
+		EXPECT_LE(chunk.size(), FRAME_HEAD_LENGTH + CHUNK_HEAD_LENGTH + 1024 + FRAME_CHECKSUM_LENGTH);
+		result = assembler.feed(chunkBody(chunk), output);
+		count++;
+	}
+	EXPECT_EQ(count, static_cast<int>((frame.size() + 1023) / 1024));
+	ASSERT_EQ(result, ChunkAssembler::CHUNK_COMPLETE);
+	EXPECT_EQ(output, frame);
+	EXPECT_EQ(assembler.pendingBytes(), 0u);
+	EXPECT_TRUE(writer.empty());
+}
+
+TEST(ChunkTest, MessagesInterleave) {
+	ChunkWriter writer(100);
+	auto first = makeFrame(1000, 'x');
+	auto second = makeFrame(250, 'y');
+	writer.add(first);
+	writer.add(second);
+
+	// 两个消息轮流出片，小消息不必等大消息发完
+	ChunkAssembler assembler(1 << 20, 1 << 20);
+	std::string chunk, output;
+	std::vector<std::string> completed;
+	int index = 0;
+	int second_done_at = -1;
+	while (writer.next(chunk)) {
+		if (assembler.feed(chunkBody(chunk), output) == ChunkAssembler::CHUNK_COMPLETE) {
+			if (output == second) {
+				second_done_at = index;
+			}
+			completed.push_back(output);
+		}
+		index++;
+	}
+	ASSERT_EQ(completed.size(), 2u);
+	EXPECT_EQ(completed[0], second);
+	EXPECT_EQ(completed[1], first);
+	EXPECT_LT(second_done_at, 6);
+}
+
+TEST(ChunkTest, RejectsBadChunks) {
+	ChunkWriter writer(100);
+	writer.add(makeFrame(1000, 'z'));
+	std::string first, second, output;
+	ASSERT_TRUE(writer.next(first));
+	ASSERT_TRUE(writer.next(second));
+
+	// 首个分片缺失
+	ChunkAssembler out_of_order(1 << 20, 1 << 20);
+	EXPECT_EQ(out_of_order.feed(chunkBody(second), output), ChunkAssembler::CHUNK_ERROR);
+
+	// 重复的分片
+	ChunkAssembler duplicate(1 << 20, 1 << 20);
+	EXPECT_EQ(duplicate.feed(chunkBody(first), output), ChunkAssembler::CHUNK_PARTIAL);
+	EXPECT_EQ(duplicate.feed(chunkBody(first), output), ChunkAssembler::CHUNK_ERROR);
+
+	// 超过单个消息与未完成消息总量的上限
+	ChunkAssembler too_large(512, 1 << 20);
+	EXPECT_EQ(too_large.feed(chunkBody(first), output), ChunkAssembler::CHUNK_ERROR);
+	ChunkAssembler over_budget(1 << 20, 512);
+	EXPECT_EQ(over_budget.feed(chunkBody(first), output), ChunkAssembler::CHUNK_ERROR);
+
+	EXPECT_EQ(duplicate.feed("short", output), ChunkAssembler::CHUNK_ERROR);
+}
+
+TEST(ChunkTest, SplitsFrameParts) {
+	// 分片跨越 prefix、附件与校验尾的边界，重组结果与拼接后的帧一致
+	FrameHead head;
+	head.flags = FRAME_FLAG_CRC32C;
+	FrameParts parts;
+	parts.prefix.assign(FRAME_HEAD_LENGTH, '\0');
+	parts.prefix.append(150, 'p');
+	parts.attachment.assign(1000, 'a');
+	HvProtocol::finishFrame(head, parts);
+	auto joined = parts.join();
+
+	ChunkWriter writer(97);
+	writer.add(std::move(parts));
+	ChunkAssembler assembler(1 << 20, 1 << 20);
+	std::string chunk, output;
+	ChunkAssembler::Result result = ChunkAssembler::CHUNK_PARTIAL;
+	while (writer.next(chunk)) {
+		result = assembler.feed(chunkBody(chunk), output);
+	}
+	ASSERT_EQ(result, ChunkAssembler::CHUNK_COMPLETE);
+	EXPECT_EQ(output, joined);
+}
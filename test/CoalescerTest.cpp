@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "rpc/RequestCoalescer.h"
+#include "rpc/RpcErrorCode.h"
+#include "proto/tinyrpc_options.pb.h"
+#include "user.pb.h"
+
+TEST(CoalescerTest, FollowersReceiveLeaderResult) {
+	RequestCoalescer coalescer;
+	auto key = RequestCoalescer::makeKey("UserServiceRpc", "GetProfile", "xy");
+	std::vector<std::string> bodies;
+	auto waiter = [&bodies](const CoalescedResult &result) { bodies.push_back(result.body); };
+	EXPECT_TRUE(coalescer.Join(key, waiter));
+	EXPECT_FALSE(coalescer.Join(key, waiter));
+	EXPECT_FALSE(coalescer.Join(key, waiter));
+	EXPECT_EQ(coalescer.FlightNum(), 1u);
+
+	CoalescedResult result;
+	result.body = "profile";
+	EXPECT_EQ(coalescer.Finish(key, result), 2u);
+	EXPECT_EQ(bodies, std::vector<std::string>({"profile", "profile"}));
+
+	// 完成后到达的相同请求重新执行
+	EXPECT_EQ(coalescer.FlightNum(), 0u);
+	EXPECT_TRUE(coalescer.Join(key, waiter));
+	EXPECT_EQ(coalescer.Finish(key, result), 0u);
+}
+
+TEST(CoalescerTest, KeyCoversServiceMethodAndArgs) {
+	EXPECT_NE(RequestCoalescer::makeKey("s", "m", "a"), RequestCoalescer::makeKey("s", "m", "b"));
+	EXPECT_NE(RequestCoalescer::makeKey("s", "ma", ""), RequestCoalescer::makeKey("s", "m", "a"));
+	EXPECT_NE(RequestCoalescer::makeKey("ab", "c", ""), RequestCoalescer::makeKey("a", "bc", ""));
+
+	RequestCoalescer coalescer;
+	auto noop = [](const CoalescedResult &) {};
+	EXPECT_TRUE(coalescer.Join(RequestCoalescer::makeKey("s", "m", "a"), noop));
+	EXPECT_TRUE(coalescer.Join(RequestCoalescer::makeKey("s", "m", "b"), noop));
+	EXPECT_EQ(coalescer.FlightNum(), 2u);
+}
+
+TEST(CoalescerTest, ErrorsReachFollowers) {
+	RequestCoalescer coalescer;
+	auto key = RequestCoalescer::makeKey("s", "m", "bad");
+	int error_code = 0;
+	ASSERT_TRUE(coalescer.Join(key, [](const CoalescedResult &) {}));
+	ASSERT_FALSE(coalescer.Join(key, [&error_code](const CoalescedResult &result) { error_code = result.error_code; }));
+	coalescer.Finish(key, CoalescedResult{3, "request parse error", {}, {}});
+	EXPECT_EQ(error_code, 3);
+}
+
+TEST(CoalescerTest, FailedLeaderFailsFollowers) {
+	test::ProfileResponse response;
+	response.set_name("xy");    // 业务方法失败前只填了一部分
+	RpcController controller;
+	controller.SetAttachment("avatar");
+	controller.SetFailed("profile not found");
+
+	auto result = RequestCoalescer::makeResult(controller, response);
+	EXPECT_EQ(result.error_code, RPC_ERR_FAILED);
+	EXPECT_EQ(result.error_text, "profile not found");
+	EXPECT_TRUE(result.body.empty());
+	EXPECT_TRUE(result.attachment.empty());
+
+	RequestCoalescer coalescer;
+	auto key = RequestCoalescer::makeKey("UserServiceRpc", "GetProfile", "xy");
+	std::vector<CoalescedResult> received;
+	auto waiter = [&received](const CoalescedResult &result) { received.push_back(result); };
+	ASSERT_TRUE(coalescer.Join(key, waiter));
+	ASSERT_FALSE(coalescer.Join(key, waiter));
+	ASSERT_FALSE(coalescer.Join(key, waiter));
+	EXPECT_EQ(coalescer.Finish(key, result), 2u);
+	for (const auto &follower : received) {
+		EXPECT_EQ(follower.error_code, RPC_ERR_FAILED);
+		EXPECT_EQ(follower.error_text, "profile not found");
+		EXPECT_TRUE(follower.body.empty());
+	}
+}
+
+TEST(CoalescerTest, SucceededLeaderResult) {
+	test::ProfileResponse response;
+	response.set_name("xy");
+	response.set_signature("hello");
+	RpcController controller;
+	controller.SetAttachment("avatar");
+
+	auto result = RequestCoalescer::makeResult(controller, response);
+	EXPECT_EQ(result.error_code, RPC_OK);
+	EXPECT_EQ(result.attachment, "avatar");
+	test::ProfileResponse parsed;
+	ASSERT_TRUE(parsed.ParseFromString(result.body));
+	EXPECT_EQ(parsed.signature(), "hello");
+}
+
+TEST(CoalescerTest, ConcurrentJoin) {
+	RequestCoalescer coalescer;
+	auto key = RequestCoalescer::makeKey("s", "m", "hot");
+	std::atomic<int> leaders{0};
+	std::atomic<int> delivered{0};
+	constexpr int kThreads = 8;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < kThreads; i++) {
+		threads.emplace_back([&]() {
+		  if (coalescer.Join(key, [&delivered](const CoalescedResult &) { delivered++; })) {
+			  leaders++;
+		  }
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(leaders.load(), 1);
+	EXPECT_EQ(coalescer.Finish(key, CoalescedResult{}), static_cast<size_t>(kThreads - 1));
+	EXPECT_EQ(delivered.load(), kThreads - 1);
+}
+
+TEST(CoalescerTest, MethodOption) {
+	auto service = test::LoginRequest::descriptor()->file()->FindServiceByName("UserServiceRpc");
+	ASSERT_NE(service, nullptr);
+	EXPECT_TRUE(service->FindMethodByName("GetProfile")->options().GetExtension(tinyrpc::coalesce));
+	EXPECT_FALSE(service->FindMethodByName("Login")->options().GetExtension(tinyrpc::coalesce));
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "utils/Compress.h"
+#include "utils/HvProtocol.h"
+#include "utils/Lz4.h"
+
+static std::string repetitiveData(size_t size) {
+	std::string data;
+	while (data.size() < size) {
+		data += "user_id:" + std::to_string(data.size() % 977) + ",name:tinyrpc,";
+	}
+	data.resize(size);
+	return data;
+}
+
+static std::string randomData(size_t size) {
+	std::mt19937 gen(42);
+	std::string data(size, '\0');
+	for (auto &c : data) {
+		c = static_cast<char>(gen());
+	}
+	return data;
+}
+
+TEST(CompressTest, RoundTrip) {
+	for (size_t size : {0, 1, 15, 64, 4096, 100000}) {
+		for (const auto &input : {repetitiveData(size), randomData(size)}) {
+			std::string compressed, output;
+			ASSERT_TRUE(Compress::compress(COMPRESS_LZ4, input, compressed));
+			ASSERT_TRUE(Compress::decompress(COMPRESS_LZ4, compressed, output));
+			EXPECT_EQ(output, input);
+		}
+	}
+}
+
+TEST(CompressTest, RepetitiveDataShrinks) {
+	auto input = repetitiveData(100000);
+	std::string compressed;
+	ASSERT_TRUE(Compress::compress(COMPRESS_LZ4, input, compressed));
+	EXPECT_LT(compressed.size(), input.size() / 4);
+}
+
+TEST(CompressTest, CorruptInputRejected) {
+	auto input = repetitiveData(10000);
+	std::string compressed, output;
+	ASSERT_TRUE(Compress::compress(COMPRESS_LZ4, input, compressed));
+
+	// 截断
+	EXPECT_FALSE(Compress::decompress(COMPRESS_LZ4, compressed.substr(0, compressed.size() / 2), output));
+	// 原始长度不符
+	auto wrong_len = compressed;
+	wrong_len[3] = static_cast<char>(wrong_len[3] + 1);
+	EXPECT_FALSE(Compress::decompress(COMPRESS_LZ4, wrong_len, output));
+	// 随机数据不能越界
+	auto garbage = compressed.substr(0, 4) + randomData(compressed.size());
+	Compress::decompress(COMPRESS_LZ4, garbage, output);
+	// 未知编码
+	EXPECT_FALSE(Compress::decompress(COMPRESS_NONE, compressed, output));
+}
+
+TEST(CompressTest, Negotiation) {
+	EXPECT_EQ(Compress::parse("lz4"), COMPRESS_LZ4);
+	EXPECT_EQ(Compress::parse("none"), COMPRESS_NONE);
+	EXPECT_TRUE(Compress::accepted(kSupportedCompress, COMPRESS_LZ4));
+	EXPECT_FALSE(Compress::accepted(0, COMPRESS_LZ4));
+	EXPECT_FALSE(Compress::accepted(kSupportedCompress, COMPRESS_NONE));
+}
+
+TEST(CompressTest, FrameRoundTrip) {
+	FrameHead head;
+	head.type = FRAME_RESPONSE;
+	head.compress = COMPRESS_LZ4;
+	head.accept = kSupportedCompress;
+	auto frame = HvProtocol::packFrame(head, "payload");
+	ASSERT_EQ(frame.size(), FRAME_HEAD_LENGTH + 7);
+
+	FrameHead parsed;
+	std::string body;
+	ASSERT_TRUE(HvProtocol::unpackFrame(frame.data(), frame.size(), parsed, body));
+	EXPECT_EQ(parsed.length, 7u);
+	EXPECT_EQ(parsed.type, FRAME_RESPONSE);
+	EXPECT_EQ(parsed.compress, COMPRESS_LZ4);
+	EXPECT_EQ(parsed.accept, kSupportedCompress);
+	EXPECT_EQ(body, "payload");
+
+	EXPECT_FALSE(HvProtocol::unpackFrame(frame.data(), frame.size() - 1, parsed, body));
+}
+
+TEST(CompressTest, FinishFrameInPlace) {
+	// 复用同一个缓冲区封包，结果与 packFrame 一致
+	std::string frame;
+	for (uint8_t flags : {0, static_cast<int>(FRAME_FLAG_CRC32C), 0}) {
+		FrameHead head;
+		head.type = FRAME_RESPONSE;
+		head.flags = flags;
+		frame.assign(FRAME_HEAD_LENGTH, '\0');
+		frame.append("payload");
+		HvProtocol::finishFrame(head, frame);
+		EXPECT_EQ(frame, HvProtocol::packFrame(head, "payload"));
+
+		FrameHead parsed;
+		std::string body;
+		ASSERT_TRUE(HvProtocol::unpackFrame(frame.data(), frame.size(), parsed, body));
+		EXPECT_EQ(body, "payload");
+	}
+}
+
+TEST(CompressTest, FramePartsMatchJoined) {
+	// 分段封包的各段依次拼接后与整体封包一致，校验尾覆盖附件
+	auto attachment = repetitiveData(50000);
+	for (uint8_t flags : {0, static_cast<int>(FRAME_FLAG_CRC32C)}) {
+		FrameHead head;
+		head.flags = flags;
+		FrameParts parts;
+		parts.prefix.assign(FRAME_HEAD_LENGTH, '\0');
+		parts.prefix.append("header");
+		parts.attachment = attachment;
+		HvProtocol::finishFrame(head, parts);
+		EXPECT_EQ(parts.join(), HvProtocol::packFrame(head, "header" + attachment));
+		EXPECT_EQ(parts.suffix.size(), flags ? FRAME_CHECKSUM_LENGTH : 0u);
+	}
+}
+
+TEST(CompressTest, UnpackMessageView) {
+	// 视图版本与拷贝版本结果一致，且指向帧体内部
+	auto body = HvProtocol::packMessageAsString("header") + repetitiveData(1000);
+	std::string copied;
+	std::string_view view;
+	EXPECT_EQ(HvProtocol::unpackMessage(body, copied), 6u);
+	EXPECT_EQ(HvProtocol::unpackMessage(std::string_view(body), view), 6u);
+	EXPECT_EQ(view, copied);
+	EXPECT_EQ(view.data(), body.data() + SERVER_HEAD_LENGTH);
+}
+
+TEST(CompressTest, SplitBatch) {
+	FrameHead head;
+	std::string body = HvProtocol::packFrame(head, "first") + HvProtocol::packFrame(head, "") + HvProtocol::packFrame(head, "third");
+	head.type = FRAME_BATCH;
+	auto batch = HvProtocol::packFrame(head, body);
+
+	FrameHead parsed;
+	std::string batch_body;
+	ASSERT_TRUE(HvProtocol::unpackFrame(batch.data(), batch.size(), parsed, batch_body));
+	EXPECT_EQ(parsed.type, FRAME_BATCH);
+	std::vector<std::pair<const char *, size_t>> frames;
+	ASSERT_TRUE(HvProtocol::splitBatch(batch_body.data(), batch_body.size(), frames));
+	ASSERT_EQ(frames.size(), 3u);
+	std::string inner;
+	ASSERT_TRUE(HvProtocol::unpackFrame(frames[2].first, frames[2].second, parsed, inner));
+	EXPECT_EQ(inner, "third");
+	EXPECT_EQ(frames[1].second, FRAME_HEAD_LENGTH);
+
+	// 截断的内层帧
+	frames.clear();
+	EXPECT_FALSE(HvProtocol::splitBatch(batch_body.data(), batch_body.size() - 1, frames));
+	frames.clear();
+	EXPECT_FALSE(HvProtocol::splitBatch(batch_body.data(), 3, frames));
+}
@@ -1,5 +1,12 @@
 #include "utils/Config.h"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
 
 TEST(ConfigTest,ConfigBase){
 	auto ip = Config::getInstance()->get("rpc_ip");
@@ -11,3 +18,105 @@ TEST(ConfigTest,ConfigBase){
 	auto password = Config::getInstance()->get("password");
 	EXPECT_EQ(password, "123456");
 }
+
+static void writeFile(const std::string &path, const std::string &content) {
+	std::ofstream ofs(path, std::ios::trunc);
+	ofs << content;
+}
+
+TEST(ConfigTest, ReloadSwapsSnapshot) {
+	const std::string path = "/tmp/tinyrpc_config_reload.ini";
+	writeFile(path, "a=1\nb=x\n");
+	Config config(path);
+	auto old_snapshot = config.snapshot();
+	EXPECT_EQ(config.get("a"), "1");
+
+	writeFile(path, "a=2\nc=y\n");
+	ASSERT_TRUE(config.reload());
+	EXPECT_EQ(config.version(), 1u);
+	EXPECT_EQ(config.get("a"), "2");
+	EXPECT_EQ(config.get("b"), std::nullopt);
+	EXPECT_EQ(config.get("c"), "y");
+	// 读取方持有的旧快照不受影响
+	EXPECT_EQ(old_snapshot->at("a"), "1");
+
+	std::remove(path.c_str());
+	EXPECT_FALSE(config.reload());
+	EXPECT_EQ(config.get("a"), "2");
+}
+
+TEST(ConfigTest, TypedBindings) {
+	const std::string path = "/tmp/tinyrpc_config_typed.ini";
+	writeFile(path, "timeout=300\nrate=0.5\nflag=1\nbad=12abc\n");
+	Config config(path);
+	const auto &timeout = config.bindInt("timeout", 3000);
+	const auto &rate = config.bindDouble("rate", 0.01);
+	const auto &flag = config.bindBool("flag", false);
+	const auto &bad = config.bindInt("bad", 7);
+	const auto &missing = config.bindInt("missing", 42);
+	EXPECT_EQ(timeout.get(), 300);
+	EXPECT_DOUBLE_EQ(rate.get(), 0.5);
+	EXPECT_TRUE(flag.get());
+	EXPECT_EQ(bad.get(), 7);
+	EXPECT_EQ(missing.get(), 42);
+
+	int calls = 0;
+	std::optional<std::string> seen;
+	auto id = config.watch("timeout", [&](const std::optional<std::string> &value) {
+	  calls++;
+	  seen = value;
+	});
+	EXPECT_EQ(calls, 1);
+
+	writeFile(path, "timeout=100\nrate=0.5\nmissing=5\n");
+	ASSERT_TRUE(config.reload());
+	EXPECT_EQ(timeout.get(), 100);
+	EXPECT_FALSE(flag.get());
+	EXPECT_EQ(missing.get(), 5);
+	EXPECT_EQ(calls, 2);
+	EXPECT_EQ(seen, "100");
+
+	// 值未变化时不通知，取消后不再通知
+	ASSERT_TRUE(config.reload());
+	EXPECT_EQ(calls, 2);
+	config.unwatch(id);
+	writeFile(path, "timeout=1\n");
+	ASSERT_TRUE(config.reload());
+	EXPECT_EQ(calls, 2);
+	EXPECT_EQ(timeout.get(), 1);
+	std::remove(path.c_str());
+}
+
+TEST(ConfigTest, WatcherReloadsOnFileChange) {
+	const std::string dir = "/tmp/tinyrpc_config_watch";
+	const std::string path = dir + "/config.ini";
+	mkdir(dir.c_str(), 0755);
+	writeFile(path, "limit=1\n");
+	Config config(path);
+	const auto &limit = config.bindInt("limit", 0);
+	config.startWatcher();
+
+	auto waitFor = [&](int64_t expected) {
+	  for (int i = 0; i < 200 && limit.get() != expected; i++) {
+		  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	  }
+	  return limit.get() == expected;
+	};
+	writeFile(path, "limit=2\n");
+	EXPECT_TRUE(waitFor(2));
+
+	// 写临时文件再改名
+	writeFile(dir + "/config.ini.tmp", "limit=3\n");
+	std::rename((dir + "/config.ini.tmp").c_str(), path.c_str());
+	EXPECT_TRUE(waitFor(3));
+
+	// SIGHUP 时无论文件是否变化都重新加载
+	auto version = config.version();
+	raise(SIGHUP);
+	for (int i = 0; i < 200 && config.version() == version; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	EXPECT_GT(config.version(), version);
+	std::remove(path.c_str());
+	rmdir(dir.c_str());
+}
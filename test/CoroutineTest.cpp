@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "proto/rpc_header.pb.h"
+#include "rpc/RpcCoroutine.h"
+
+using tinyrpc::RpcResponseHeader;
+
+// 与 protoc 生成的 Stub 方法签名一致：请求的 call_id 原样回填到响应，
+// done 在另一个线程中执行（模拟客户端 IO 线程），sync 为 true 时在调用中同步执行（模拟提前出错）
+struct FakeStub {
+  bool sync = false;
+  int last_timeout = -1;
+  std::vector<std::thread> threads;
+
+  ~FakeStub() {
+	  for (auto &thread : threads) {
+		  thread.join();
+	  }
+  }
+
+  void Echo(google::protobuf::RpcController *controller, const RpcResponseHeader *request,
+			RpcResponseHeader *response, google::protobuf::Closure *done) {
+	  last_timeout = static_cast<RpcController *>(controller)->Timeout();
+	  if (sync) {
+		  controller->SetFailed("resolve failed");
+		  done->Run();
+		  return;
+	  }
+	  auto call_id = request->call_id();
+	  threads.emplace_back([response, call_id, done]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		response->set_call_id(call_id);
+		done->Run();
+	  });
+  }
+};
+
+static Task<uint64_t> echo(FakeStub &stub, uint64_t id, int timeout_ms = 0) {
+	RpcResponseHeader request;
+	request.set_call_id(id);
+	auto result = co_await asyncCall(stub, &FakeStub::Echo, request, timeout_ms);
+	if (!result.ok()) {
+		throw std::runtime_error(result.error());
+	}
+	co_return result.response.call_id();
+}
+
+TEST(CoroutineTest, AwaitCall) {
+	FakeStub stub;
+	auto chain = [](FakeStub &stub) -> Task<uint64_t> {
+	  auto first = co_await echo(stub, 1);
+	  auto second = co_await echo(stub, first + 1);
+	  co_return first + second;
+	};
+	EXPECT_EQ(syncWait(chain(stub)), 3u);
+}
+
+TEST(CoroutineTest, PerCallTimeout) {
+	FakeStub stub;
+	EXPECT_EQ(syncWait(echo(stub, 7, 150)), 7u);
+	EXPECT_EQ(stub.last_timeout, 150);
+	EXPECT_EQ(syncWait(echo(stub, 8)), 8u);
+	EXPECT_EQ(stub.last_timeout, 0);
+}
+
+TEST(CoroutineTest, SynchronousDone) {
+	FakeStub stub;
+	stub.sync = true;
+	EXPECT_THROW(syncWait(echo(stub, 1)), std::runtime_error);
+}
+
+TEST(CoroutineTest, WhenAll) {
+	FakeStub stub;
+	auto fan_out = [](FakeStub &stub) -> Task<uint64_t> {
+	  std::vector<Task<uint64_t>> calls;
+	  for (uint64_t i = 1; i <= 8; i++) {
+		  calls.push_back(echo(stub, i));
+	  }
+	  auto results = co_await whenAll(std::move(calls));
+	  uint64_t sum = 0;
+	  for (size_t i = 0; i < results.size(); i++) {
+		  EXPECT_EQ(results[i], i + 1);
+		  sum += results[i];
+	  }
+	  auto [a, b] = co_await whenAll(echo(stub, 100), echo(stub, 200));
+	  co_return sum + a + b;
+	};
+	EXPECT_EQ(syncWait(fan_out(stub)), 336u);
+}
+
+TEST(CoroutineTest, WhenAllPropagatesError) {
+	FakeStub ok_stub;
+	FakeStub failing_stub;
+	failing_stub.sync = true;
+	auto fan_out = [](FakeStub &ok_stub, FakeStub &failing_stub) -> Task<void> {
+	  co_await whenAll(echo(ok_stub, 1), echo(failing_stub, 2));
+	};
+	EXPECT_THROW(syncWait(fan_out(ok_stub, failing_stub)), std::runtime_error);
+}
+
+TEST(CoroutineTest, ServeAsync) {
+	FakeStub stub;
+	RpcController controller;
+	RpcResponseHeader response;
+	std::promise<void> finished;
+	// 服务端方法：挂起等待下游调用，协程结束后 done 发送响应
+	auto handler = [](FakeStub &stub, RpcResponseHeader &response) -> Task<void> {
+	  response.set_call_id(co_await echo(stub, 42));
+	};
+	serveAsync(&controller, google::protobuf::NewCallback(&finished, &std::promise<void>::set_value),
+			   handler(stub, response));
+	finished.get_future().get();
+	EXPECT_FALSE(controller.Failed());
+	EXPECT_EQ(response.call_id(), 42u);
+
+	stub.sync = true;
+	std::promise<void> failed;
+	serveAsync(&controller, google::protobuf::NewCallback(&failed, &std::promise<void>::set_value),
+			   handler(stub, response));
+	failed.get_future().get();
+	EXPECT_TRUE(controller.Failed());
+	EXPECT_EQ(controller.ErrorText(), "resolve failed");
+}
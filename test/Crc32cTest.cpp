@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "utils/Crc32c.h"
+#include "utils/HvProtocol.h"
+
+TEST(Crc32cTest, KnownValues) {
+	// RFC 3720 B.4 中的测试向量
+	std::string zeros(32, '\0');
+	std::string ones(32, '\xff');
+	std::string ascending;
+	for (int i = 0; i < 32; i++) {
+		ascending.push_back(static_cast<char>(i));
+	}
+	EXPECT_EQ(Crc32c::value("123456789", 9), 0xE3069283u);
+	EXPECT_EQ(Crc32c::value(zeros.data(), zeros.size()), 0x8A9136AAu);
+	EXPECT_EQ(Crc32c::value(ones.data(), ones.size()), 0x62A8AB43u);
+	EXPECT_EQ(Crc32c::value(ascending.data(), ascending.size()), 0x46DD794Eu);
+	EXPECT_EQ(Crc32c::value("", 0), 0u);
+}
+
+TEST(Crc32cTest, HardwareMatchesTable) {
+	std::mt19937 gen(7);
+	std::string data(4096 + 16, '\0');
+	for (auto &c : data) {
+		c = static_cast<char>(gen());
+	}
+	// 覆盖不同的长度与起始对齐
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t size : {0, 1, 3, 7, 8, 9, 63, 64, 1000, 4096}) {
+			EXPECT_EQ(Crc32c::value(data.data() + offset, size),
+					  Crc32c::extendPortable(0, data.data() + offset, size));
+		}
+	}
+}
+
+TEST(Crc32cTest, Extend) {
+	std::string data = "hello tinyrpc, hello crc32c";
+	auto whole = Crc32c::value(data.data(), data.size());
+	auto part = Crc32c::value(data.data(), 10);
+	EXPECT_EQ(Crc32c::extend(part, data.data() + 10, data.size() - 10), whole);
+}
+
+TEST(Crc32cTest, FrameChecksum) {
+	FrameHead head;
+	head.flags = FRAME_FLAG_CRC32C;
+	auto frame = HvProtocol::packFrame(head, "payload");
+	ASSERT_EQ(frame.size(), FRAME_HEAD_LENGTH + 7 + FRAME_CHECKSUM_LENGTH);
+
+	FrameHead parsed;
+	std::string body;
+	ASSERT_TRUE(HvProtocol::unpackFrame(frame.data(), frame.size(), parsed, body));
+	EXPECT_EQ(body, "payload");
+
+	// 任意一个比特出错都能发现，包括帧头中的编码字段
+	for (size_t i = 4; i < frame.size(); i++) {
+		auto corrupt = frame;
+		corrupt[i] = static_cast<char>(corrupt[i] ^ 0x10);
+		EXPECT_FALSE(HvProtocol::unpackFrame(corrupt.data(), corrupt.size(), parsed, body)) << i;
+	}
+}
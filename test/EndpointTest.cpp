@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "rpc/EndpointStats.h"
+#include "rpc/RegistryEntry.h"
+
+static OutlierConfig testConfig() {
+	OutlierConfig config;
+	config.consecutive_errors = 3;
+	config.error_rate = 0.5;
+	config.min_requests = 10;
+	config.window_ns = 1000;
+	config.eject_ns = 100;
+	return config;
+}
+
+TEST(EndpointTest, EjectAfterConsecutiveErrors) {
+	EndpointStats stats(testConfig());
+	uint64_t now = 10;
+	for (int i = 0; i < 2; i++) {
+		stats.OnStart();
+		stats.OnFinish("S.M", 5, CallResult::ERROR, now);
+		EXPECT_TRUE(stats.Available(now));
+	}
+	stats.OnStart();
+	stats.OnFinish("S.M", 5, CallResult::TIMEOUT, now);
+	EXPECT_FALSE(stats.Available(now));
+	EXPECT_FALSE(stats.Available(now + 99));
+	EXPECT_TRUE(stats.Available(now + 100));
+
+	auto snapshot = stats.Snapshot(now);
+	EXPECT_EQ(snapshot.requests, 3);
+	EXPECT_EQ(snapshot.errors, 2);
+	EXPECT_EQ(snapshot.timeouts, 1);
+	EXPECT_EQ(snapshot.ejections, 1);
+	EXPECT_EQ(snapshot.inflight, 0);
+	EXPECT_TRUE(snapshot.ejected);
+}
+
+TEST(EndpointTest, EjectionBacksOff) {
+	EndpointStats stats(testConfig());
+	uint64_t now = 10;
+	for (int i = 0; i < 3; i++) {
+		stats.OnFinish("S.M", 5, CallResult::CONNECT_FAILED, now);
+	}
+	EXPECT_TRUE(stats.Available(now + 100));
+
+	// 恢复后再次连续失败，摘除时长翻倍
+	now += 100;
+	for (int i = 0; i < 3; i++) {
+		stats.OnFinish("S.M", 5, CallResult::ERROR, now);
+	}
+	EXPECT_FALSE(stats.Available(now + 100));
+	EXPECT_TRUE(stats.Available(now + 200));
+	EXPECT_EQ(stats.Snapshot(now).connect_failures, 3);
+}
+
+TEST(EndpointTest, EjectByErrorRate) {
+	EndpointStats stats(testConfig());
+	uint64_t now = 10;
+	// 交替成功失败，不会触发连续失败，但错误率超过阈值
+	for (int i = 0; i < 9; i++) {
+		stats.OnFinish("S.M", 5, i % 3 == 0 ? CallResult::OK : CallResult::ERROR, now);
+		EXPECT_TRUE(stats.Available(now));
+	}
+	stats.OnFinish("S.M", 5, CallResult::ERROR, now);
+	EXPECT_FALSE(stats.Available(now));
+}
+
+TEST(EndpointTest, EjectByLatency) {
+	auto config = testConfig();
+	config.latency_ns = 1000;
+	EndpointStats stats(config);
+	stats.OnFinish("S.M", 500, CallResult::OK, 10);
+	EXPECT_TRUE(stats.Available(10));
+	for (int i = 0; i < 20 && stats.Available(10); i++) {
+		stats.OnFinish("S.M", 100000, CallResult::OK, 10);
+	}
+	EXPECT_FALSE(stats.Available(10));
+
+	auto methods = stats.MethodLatency();
+	ASSERT_EQ(methods.count("S.M"), 1);
+	EXPECT_GT(methods["S.M"].count, 1);
+}
+
+TEST(EndpointTest, ProbeAfterEjection) {
+	EndpointStats stats(testConfig());
+	uint64_t now = 10;
+	for (int i = 0; i < 3; i++) {
+		stats.OnFinish("S.M", 5, CallResult::ERROR, now);
+	}
+	EXPECT_FALSE(stats.Available(now));
+
+	// 到期后只放行一个探测请求，摘除前发出的请求的结果不影响判断
+	now += 100;
+	EXPECT_TRUE(stats.Available(now));
+	EXPECT_FALSE(stats.Available(now));
+	stats.OnStart();
+	stats.OnFinish("S.M", 5, CallResult::OK, now);
+	EXPECT_TRUE(stats.Available(now));
+
+	// 探测成功后摘除时长重新从 eject_ns 开始
+	for (int i = 0; i < 3; i++) {
+		stats.OnFinish("S.M", 5, CallResult::ERROR, now);
+	}
+	EXPECT_FALSE(stats.Available(now + 99));
+	EXPECT_TRUE(stats.Available(now + 100));
+	EXPECT_EQ(stats.Snapshot(now).ejections, 2);
+}
+
+TEST(EndpointTest, NeverEjectSingleEndpoint) {
+	auto config = testConfig();
+	config.latency_ns = 1000;
+	EjectionBudget budget(100);
+	EndpointStats stats(config, &budget);
+	for (int i = 0; i < 20; i++) {
+		stats.OnFinish("S.M", 100000, CallResult::ERROR, 10);
+		EXPECT_TRUE(stats.Available(10));
+	}
+	EXPECT_EQ(stats.Snapshot(10).ejections, 0);
+	EXPECT_EQ(budget.EjectedNum(), 0);
+}
+
+TEST(EndpointTest, MaxEjectionPercent) {
+	EjectionBudget budget(50);
+	std::vector<std::unique_ptr<EndpointStats>> endpoints;
+	for (int i = 0; i < 4; i++) {
+		endpoints.push_back(std::make_unique<EndpointStats>(testConfig(), &budget));
+	}
+	for (auto &stats : endpoints) {
+		for (int i = 0; i < 3; i++) {
+			stats->OnFinish("S.M", 5, CallResult::ERROR, 10);
+		}
+	}
+	int ejected = 0;
+	for (auto &stats : endpoints) {
+		ejected += stats->Available(10) ? 0 : 1;
+	}
+	EXPECT_EQ(ejected, 2);
+	EXPECT_EQ(budget.EjectedNum(), 2);
+
+	// 探测成功的节点归还名额，之前未取得名额的节点继续失败时被摘除
+	endpoints[0]->Available(110);
+	endpoints[0]->OnFinish("S.M", 5, CallResult::OK, 110);
+	EXPECT_EQ(budget.EjectedNum(), 1);
+	endpoints[3]->OnFinish("S.M", 5, CallResult::ERROR, 110);
+	EXPECT_FALSE(endpoints[3]->Available(110));
+	EXPECT_EQ(budget.EjectedNum(), 2);
+
+	endpoints.clear();
+	EXPECT_EQ(budget.EjectedNum(), 0);
+}
+
+TEST(EndpointTest, BudgetScopedToRoute) {
+	// 两个节点分别服务不同的服务，各自所在路由只有一个节点，都不能被摘除
+	EjectionBudget user_route(100);
+	EjectionBudget order_route(100);
+	EndpointStats user_endpoint(testConfig(), &user_route);
+	EndpointStats order_endpoint(testConfig(), &order_route);
+	for (int i = 0; i < 10; i++) {
+		user_endpoint.OnFinish("UserService.Login", 5, CallResult::ERROR, 10);
+		order_endpoint.OnFinish("OrderService.Create", 5, CallResult::ERROR, 10);
+	}
+	EXPECT_TRUE(user_endpoint.Available(10));
+	EXPECT_TRUE(order_endpoint.Available(10));
+	EXPECT_EQ(user_endpoint.Snapshot(10).ejections, 0);
+	EXPECT_EQ(order_endpoint.Snapshot(10).ejections, 0);
+	EXPECT_EQ(user_route.EjectedNum(), 0);
+	EXPECT_EQ(order_route.EjectedNum(), 0);
+
+	// 另一个节点也能服务 UserService 后，只服务该路由的节点可以摘除；同时是 OrderService 唯一节点的仍保留
+	EndpointStats backup(testConfig(), &user_route);
+	order_endpoint.JoinBudget(&user_route);
+	for (int i = 0; i < 3; i++) {
+		order_endpoint.OnFinish("OrderService.Create", 5, CallResult::ERROR, 20);
+	}
+	EXPECT_TRUE(order_endpoint.Available(20));
+	EXPECT_EQ(user_route.EjectedNum(), 0);
+	for (int i = 0; i < 3; i++) {
+		backup.OnFinish("UserService.Login", 5, CallResult::ERROR, 20);
+	}
+	EXPECT_FALSE(backup.Available(20));
+	EXPECT_EQ(user_route.EjectedNum(), 1);
+
+	// 退出路由时归还占用的名额
+	order_endpoint.LeaveBudget(&user_route);
+	EXPECT_EQ(user_route.EjectedNum(), 1);
+	user_endpoint.LeaveBudget(&user_route);
+	backup.LeaveBudget(&user_route);
+	EXPECT_EQ(user_route.EjectedNum(), 0);
+}
+
+TEST(EndpointTest, ParseRegistryEntry) {
+	RegistryEntry entry;
+	ASSERT_TRUE(RegistryEntry::Parse("127.0.0.1:9933", entry));
+	EXPECT_EQ(entry.ip, "127.0.0.1");
+	EXPECT_EQ(entry.port, 9933);
+	EXPECT_TRUE(entry.uds_path.empty());
+	EXPECT_EQ(entry.ToString(), "127.0.0.1:9933");
+
+	ASSERT_TRUE(RegistryEntry::Parse("10.0.0.1:9933;uds=/tmp/tinyrpc.sock", entry));
+	EXPECT_EQ(entry.Address(), "10.0.0.1:9933");
+	EXPECT_EQ(entry.uds_path, "/tmp/tinyrpc.sock");
+	EXPECT_EQ(entry.ToString(), "10.0.0.1:9933;uds=/tmp/tinyrpc.sock");
+
+	ASSERT_TRUE(RegistryEntry::Parse("127.0.0.1:9933;uds=/tmp/a.sock;shm=/tmp/b.sock;future=1", entry));
+	EXPECT_EQ(entry.uds_path, "/tmp/a.sock");
+	EXPECT_EQ(entry.shm_path, "/tmp/b.sock");
+	EXPECT_EQ(entry.ToString(), "127.0.0.1:9933;uds=/tmp/a.sock;shm=/tmp/b.sock");
+
+	EXPECT_FALSE(RegistryEntry::Parse("", entry));
+	EXPECT_FALSE(RegistryEntry::Parse("127.0.0.1", entry));
+	EXPECT_FALSE(RegistryEntry::Parse("127.0.0.1:abc", entry));
+	EXPECT_FALSE(RegistryEntry::Parse("127.0.0.1:70000", entry));
+}
+
+TEST(EndpointTest, LocalAddress) {
+	EXPECT_TRUE(isLocalAddress("127.0.0.1"));
+	EXPECT_FALSE(isLocalAddress("192.0.2.1"));    // TEST-NET-1，不会配置在本机
+}
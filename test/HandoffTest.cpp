@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include "rpc/ListenerHandoff.h"
+#include "utils/Listener.h"
+
+static std::string handoffPath(const char *name) {
+	return "/tmp/tinyrpc_test_" + std::to_string(getpid()) + "_" + name + ".handoff";
+}
+
+static int localPort(int fd) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len);
+	return ntohs(addr.sin_port);
+}
+
+static bool waitFor(const std::atomic<bool> &flag) {
+	for (int i = 0; i < 200 && !flag.load(); i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return flag.load();
+}
+
+TEST(HandoffTest, NoOldProcess) {
+	HandoffClient client;
+	ListenerSet listeners;
+	EXPECT_FALSE(client.Receive(handoffPath("none"), listeners));
+	EXPECT_TRUE(listeners.tcp_fds.empty());
+}
+
+TEST(HandoffTest, TransferListeners) {
+	int port = 0;
+	int tcp_fd = listenTcp("127.0.0.1", 0, false, &port);
+	ASSERT_GE(tcp_fd, 0);
+	int uds_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	ASSERT_GE(uds_fd, 0);
+
+	auto path = handoffPath("transfer");
+	std::atomic<bool> handed{false};
+	HandoffServer server;
+	ASSERT_TRUE(server.Start(path, ListenerSet{{tcp_fd}, uds_fd}, [&handed]() { handed = true; }));
+
+	HandoffClient client;
+	ListenerSet listeners;
+	ASSERT_TRUE(client.Receive(path, listeners));
+	ASSERT_EQ(listeners.tcp_fds.size(), 1u);
+	EXPECT_NE(listeners.tcp_fds[0], tcp_fd);
+	EXPECT_EQ(localPort(listeners.tcp_fds[0]), port);    // 同一个监听套接字
+	EXPECT_GE(listeners.uds_fd, 0);
+	EXPECT_FALSE(server.HandedOff());
+
+	client.Ready();
+	EXPECT_TRUE(waitFor(handed));
+	EXPECT_TRUE(server.HandedOff());
+	server.Stop();
+	EXPECT_EQ(access(path.c_str(), F_OK), 0);    // 已移交时套接字文件留给新进程
+	unlink(path.c_str());
+
+	// 旧进程关闭后，新进程持有的监听套接字仍可接受连接
+	close(tcp_fd);
+	close(uds_fd);
+	int conn = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	ASSERT_EQ(connect(conn, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), 0);
+	int accepted = accept(listeners.tcp_fds[0], nullptr, nullptr);
+	EXPECT_GE(accepted, 0);
+	close(accepted);
+	close(conn);
+	close(listeners.tcp_fds[0]);
+	close(listeners.uds_fd);
+}
+
+TEST(HandoffTest, AbortedTakeoverKeepsServing) {
+	int tcp_fd = listenTcp("127.0.0.1", 0, false);
+	ASSERT_GE(tcp_fd, 0);
+	auto path = handoffPath("abort");
+	std::atomic<bool> handed{false};
+	HandoffServer server;
+	ASSERT_TRUE(server.Start(path, ListenerSet{{tcp_fd}, -1}, [&handed]() { handed = true; }));
+
+	{
+		HandoffClient client;    // 未确认就退出
+		ListenerSet listeners;
+		ASSERT_TRUE(client.Receive(path, listeners));
+		close(listeners.tcp_fds[0]);
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_FALSE(server.HandedOff());
+
+	HandoffClient client;
+	ListenerSet listeners;
+	ASSERT_TRUE(client.Receive(path, listeners));
+	EXPECT_EQ(listeners.uds_fd, -1);
+	client.Ready();
+	EXPECT_TRUE(waitFor(handed));
+	server.Stop();
+	unlink(path.c_str());
+	close(listeners.tcp_fds[0]);
+	close(tcp_fd);
+}
+
+TEST(HandoffTest, StopWithoutHandoffRemovesPath) {
+	auto path = handoffPath("stop");
+	HandoffServer server;
+	ASSERT_TRUE(server.Start(path, ListenerSet{}, []() {}));
+	EXPECT_EQ(access(path.c_str(), F_OK), 0);
+	server.Stop();
+	EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#include "utils/Listener.h"
+
+static int connectTo(int port) {
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+// 取出监听队列中已完成握手的连接数
+static int drainAccept(int listen_fd) {
+	int count = 0;
+	struct pollfd pfd = {listen_fd, POLLIN, 0};
+	while (poll(&pfd, 1, 0) > 0) {
+		int fd = accept(listen_fd, nullptr, nullptr);
+		if (fd < 0) {
+			break;
+		}
+		close(fd);
+		count++;
+	}
+	return count;
+}
+
+TEST(ListenerTest, ReusePortSharesPort) {
+	int port = 0;
+	int first = listenTcp("127.0.0.1", 0, true, &port);
+	ASSERT_GE(first, 0);
+	ASSERT_GT(port, 0);
+	int second = listenTcp("127.0.0.1", port, true);
+	ASSERT_GE(second, 0);
+
+	// 内核按四元组哈希分配连接，足够多的连接会落到两个套接字上
+	std::vector<int> clients;
+	for (int i = 0; i < 64; i++) {
+		int fd = connectTo(port);
+		ASSERT_GE(fd, 0);
+		clients.push_back(fd);
+	}
+	int first_count = drainAccept(first);
+	int second_count = drainAccept(second);
+	EXPECT_EQ(first_count + second_count, 64);
+	EXPECT_GT(first_count, 0);
+	EXPECT_GT(second_count, 0);
+
+	for (int fd : clients) {
+		close(fd);
+	}
+	close(first);
+	close(second);
+}
+
+TEST(ListenerTest, PortInUseWithoutReusePort) {
+	int port = 0;
+	int first = listenTcp("127.0.0.1", 0, false, &port);
+	ASSERT_GE(first, 0);
+	EXPECT_LT(listenTcp("127.0.0.1", port, false), 0);
+	EXPECT_LT(listenTcp("127.0.0.1", port, true), 0);
+	EXPECT_LT(listenTcp("not an ip", 0, false), 0);
+	close(first);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <thread>
+#include "rpc/LocalRegistry.h"
+#include "rpc/RpcController.h"
+#include "user.tinyrpc.h"
+
+// 记录服务方法收到的对象与所在线程，并回显附件
+class RecordingHandler : public test::UserServiceRpcHandler {
+ public:
+  const test::LoginRequest *last_request = nullptr;
+  std::thread::id last_thread;
+
+  void Login(RpcController *controller, const test::LoginRequest *request, test::LoginResponse *response,
+			 google::protobuf::Closure *done) override {
+	  last_request = request;
+	  last_thread = std::this_thread::get_id();
+	  if (request->name().empty()) {
+		  controller->SetFailed("empty name");
+	  } else {
+		  response->set_success(true);
+		  response->mutable_result()->set_errmsg(request->name());
+		  controller->SetAttachment("echo:" + std::string(controller->ReceivedAttachment()));
+	  }
+	  done->Run();
+  }
+};
+
+class LocalRegistryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+	  LocalRegistry::getInstance()->Publish(&handler, test::LoginRequest::descriptor()->file()->FindServiceByName("UserServiceRpc"));
+	  method = test::LoginRequest::descriptor()->file()->FindServiceByName("UserServiceRpc")->FindMethodByName("Login");
+  }
+  void TearDown() override {
+	  LocalRegistry::getInstance()->SetMode(LoopbackMode::OFF);
+	  LocalRegistry::getInstance()->SetZeroCopy(false);
+	  LocalRegistry::getInstance()->Unpublish("UserServiceRpc");
+  }
+
+  RecordingHandler handler;
+  const google::protobuf::MethodDescriptor *method = nullptr;
+};
+
+TEST_F(LocalRegistryTest, DisabledByDefault) {
+	test::LoginRequest request;
+	test::LoginResponse response;
+	RpcController controller;
+	EXPECT_FALSE(LocalRegistry::getInstance()->Call(method, &controller, &request, &response, nullptr));
+}
+
+TEST_F(LocalRegistryTest, InlineCopiesRequest) {
+	LocalRegistry::getInstance()->SetMode(LoopbackMode::INLINE);
+	test::LoginRequest request;
+	request.set_name("xy");
+	test::LoginResponse response;
+	RpcController controller;
+	controller.SetAttachment("blob");
+	ASSERT_TRUE(LocalRegistry::getInstance()->Call(method, &controller, &request, &response, nullptr));
+	EXPECT_FALSE(controller.Failed());
+	EXPECT_TRUE(response.success());
+	EXPECT_EQ(response.result().errmsg(), "xy");
+	EXPECT_EQ(controller.ReceivedAttachment(), "echo:blob");
+	EXPECT_NE(handler.last_request, &request);
+	EXPECT_EQ(handler.last_thread, std::this_thread::get_id());
+}
+
+TEST_F(LocalRegistryTest, ZeroCopyPassesObjects) {
+	LocalRegistry::getInstance()->SetMode(LoopbackMode::INLINE);
+	LocalRegistry::getInstance()->SetZeroCopy(true);
+	test::LoginRequest request;
+	request.set_name("xy");
+	test::LoginResponse response;
+	RpcController controller;
+	ASSERT_TRUE(LocalRegistry::getInstance()->Call(method, &controller, &request, &response, nullptr));
+	EXPECT_EQ(handler.last_request, &request);
+	EXPECT_TRUE(response.success());
+}
+
+TEST_F(LocalRegistryTest, ErrorsReachCaller) {
+	LocalRegistry::getInstance()->SetMode(LoopbackMode::INLINE);
+	test::LoginRequest request;
+	test::LoginResponse response;
+	RpcController controller;
+	ASSERT_TRUE(LocalRegistry::getInstance()->Call(method, &controller, &request, &response, nullptr));
+	EXPECT_TRUE(controller.Failed());
+	EXPECT_EQ(controller.ErrorText(), "empty name");
+}
+
+TEST_F(LocalRegistryTest, WorkerRunsAsync) {
+	LocalRegistry::getInstance()->SetMode(LoopbackMode::WORKER);
+	test::LoginRequest request;
+	request.set_name("async");
+	test::LoginResponse response;
+	RpcController controller;
+	std::promise<void> finished;
+	ASSERT_TRUE(LocalRegistry::getInstance()->Call(
+		method, &controller, &request, &response,
+		google::protobuf::NewCallback(&finished, &std::promise<void>::set_value)));
+	finished.get_future().get();
+	EXPECT_NE(handler.last_thread, std::this_thread::get_id());
+	EXPECT_EQ(response.result().errmsg(), "async");
+}
+
+TEST_F(LocalRegistryTest, UnknownServiceFallsBack) {
+	LocalRegistry::getInstance()->SetMode(LoopbackMode::INLINE);
+	LocalRegistry::getInstance()->Unpublish("UserServiceRpc");
+	test::LoginRequest request;
+	test::LoginResponse response;
+	RpcController controller;
+	EXPECT_FALSE(LocalRegistry::getInstance()->Call(method, &controller, &request, &response, nullptr));
+}
@@ -1,8 +1,85 @@
 #include "utils/Log.h"
+#include "utils/Config.h"
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
 
 TEST(LoggerTest, LoggerBase) {
 	std::string name = "xy";
 	LOG_INFO("name {} age {}", name, 18);
 }
 
+TEST(LoggerTest, RollBySize) {
+	// 滚动出的文件写入临时目录，结束后删除
+	auto dir = std::filesystem::temp_directory_path() / ("tinyrpc_log_test_" + std::to_string(getpid()));
+	std::filesystem::create_directories(dir);
+	{
+		Logger logger("roll", dir.string() + "/");
+		logger.max_file_size_ = 16;    // 每条日志都会超过该大小，触发滚动
+		for (int i = 0; i < 3; i++) {
+			logger.Log("roll test message " + std::to_string(i));
+		}
+	}
+	auto files = std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator{});
+	std::filesystem::remove_all(dir);
+	EXPECT_GE(files, 3);
+}
+
+TEST(LoggerTest, NamedInstance) {
+	auto slow = Logger::getInstance("slow");
+	EXPECT_NE(slow, Logger::getInstance());
+	EXPECT_EQ(slow, Logger::getInstance("slow"));
+	LOG_SLOW("method {} total {}us", "test.UserServiceRpc.Login", 123);
+}
+
+TEST(LoggerTest, LevelFollowsConfig) {
+	auto dir = std::filesystem::temp_directory_path() / ("tinyrpc_log_level_" + std::to_string(getpid()));
+	std::filesystem::create_directories(dir);
+	auto config = Config::getInstance();
+	auto origin_path = config->path_;
+	auto path = (dir / "config.ini").string();
+	// 在原配置的基础上只改 log_level
+	auto setLevel = [&](const std::string &level) {
+	  std::ifstream ifs(origin_path);
+	  std::ofstream ofs(path, std::ios::trunc);
+	  std::string line;
+	  while (std::getline(ifs, line)) {
+		  ofs << (line.rfind("log_level=", 0) == 0 ? "log_level=" + level : line) << '\n';
+	  }
+	  ofs.close();
+	  config->path_ = path;
+	  ASSERT_TRUE(config->reload());
+	};
+	{
+		Logger logger("", dir.string() + "/");
+		Logger named("named", dir.string() + "/");
+		setLevel("DEBUG");
+		EXPECT_EQ(logger.level(), LOGLEVEL::DEBUG);
+		logTo(&logger, LOGLEVEL::DEBUG, "test", "debug visible");
+		logTo(&logger, LOGLEVEL::INFO, "test", "info visible");
+
+		setLevel("ERROR");
+		EXPECT_EQ(logger.level(), LOGLEVEL::ERROR);
+		EXPECT_EQ(named.level(), LOGLEVEL::INFO);    // 具名实例不跟随 log_level
+		logTo(&logger, LOGLEVEL::INFO, "test", "info hidden");
+		logTo(&logger, LOGLEVEL::ERROR, "test", "error visible");
+		logTo(&named, LOGLEVEL::INFO, "test", "named visible");
+	}
+	config->path_ = origin_path;
+	EXPECT_TRUE(config->reload());
+
+	std::string content;
+	for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+		if (entry.path().extension() == ".log") {
+			std::ifstream ifs(entry.path());
+			content.append(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+		}
+	}
+	std::filesystem::remove_all(dir);
+	EXPECT_NE(content.find("debug visible"), std::string::npos);
+	EXPECT_NE(content.find("info visible"), std::string::npos);
+	EXPECT_EQ(content.find("info hidden"), std::string::npos);
+	EXPECT_NE(content.find("error visible"), std::string::npos);
+	EXPECT_NE(content.find("named visible"), std::string::npos);
+}
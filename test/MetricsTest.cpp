@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "utils/Histogram.h"
+#include "rpc/RpcMetrics.h"
+
+TEST(MetricsTest, HistogramBucketBounds) {
+	// 每个值都必须落在其所在桶的上界之内，且相对误差不超过 1/kSubBucketCount
+	for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456ull, 987654321ull}) {
+		auto upper = histogramBucketUpper(histogramBucketIndex(value));
+		EXPECT_GT(upper, value);
+		EXPECT_LE(upper - value, value / kSubBucketCount + 1);
+	}
+	EXPECT_EQ(histogramBucketIndex(~0ull), kBucketCount - 1);
+}
+
+TEST(MetricsTest, HistogramPercentile) {
+	Histogram histogram;
+	for (uint64_t i = 1; i <= 1000; i++) {
+		histogram.record(i * 1000);
+	}
+	HistogramSnapshot snapshot;
+	histogram.snapshotInto(snapshot);
+	EXPECT_EQ(snapshot.count, 1000);
+	EXPECT_EQ(snapshot.mean(), 500500);
+	auto p50 = snapshot.percentile(0.5);
+	EXPECT_GE(p50, 500000);
+	EXPECT_LE(p50, 500000 + 500000 / kSubBucketCount);
+	auto p99 = snapshot.percentile(0.99);
+	EXPECT_GE(p99, 990000);
+	EXPECT_LE(p99, 990000 + 990000 / kSubBucketCount);
+}
+
+TEST(MetricsTest, MethodMetricsMergeShards) {
+	MethodMetrics metrics;
+	const int num_threads = 8;
+	const int per_thread = 10000;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < num_threads; i++) {
+		threads.emplace_back([&]() {
+		  for (int j = 0; j < per_thread; j++) {
+			  metrics.onRequest(10);
+			  metrics.recordHandlerTime(100);
+			  metrics.onResponse(20);
+		  }
+		  metrics.onError();
+		});
+	}
+	for (auto &t : threads) t.join();
+
+	auto snapshot = metrics.snapshot();
+	EXPECT_EQ(snapshot.requests, num_threads * per_thread);
+	EXPECT_EQ(snapshot.errors, num_threads);
+	EXPECT_EQ(snapshot.bytes_in, num_threads * per_thread * 10);
+	EXPECT_EQ(snapshot.bytes_out, num_threads * per_thread * 20);
+	EXPECT_EQ(snapshot.handler_time.count, num_threads * per_thread);
+	EXPECT_EQ(snapshot.queue_time.count, 0);
+}
+
+TEST(MetricsTest, RenderPrometheus) {
+	MethodMetrics metrics;
+	metrics.onRequest(10);
+	metrics.recordHandlerTime(2000000);
+	MethodMetricsList list = {{"UserServiceRpc.Login", metrics.snapshot()}};
+	auto text = renderPrometheus(list);
+	EXPECT_NE(text.find("tinyrpc_requests_total{method=\"UserServiceRpc.Login\"} 1\n"), std::string::npos);
+	EXPECT_NE(text.find("tinyrpc_handler_seconds_count{method=\"UserServiceRpc.Login\"} 1\n"), std::string::npos);
+	EXPECT_NE(text.find("# TYPE tinyrpc_queue_seconds summary"), std::string::npos);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "rpc/RequestCoalescer.h"
+#include "rpc/ResponseCache.h"
+#include "proto/tinyrpc_options.pb.h"
+#include "user.pb.h"
+
+TEST(ResponseCacheTest, GetAfterPut) {
+	ResponseCache cache(1024 * 1024);
+	auto key = RequestCoalescer::makeKey("UserServiceRpc", "GetProfile", "xy");
+	EXPECT_EQ(cache.Get(key), nullptr);
+	cache.Put(key, "profile", 10000);
+	auto body = cache.Get(key);
+	ASSERT_NE(body, nullptr);
+	EXPECT_EQ(*body, "profile");
+
+	cache.Put(key, "profile v2", 10000);
+	EXPECT_EQ(*cache.Get(key), "profile v2");
+	EXPECT_EQ(cache.Size(), 1u);
+	EXPECT_EQ(*body, "profile");    // 已取出的响应不受替换影响
+}
+
+TEST(ResponseCacheTest, Expire) {
+	ResponseCache cache(1024 * 1024);
+	cache.Put("key", "value", 1);
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	EXPECT_EQ(cache.Get("key"), nullptr);
+	EXPECT_EQ(cache.Size(), 0u);
+	EXPECT_EQ(cache.Bytes(), 0u);
+}
+
+TEST(ResponseCacheTest, ByteBudget) {
+	ResponseCache cache(kCacheShards * 4096);
+	std::string body(512, 'x');
+	for (int i = 0; i < 1000; i++) {
+		cache.Put("key" + std::to_string(i), body, 10000);
+	}
+	EXPECT_LE(cache.Bytes(), kCacheShards * 4096);
+	EXPECT_GT(cache.Size(), 0u);
+
+	// 超过分片容量的响应不缓存
+	cache.Put("large", std::string(8192, 'x'), 10000);
+	EXPECT_EQ(cache.Get("large"), nullptr);
+
+	cache.SetCapacity(0);
+	EXPECT_EQ(cache.Size(), 0u);
+	cache.Put("key", body, 10000);
+	EXPECT_EQ(cache.Get("key"), nullptr);
+}
+
+TEST(ResponseCacheTest, ClockKeepsReferenced) {
+	// 所有键落在同一分片时容量为 kSlots 个条目，被访问过的条目躲过一轮淘汰
+	constexpr size_t kSlots = 8;
+	std::string body(100, 'x');
+	std::vector<std::string> keys;
+	for (int i = 0; keys.size() < kSlots * 4; i++) {
+		auto key = "key" + std::to_string(i);
+		if (std::hash<std::string>()(key) % kCacheShards == 0) {
+			keys.push_back(key);
+		}
+	}
+	size_t charge = keys[0].size() + body.size() + 64;
+	ResponseCache cache(kCacheShards * (charge * kSlots + charge / 2));
+	for (size_t i = 0; i < kSlots; i++) {
+		cache.Put(keys[i], body, 10000);
+	}
+	ASSERT_NE(cache.Get(keys[0]), nullptr);
+	for (size_t i = kSlots; i < kSlots * 2; i++) {
+		cache.Put(keys[i], body, 10000);
+		ASSERT_NE(cache.Get(keys[0]), nullptr);
+	}
+	EXPECT_EQ(cache.Size(), kSlots);
+	EXPECT_EQ(cache.Get(keys[1]), nullptr);
+}
+
+TEST(ResponseCacheTest, Concurrent) {
+	ResponseCache cache(kCacheShards * 8192);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&cache, t]() {
+		  for (int i = 0; i < 2000; i++) {
+			  auto key = std::to_string((i * 7 + t) % 300);
+			  if (auto body = cache.Get(key)) {
+				  EXPECT_EQ(*body, "value" + key);
+			  } else {
+				  cache.Put(key, "value" + key, 10000);
+			  }
+		  }
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	EXPECT_LE(cache.Bytes(), kCacheShards * 8192);
+}
+
+TEST(ResponseCacheTest, FailedCallNotCached) {
+	ResponseCache cache(1024 * 1024);
+	auto key = RequestCoalescer::makeKey("UserServiceRpc", "GetProfile", "xy");
+	test::ProfileResponse response;
+	response.set_name("xy");    // 业务方法失败前只填了一部分
+	RpcController controller;
+	controller.SetFailed("profile not found");
+	EXPECT_FALSE(cache.Store(key, RequestCoalescer::makeResult(controller, response), 10000));
+	EXPECT_EQ(cache.Get(key), nullptr);
+
+	// 带附件的响应同样不缓存
+	RpcController with_attachment;
+	with_attachment.SetAttachment("avatar");
+	EXPECT_FALSE(cache.Store(key, RequestCoalescer::makeResult(with_attachment, response), 10000));
+	EXPECT_EQ(cache.Get(key), nullptr);
+
+	RpcController succeeded;
+	EXPECT_TRUE(cache.Store(key, RequestCoalescer::makeResult(succeeded, response), 10000));
+	auto body = cache.Get(key);
+	ASSERT_NE(body, nullptr);
+	EXPECT_EQ(*body, response.SerializeAsString());
+}
+
+TEST(ResponseCacheTest, MethodOption) {
+	auto service = test::LoginRequest::descriptor()->file()->FindServiceByName("UserServiceRpc");
+	ASSERT_NE(service, nullptr);
+	EXPECT_EQ(service->FindMethodByName("GetProfile")->options().GetExtension(tinyrpc::cache_ttl_ms), 1000u);
+	EXPECT_EQ(service->FindMethodByName("Login")->options().GetExtension(tinyrpc::cache_ttl_ms), 0u);
+}
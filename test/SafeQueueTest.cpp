@@ -2,6 +2,7 @@
 #include "utils/SafeQueue.h"  // 需要确保 SafeQueue 的头文件路径正确
 #include <thread>
 #include <vector>
+#include <atomic>
 
 TEST(SafeQueueTest, PushAndPopSingleThread) {
 	SafeQueue<int> queue;
@@ -68,3 +69,51 @@ TEST(SafeQueueTest, StopFunctionality) {
 	queue.stop();
 	consumer.join();
 }
+
+TEST(SafeQueueTest, BoundedTryPushFailsWhenFull) {
+	SafeQueue<int> queue(2);
+	EXPECT_TRUE(queue.tryPush(1));
+	EXPECT_TRUE(queue.tryPush(2));
+	EXPECT_FALSE(queue.tryPush(3));    // 已满
+	EXPECT_EQ(queue.size(), 2);
+
+	int value;
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 1);
+	EXPECT_TRUE(queue.tryPush(3));
+}
+
+TEST(SafeQueueTest, BoundedPushBlocksUntilPop) {
+	SafeQueue<int> queue(1);
+	queue.push(1);
+	std::atomic<bool> pushed = false;
+	std::thread producer([&]() {
+	  queue.push(2);    // 队列已满，阻塞直到 pop
+	  pushed = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	EXPECT_FALSE(pushed);
+
+	int value;
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 1);
+	producer.join();
+	EXPECT_TRUE(pushed);
+	ASSERT_TRUE(queue.pop(value));
+	EXPECT_EQ(value, 2);
+}
+
+TEST(SafeQueueTest, PushAfterStopRejected) {
+	SafeQueue<int> queue(2);
+	EXPECT_TRUE(queue.push(1));
+	queue.stop();
+	EXPECT_FALSE(queue.push(2));
+	EXPECT_FALSE(queue.tryPush(3));
+	EXPECT_EQ(queue.size(), 1);
+
+	int value;
+	ASSERT_TRUE(queue.pop(value));    // 停止前入队的元素仍可取出
+	EXPECT_EQ(value, 1);
+	EXPECT_FALSE(queue.pop(value));
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "utils/FdPassing.h"
+#include "utils/ShmRing.h"
+
+constexpr size_t kCapacity = 4096;
+
+TEST(ShmRingTest, WriteAndRead) {
+	std::vector<char> memory(ShmRing::regionSize(kCapacity) + 64);
+	void *aligned = memory.data() + (64 - reinterpret_cast<uintptr_t>(memory.data()) % 64) % 64;
+	ShmRing ring(aligned, kCapacity, true);
+
+	EXPECT_TRUE(ring.empty());
+	ASSERT_TRUE(ring.tryWrite("hello", 5));
+	ASSERT_TRUE(ring.tryWrite("", 0));
+
+	const char *data;
+	size_t size;
+	ASSERT_TRUE(ring.peek(data, size));
+	EXPECT_EQ(std::string(data, size), "hello");
+	ring.consume();
+	ASSERT_TRUE(ring.peek(data, size));
+	EXPECT_EQ(size, 0u);
+	ring.consume();
+	EXPECT_FALSE(ring.peek(data, size));
+
+	// 超过单条记录上限
+	std::string big(ring.maxRecord() + 1, 'x');
+	EXPECT_FALSE(ring.tryWrite(big.data(), big.size()));
+}
+
+TEST(ShmRingTest, WrapAround) {
+	std::vector<char> memory(ShmRing::regionSize(kCapacity) + 64);
+	void *aligned = memory.data() + (64 - reinterpret_cast<uintptr_t>(memory.data()) % 64) % 64;
+	ShmRing ring(aligned, kCapacity, true);
+
+	// 长度不整除容量，反复写读会多次跨越末尾
+	for (int i = 0; i < 1000; i++) {
+		std::string record(300 + i % 50, static_cast<char>('a' + i % 26));
+		ASSERT_TRUE(ring.tryWrite(record.data(), record.size())) << i;
+		const char *data;
+		size_t size;
+		ASSERT_TRUE(ring.peek(data, size));
+		ASSERT_EQ(std::string(data, size), record);
+		ring.consume();
+	}
+
+	// 写满后失败，读出一条后可以继续写
+	std::string record(1000, 'x');
+	int written = 0;
+	while (ring.tryWrite(record.data(), record.size())) {
+		written++;
+	}
+	EXPECT_GT(written, 0);
+	const char *data;
+	size_t size;
+	ASSERT_TRUE(ring.peek(data, size));
+	ring.consume();
+	EXPECT_TRUE(ring.tryWrite(record.data(), record.size()));
+}
+
+TEST(ShmRingTest, CorruptHeaderDetected) {
+	std::vector<char> memory(ShmRing::regionSize(kCapacity) + 64);
+	void *aligned = memory.data() + (64 - reinterpret_cast<uintptr_t>(memory.data()) % 64) % 64;
+	ShmRing ring(aligned, kCapacity, true);
+	ASSERT_TRUE(ring.tryWrite("hello", 5));
+
+	// 对端把记录长度改成越界的值
+	auto header = static_cast<ShmRingHeader *>(aligned);
+	uint32_t len = kCapacity;
+	memcpy(reinterpret_cast<char *>(header + 1), &len, sizeof(len));
+	const char *data;
+	size_t size;
+	EXPECT_FALSE(ring.peek(data, size));
+	EXPECT_TRUE(ring.corrupted());
+}
+
+TEST(ShmRingTest, ProducerConsumerThreads) {
+	std::vector<char> memory(ShmRing::regionSize(kCapacity) + 64);
+	void *aligned = memory.data() + (64 - reinterpret_cast<uintptr_t>(memory.data()) % 64) % 64;
+	ShmRing ring(aligned, kCapacity, true);
+	int event_fd = eventfd(0, EFD_NONBLOCK);
+	const int count = 100000;
+
+	std::thread producer([&]() {
+	  for (int i = 0; i < count; i++) {
+		  auto value = std::to_string(i);
+		  while (!ring.tryWrite(value.data(), value.size())) {
+			  std::this_thread::yield();
+		  }
+		  ring.notify(event_fd);
+	  }
+	});
+
+	ShmWaiter waiter;
+	const char *data;
+	size_t size;
+	for (int i = 0; i < count;) {
+		while (i < count && ring.peek(data, size)) {
+			ASSERT_EQ(std::string(data, size), std::to_string(i));
+			ring.consume();
+			i++;
+		}
+		if (i < count) {
+			ASSERT_TRUE(waiter.wait(ring, event_fd, -1));
+		}
+	}
+	producer.join();
+	close(event_fd);
+}
+
+TEST(ShmRingTest, CrossProcessWithFdPassing) {
+	int socks[2];
+	ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, socks), 0);
+	auto region_size = ShmRing::regionSize(kCapacity);
+
+	pid_t pid = fork();
+	ASSERT_GE(pid, 0);
+	if (pid == 0) {
+		// 子进程：接收 memfd 与 eventfd，读出一条记录后回写
+		close(socks[0]);
+		int fds[2];
+		char tag;
+		if (recvFds(socks[1], &tag, 1, fds, 2) != 2) {
+			_exit(1);
+		}
+		auto memory = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+		ShmRing ring(memory, kCapacity, false);
+		ShmWaiter waiter;
+		const char *data;
+		size_t size;
+		if (!waiter.wait(ring, fds[1], socks[1]) || !ring.peek(data, size)) {
+			_exit(2);
+		}
+		std::string reply = "pong:" + std::string(data, size);
+		send(socks[1], reply.data(), reply.size(), 0);
+		_exit(0);
+	}
+
+	close(socks[1]);
+	int mem_fd = memfd_create("shm_ring_test", MFD_CLOEXEC);
+	ASSERT_EQ(ftruncate(mem_fd, static_cast<off_t>(region_size)), 0);
+	auto memory = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, 0);
+	ShmRing ring(memory, kCapacity, true);
+	int event_fd = eventfd(0, EFD_NONBLOCK);
+	int fds[2] = {mem_fd, event_fd};
+	ASSERT_EQ(sendFds(socks[0], "x", 1, fds, 2), 0);
+
+	usleep(20000);    // 让子进程进入阻塞等待，验证唤醒
+	ASSERT_TRUE(ring.tryWrite("ping", 4));
+	ring.notify(event_fd);
+
+	char buf[32] = {0};
+	auto n = recv(socks[0], buf, sizeof(buf), 0);
+	EXPECT_EQ(std::string(buf, n > 0 ? n : 0), "pong:ping");
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	munmap(memory, region_size);
+	close(mem_fd);
+	close(event_fd);
+	close(socks[0]);
+}
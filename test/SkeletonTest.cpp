@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include "user.tinyrpc.h"
+
+// 按生成的分发表在本地分发调用，参数与响应经过一次序列化，模拟 RpcProvider 的处理过程
+class LoopbackChannel : public google::protobuf::RpcChannel {
+ public:
+  explicit LoopbackChannel(RpcSkeleton *service) : service(service) {}
+
+  void CallMethod(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
+				  const google::protobuf::Message *request, google::protobuf::Message *response,
+				  google::protobuf::Closure *done) override {
+	  const auto &table = service->DispatchTable();
+	  const RpcMethodEntry *entry = nullptr;
+	  for (size_t i = 0; i < table.method_count; i++) {
+		  if (method->name() == table.methods[i].name) {
+			  entry = &table.methods[i];
+		  }
+	  }
+	  ASSERT_NE(entry, nullptr);
+	  std::unique_ptr<google::protobuf::Message> server_request(entry->new_request());
+	  std::unique_ptr<google::protobuf::Message> server_response(entry->new_response());
+	  ASSERT_TRUE(server_request->ParseFromString(request->SerializeAsString()));
+	  RpcController server_controller;
+	  bool finished = false;
+	  entry->invoke(service, &server_controller, server_request.get(), server_response.get(),
+					google::protobuf::NewCallback(&SetTrue, &finished));
+	  ASSERT_TRUE(finished);
+	  if (server_controller.Failed()) {
+		  controller->SetFailed(server_controller.ErrorText());
+	  } else {
+		  response->ParseFromString(server_response->SerializeAsString());
+	  }
+	  if (done != nullptr) {
+		  done->Run();
+	  }
+  }
+ private:
+  static void SetTrue(bool *flag) { *flag = true; }
+  RpcSkeleton *service;
+};
+
+class LoginHandler : public test::UserServiceRpcHandler {
+ public:
+  void Login(RpcController *controller, const test::LoginRequest *request, test::LoginResponse *response,
+			 google::protobuf::Closure *done) override {
+	  response->set_success(request->pwd() == "123");
+	  response->mutable_result()->set_errmsg("hello " + request->name());
+	  done->Run();
+  }
+};
+
+TEST(SkeletonTest, DispatchTableMatchesDescriptor) {
+	LoginHandler handler;
+	const auto &table = handler.DispatchTable();
+	EXPECT_STREQ(table.full_name, "test.UserServiceRpc");
+	auto descriptor = google::protobuf::DescriptorPool::generated_pool()->FindServiceByName(table.full_name);
+	ASSERT_NE(descriptor, nullptr);
+	ASSERT_EQ(table.method_count, static_cast<size_t>(descriptor->method_count()));
+	for (size_t i = 0; i < table.method_count; i++) {
+		auto method = descriptor->FindMethodByName(table.methods[i].name);
+		ASSERT_NE(method, nullptr);
+		std::unique_ptr<google::protobuf::Message> request(table.methods[i].new_request());
+		std::unique_ptr<google::protobuf::Message> response(table.methods[i].new_response());
+		EXPECT_EQ(request->GetDescriptor(), method->input_type());
+		EXPECT_EQ(response->GetDescriptor(), method->output_type());
+	}
+}
+
+TEST(SkeletonTest, SyncCall) {
+	LoginHandler handler;
+	LoopbackChannel channel(&handler);
+	test::UserServiceRpcClient client(&channel);
+	test::LoginRequest request;
+	request.set_name("xy");
+	request.set_pwd("123");
+	test::LoginResponse response;
+	EXPECT_TRUE(client.Login(request, &response));
+	EXPECT_TRUE(response.success());
+	EXPECT_EQ(response.result().errmsg(), "hello xy");
+}
+
+TEST(SkeletonTest, AsyncCall) {
+	LoginHandler handler;
+	LoopbackChannel channel(&handler);
+	test::UserServiceRpcClient client(&channel);
+	test::LoginRequest request;
+	request.set_pwd("bad");
+	test::LoginResponse response;
+	RpcController controller;
+	bool called = false;
+	client.Login(&controller, &request, &response, google::protobuf::NewCallback(+[](bool *flag) { *flag = true; }, &called));
+	EXPECT_TRUE(called);
+	EXPECT_FALSE(controller.Failed());
+	EXPECT_FALSE(response.success());
+}
+
+TEST(SkeletonTest, UnimplementedMethodFails) {
+	test::UserServiceRpcHandler handler;
+	LoopbackChannel channel(&handler);
+	test::UserServiceRpcClient client(&channel);
+	test::LoginRequest request;
+	test::LoginResponse response;
+	RpcController controller;
+	EXPECT_FALSE(client.Login(request, &response, &controller));
+	EXPECT_EQ(controller.ErrorText(), "Method Login() not implemented.");
+}
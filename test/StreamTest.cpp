@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "proto/rpc_header.pb.h"
+#include "rpc/RpcErrorCode.h"
+#include "rpc/RpcStream.h"
+#include "utils/HvProtocol.h"
+
+// 把两个流背对背连起来，帧经过完整的打包/拆包后交给对端
+struct StreamPair {
+  std::shared_ptr<ClientStream> client;
+  std::shared_ptr<ServerStream> server;
+  std::atomic<int64_t> client_buffered{0};    // 已送达客户端但尚未被读取的字节数
+  std::atomic<int64_t> max_buffered{0};
+
+  StreamPair(size_t client_window, size_t server_window) {
+	  client = std::make_shared<ClientStream>(1, [this](const std::string &frame) { Deliver(frame, true); },
+											  client_window);
+	  server = std::make_shared<ServerStream>(1, [this](const std::string &frame) { Deliver(frame, false); },
+											  server_window, client_window);
+	  // 服务端接受流后回送自己的接收窗口
+	  client->OnFrame(STREAM_WINDOW, packStreamStatus(static_cast<int>(server_window), ""));
+  }
+
+  // 未结束的客户端流析构时会向服务端发送 STREAM_RESET，需先于服务端释放
+  ~StreamPair() { client.reset(); }
+
+  void Deliver(const std::string &frame, bool to_server) {
+	  FrameHead head;
+	  std::string body, payload;
+	  uint64_t id;
+	  StreamKind kind;
+	  ASSERT_TRUE(HvProtocol::unpackFrame(frame.data(), frame.size(), head, body));
+	  ASSERT_EQ(head.type, FRAME_STREAM);
+	  ASSERT_TRUE(parseStreamFrame(body, id, kind, payload));
+	  ASSERT_EQ(id, 1u);
+	  if (to_server) {
+		  server->OnFrame(kind, payload);
+		  return;
+	  }
+	  if (kind == STREAM_MESSAGE) {
+		  auto buffered = client_buffered.fetch_add(static_cast<int64_t>(payload.size())) + payload.size();
+		  auto max = max_buffered.load();
+		  while (buffered > max && !max_buffered.compare_exchange_weak(max, buffered)) {}
+	  }
+	  client->OnFrame(kind, payload);
+  }
+};
+
+static tinyrpc::RpcResponseHeader makeMessage(uint64_t seq, size_t size) {
+	tinyrpc::RpcResponseHeader message;
+	message.set_call_id(seq);
+	message.set_error_text(std::string(size, 'x'));
+	return message;
+}
+
+TEST(StreamTest, FrameRoundTrip) {
+	auto frame = packStreamFrame(0x0102030405060708ULL, STREAM_END, packStreamStatus(7, "done"));
+	FrameHead head;
+	std::string body, payload;
+	uint64_t id;
+	StreamKind kind;
+	ASSERT_TRUE(HvProtocol::unpackFrame(frame.data(), frame.size(), head, body));
+	ASSERT_TRUE(parseStreamFrame(body, id, kind, payload));
+	EXPECT_EQ(id, 0x0102030405060708ULL);
+	EXPECT_EQ(kind, STREAM_END);
+	EXPECT_EQ(payload.substr(4), "done");
+	EXPECT_FALSE(parseStreamFrame("short", id, kind, payload));
+
+	uint32_t window;
+	std::string header;
+	ASSERT_TRUE(parseStreamOpen(packStreamOpen(65536, "hdr"), window, header));
+	EXPECT_EQ(window, 65536u);
+	EXPECT_EQ(header, "hdr");
+}
+
+TEST(StreamTest, ServerStreamingIsFlowControlled) {
+	constexpr size_t kWindow = 8 * 1024;
+	constexpr size_t kMessageSize = 1000;
+	constexpr int kCount = 500;
+	StreamPair pair(kWindow, kWindow);
+
+	std::thread server([&pair]() {
+	  for (int i = 0; i < kCount; i++) {
+		  ASSERT_TRUE(pair.server->Write(makeMessage(i, kMessageSize)));
+	  }
+	  pair.server->Finish(RPC_OK, "all sent");
+	});
+
+	tinyrpc::RpcResponseHeader message;
+	int received = 0;
+	while (true) {
+		if (!pair.client->Read(&message)) {
+			break;
+		}
+		pair.client_buffered.fetch_sub(static_cast<int64_t>(message.ByteSizeLong()));
+		EXPECT_EQ(message.call_id(), static_cast<uint64_t>(received));
+		received++;
+		if (received % 50 == 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));    // 慢消费者
+		}
+	}
+	server.join();
+	EXPECT_EQ(received, kCount);
+	std::string text;
+	EXPECT_EQ(pair.client->Finish(&text), RPC_OK);
+	EXPECT_EQ(text, "all sent");
+	// 接收端缓存不超过一个窗口加一条消息；Read 返回后才扣除计数，统计上再多算一条正在读取的消息
+	EXPECT_LE(pair.max_buffered.load(), static_cast<int64_t>(kWindow + 2 * (kMessageSize + 16)));
+}
+
+TEST(StreamTest, ClientStreaming) {
+	StreamPair pair(4096, 4096);
+	std::thread server([&pair]() {
+	  tinyrpc::RpcResponseHeader message;
+	  uint64_t sum = 0;
+	  while (pair.server->Read(&message)) {
+		  sum += message.call_id();
+	  }
+	  pair.server->Finish(RPC_OK, std::to_string(sum));
+	});
+
+	uint64_t expected = 0;
+	for (uint64_t i = 1; i <= 200; i++) {
+		ASSERT_TRUE(pair.client->Write(makeMessage(i, 100)));
+		expected += i;
+	}
+	pair.client->WritesDone();
+	EXPECT_FALSE(pair.client->Write(makeMessage(0, 1)));
+	std::string text;
+	EXPECT_EQ(pair.client->Finish(&text), RPC_OK);
+	EXPECT_EQ(text, std::to_string(expected));
+	server.join();
+}
+
+TEST(StreamTest, CancelUnblocksPeer) {
+	StreamPair pair(1024, 1024);
+	std::thread server([&pair]() {
+	  // 客户端不读取，窗口用完后 Write 阻塞，直到客户端取消
+	  while (pair.server->Write(makeMessage(0, 500))) {}
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	pair.client->Cancel("bye");
+	server.join();
+
+	tinyrpc::RpcResponseHeader message;
+	EXPECT_FALSE(pair.client->Read(&message));
+	std::string text;
+	EXPECT_EQ(pair.client->Finish(&text), RPC_ERR_CANCELLED);
+	EXPECT_EQ(text, "bye");
+}
+
+TEST(StreamTest, AbortFailsReaders) {
+	StreamPair pair(1024, 1024);
+	std::thread reader([&pair]() {
+	  tinyrpc::RpcResponseHeader message;
+	  EXPECT_FALSE(pair.server->Read(&message));
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	pair.server->Abort(RPC_ERR_CLOSED, "connection closed");
+	reader.join();
+	EXPECT_TRUE(pair.server->Finished());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "utils/Trace.h"
+
+TEST(TraceTest, RingPushPop) {
+	SpanRing ring(4);
+	SpanRecord span;
+	for (uint64_t i = 1; i <= 4; i++) {
+		span.span_id = i;
+		EXPECT_TRUE(ring.push(span));
+	}
+	EXPECT_FALSE(ring.push(span));    // 已满
+
+	for (uint64_t i = 1; i <= 4; i++) {
+		ASSERT_TRUE(ring.pop(span));
+		EXPECT_EQ(span.span_id, i);
+	}
+	EXPECT_FALSE(ring.pop(span));
+}
+
+TEST(TraceTest, RingMultipleProducers) {
+	SpanRing ring(1024);
+	const int num_threads = 4;
+	const int per_thread = 200;
+	std::vector<std::thread> producers;
+	for (int i = 0; i < num_threads; i++) {
+		producers.emplace_back([&, i]() {
+		  SpanRecord span;
+		  for (int j = 0; j < per_thread; j++) {
+			  span.span_id = i * per_thread + j + 1;
+			  EXPECT_TRUE(ring.push(span));
+		  }
+		});
+	}
+	for (auto &t : producers) t.join();
+
+	SpanRecord span;
+	std::vector<bool> seen(num_threads * per_thread + 1, false);
+	int count = 0;
+	while (ring.pop(span)) {
+		EXPECT_FALSE(seen[span.span_id]);
+		seen[span.span_id] = true;
+		count++;
+	}
+	EXPECT_EQ(count, num_threads * per_thread);
+}
+
+TEST(TraceTest, SampleRate) {
+	const std::string path = "trace_test.jsonl";
+	{
+		Tracer never(path, 0.0);
+		Tracer always(path, 1.0);
+		for (int i = 0; i < 100; i++) {
+			EXPECT_FALSE(never.newRoot().sampled());
+			EXPECT_TRUE(always.newRoot().sampled());
+		}
+
+		auto root = always.newRoot();
+		auto child = Tracer::newChild(root);
+		EXPECT_EQ(child.trace_id, root.trace_id);
+		EXPECT_NE(child.span_id, root.span_id);
+		EXPECT_TRUE(child.sampled());
+	}
+	std::remove(path.c_str());
+}
+
+TEST(TraceTest, ExportToFile) {
+	const std::string path = "trace_test_export.jsonl";
+	std::remove(path.c_str());
+	{
+		Tracer tracer(path, 1.0);
+		SpanRecord span;
+		span.trace_id = 0xabcdef;
+		span.span_id = 2;
+		span.kind = SpanKind::SERVER;
+		span.setName("test.UserServiceRpc.Login");
+		tracer.submit(span);
+	}    // 析构时导出剩余 span
+
+	std::ifstream ifs(path);
+	std::stringstream content;
+	content << ifs.rdbuf();
+	EXPECT_NE(content.str().find(R"("trace_id":"0000000000abcdef")"), std::string::npos);
+	EXPECT_NE(content.str().find(R"("name":"test.UserServiceRpc.Login","kind":"server")"), std::string::npos);
+	std::remove(path.c_str());
+}
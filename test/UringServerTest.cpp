@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include "rpc/UringServer.h"
+
+namespace {
+
+std::string makeFrame(const std::string &body) {
+	std::string frame(8, '\0');
+	uint32_t length = htonl(static_cast<uint32_t>(body.size()));
+	memcpy(&frame[0], &length, sizeof(length));
+	return frame + body;
+}
+
+int connectTo(int port) {
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+		close(fd);
+		return -1;
+	}
+	struct timeval timeout = {5, 0};
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	return fd;
+}
+
+std::string readExactly(int fd, size_t size) {
+	std::string data;
+	char buf[4096];
+	while (data.size() < size) {
+		auto n = read(fd, buf, std::min(sizeof(buf), size - data.size()));
+		if (n <= 0) {
+			break;
+		}
+		data.append(buf, n);
+	}
+	return data;
+}
+
+}
+
+class UringServerTest : public testing::Test {
+ protected:
+  void StartEcho(bool async) {
+	  auto handler = [this, async](const RpcSessionPtr &session, const char *data, size_t size) {
+		  std::string frame(data, size);
+		  if (async) {
+			  async_pending++;
+			  std::thread([this, session, frame]() {
+				  session->Write(frame);
+				  async_pending--;
+			  }).detach();
+		  } else {
+			  session->Write(frame);
+		  }
+	  };
+	  auto on_connection = [this](bool connected) { connected ? opened++ : closed++; };
+	  if (!server.Start("127.0.0.1", 0, 2, handler, on_connection)) {
+		  GTEST_SKIP() << "io_uring not available";
+	  }
+  }
+
+  UringServer server;
+  std::atomic<int> opened = 0;
+  std::atomic<int> closed = 0;
+  std::atomic<int> async_pending = 0;
+};
+
+TEST_F(UringServerTest, EchoFramesSplitAcrossWrites) {
+	StartEcho(false);
+	if (IsSkipped()) {
+		return;
+	}
+	int fd = connectTo(server.Port());
+	ASSERT_GE(fd, 0);
+
+	std::string stream;
+	for (int i = 0; i < 50; i++) {
+		stream += makeFrame(std::string(i * 997 % 20000, static_cast<char>('a' + i % 26)));
+	}
+	// 以不同的粒度写入，帧头与帧体都会被拆开
+	size_t offset = 0;
+	for (size_t step = 1; offset < stream.size(); step = step * 3 % 7919 + 1) {
+		auto n = std::min(step, stream.size() - offset);
+		ASSERT_EQ(write(fd, stream.data() + offset, n), static_cast<ssize_t>(n));
+		offset += n;
+	}
+	EXPECT_EQ(readExactly(fd, stream.size()), stream);
+	close(fd);
+
+	auto stats = server.Stats();
+	EXPECT_EQ(stats.requests, 50u);
+	EXPECT_GT(stats.enter_calls, 0u);
+}
+
+TEST_F(UringServerTest, WriteFromOtherThread) {
+	StartEcho(true);
+	if (IsSkipped()) {
+		return;
+	}
+	int fd = connectTo(server.Port());
+	ASSERT_GE(fd, 0);
+	std::string stream;
+	for (int i = 0; i < 20; i++) {
+		stream += makeFrame(std::to_string(i));
+	}
+	ASSERT_EQ(write(fd, stream.data(), stream.size()), static_cast<ssize_t>(stream.size()));
+	// 响应顺序不确定，只比较总长度
+	EXPECT_EQ(readExactly(fd, stream.size()).size(), stream.size());
+	close(fd);
+	while (async_pending.load() > 0) {
+		std::this_thread::yield();
+	}
+}
+
+TEST_F(UringServerTest, OversizedFrameClosesConnection) {
+	StartEcho(false);
+	if (IsSkipped()) {
+		return;
+	}
+	int fd = connectTo(server.Port());
+	ASSERT_GE(fd, 0);
+	std::string head(8, '\0');
+	uint32_t length = htonl(64u * 1024 * 1024);
+	memcpy(&head[0], &length, sizeof(length));
+	ASSERT_EQ(write(fd, head.data(), head.size()), 8);
+	char buf[16];
+	EXPECT_EQ(read(fd, buf, sizeof(buf)), 0);
+	close(fd);
+}
+
+TEST_F(UringServerTest, ConnectionCallbacks) {
+	StartEcho(false);
+	if (IsSkipped()) {
+		return;
+	}
+	int first = connectTo(server.Port());
+	int second = connectTo(server.Port());
+	ASSERT_GE(first, 0);
+	ASSERT_GE(second, 0);
+	auto frame = makeFrame("ping");
+	for (int fd : {first, second}) {
+		ASSERT_EQ(write(fd, frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+		EXPECT_EQ(readExactly(fd, frame.size()), frame);
+	}
+	EXPECT_EQ(opened.load(), 2);
+	EXPECT_EQ(server.Stats().connections, 2u);
+
+	close(first);
+	for (int i = 0; i < 100 && closed.load() < 1; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	EXPECT_EQ(closed.load(), 1);
+
+	// 停止时关闭仍打开的连接
+	server.Stop();
+	EXPECT_EQ(closed.load(), 2);
+	char buf[16];
+	EXPECT_EQ(read(second, buf, sizeof(buf)), 0);
+	close(second);
+}